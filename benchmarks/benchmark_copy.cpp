@@ -0,0 +1,88 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+
+#include "../include/ipp_ext.h"
+
+#include <catch2/catch_test_macros.hpp>
+// Also include benchmarking headers, i don't really know which one is necessary
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+// Helper to print an effective copy bandwidth, counting both the read and the write
+template <typename T, typename F>
+void printCopyThroughput(const char* name, size_t length, F&& func, int iterations = 20)
+{
+    auto t1 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; i++)
+        func();
+    auto t2 = std::chrono::high_resolution_clock::now();
+
+    double secs = std::chrono::duration<double>(t2 - t1).count() / iterations;
+    double bytes = 2.0 * (double)length * sizeof(T);
+    std::cout << name << ", " << length << " elements: " << bytes / secs / 1e9 << " GB/s" << std::endl;
+}
+
+TEST_CASE("Benchmark vector copies, Ipp32fc", "[copy],[32fc]")
+{
+    const size_t lengths[] = {100000, 1000000, 10000000};
+
+    for (size_t length : lengths)
+    {
+        DYNAMIC_SECTION("length " << length)
+        {
+            ipps::vector<Ipp32fc> src(length, {1.0f, 2.0f});
+            ipps::vector<Ipp32fc> dst(length);
+
+            BENCHMARK("ippsCopy_32fc")
+            {
+                ipps::Copy<Ipp32fc>(src.data(), dst.data(), (int)length);
+                return dst.back().re;
+            };
+
+            BENCHMARK("scalar loop")
+            {
+                for (size_t i = 0; i < length; i++)
+                    dst[i] = src[i];
+                return dst.back().re;
+            };
+
+            BENCHMARK("copy constructor")
+            {
+                ipps::vector<Ipp32fc> copied(src);
+                return copied.back().re;
+            };
+
+            BENCHMARK("copy assignment")
+            {
+                dst = src;
+                return dst.back().re;
+            };
+
+            printCopyThroughput<Ipp32fc>("ippsCopy_32fc", length,
+                [&](){ ipps::Copy<Ipp32fc>(src.data(), dst.data(), (int)length); });
+            printCopyThroughput<Ipp32fc>("scalar loop", length,
+                [&](){ for (size_t i = 0; i < length; i++) dst[i] = src[i]; });
+        }
+    }
+}
+
+TEST_CASE("Benchmark vector growth, Ipp32fc", "[copy],[reserve]")
+{
+    const size_t length = 1000000;
+
+    BENCHMARK("push_back 1000000 elements")
+    {
+        ipps::vector<Ipp32fc> v;
+        for (size_t i = 0; i < length; i++)
+            v.push_back({(Ipp32f)i, 0.0f});
+        return v.size();
+    };
+
+    BENCHMARK("reserve with 10% of capacity in use")
+    {
+        ipps::vector<Ipp32fc> v(length);
+        v.resize(length / 10); // growth only needs to move the valid elements
+        v.reserve(length * 2);
+        return v.capacity();
+    };
+}
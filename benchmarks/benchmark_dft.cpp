@@ -2,6 +2,7 @@
 #include <vector>
 #include <thread>
 #include <chrono>
+#include <memory>
 
 #include "ipp_ext.h"
 
@@ -90,15 +91,17 @@ void thread_work(
 TEST_CASE("Benchmark DFT, 4 threads", "[dftCToC],[multithread]") {
     std::vector<std::thread> thd(4);
 
-    // Setup 4 objects, 1 per thread
+    // Setup 4 executors, 1 per thread, sharing the same plan
     ipps::DFTCToC<Ipp32fc> dft[4];
     ipps::vector<Ipp32fc> in[4];
     ipps::vector<Ipp32fc> out[4];
 
 
     SECTION("ipp32fc, length 10000"){
+        // One spec shared by all threads, each executor only holds its own work buffer
+        auto plan = std::make_shared<const ipps::DFTCToCPlan<Ipp32fc>>(10000);
         for (int i = 0; i < 4; i++){
-            dft[i] = ipps::DFTCToC<Ipp32fc>(10000);
+            dft[i] = ipps::DFTCToC<Ipp32fc>(plan);
             in[i] = ipps::vector<Ipp32fc>(10000);
             out[i] = ipps::vector<Ipp32fc>(10000);
         }
@@ -116,8 +119,10 @@ TEST_CASE("Benchmark DFT, 4 threads", "[dftCToC],[multithread]") {
     }
 
     SECTION("ipp32fc, length 100000"){
+        // One spec shared by all threads, each executor only holds its own work buffer
+        auto plan = std::make_shared<const ipps::DFTCToCPlan<Ipp32fc>>(100000);
         for (int i = 0; i < 4; i++){
-            dft[i] = ipps::DFTCToC<Ipp32fc>(100000);
+            dft[i] = ipps::DFTCToC<Ipp32fc>(plan);
             in[i] = ipps::vector<Ipp32fc>(100000);
             out[i] = ipps::vector<Ipp32fc>(100000);
         }
@@ -136,8 +141,10 @@ TEST_CASE("Benchmark DFT, 4 threads", "[dftCToC],[multithread]") {
     }
 
     SECTION("ipp32fc, length 1000000"){
+        // One spec shared by all threads, each executor only holds its own work buffer
+        auto plan = std::make_shared<const ipps::DFTCToCPlan<Ipp32fc>>(1000000);
         for (int i = 0; i < 4; i++){
-            dft[i] = ipps::DFTCToC<Ipp32fc>(1000000);
+            dft[i] = ipps::DFTCToC<Ipp32fc>(plan);
             in[i] = ipps::vector<Ipp32fc>(1000000);
             out[i] = ipps::vector<Ipp32fc>(1000000);
         }
@@ -155,8 +162,10 @@ TEST_CASE("Benchmark DFT, 4 threads", "[dftCToC],[multithread]") {
     }
 
     SECTION("ipp32fc, length 10000000"){
+        // One spec shared by all threads, each executor only holds its own work buffer
+        auto plan = std::make_shared<const ipps::DFTCToCPlan<Ipp32fc>>(10000000);
         for (int i = 0; i < 4; i++){
-            dft[i] = ipps::DFTCToC<Ipp32fc>(10000000);
+            dft[i] = ipps::DFTCToC<Ipp32fc>(plan);
             in[i] = ipps::vector<Ipp32fc>(10000000);
             out[i] = ipps::vector<Ipp32fc>(10000000);
         }
@@ -174,3 +183,411 @@ TEST_CASE("Benchmark DFT, 4 threads", "[dftCToC],[multithread]") {
     }
 }
 
+
+TEST_CASE("Benchmark DFT batched rows", "[dftCToC],[batch]") {
+    SECTION("ipp32fc, 4096 rows of length 1024"){
+        ipps::DFTCToC<Ipp32fc> dft(1024);
+        ipps::matrix<Ipp32fc> in(4096, 1024);
+        ipps::matrix<Ipp32fc> out(4096, 1024);
+
+        BENCHMARK("per-row fwd() loop"){
+            for (size_t r = 0; r < in.rows(); r++)
+                dft.fwd(in.row(r), out.row(r));
+        };
+
+        BENCHMARK("fwdBatch(), default pool"){
+            dft.fwdBatch(in, out);
+        };
+
+        BENCHMARK("fwdBatch(), in-place"){
+            dft.fwdBatch(out, out);
+        };
+    }
+
+    SECTION("ipp32fc, 64 rows of length 100000"){
+        ipps::DFTCToC<Ipp32fc> dft(100000);
+        ipps::matrix<Ipp32fc> in(64, 100000);
+        ipps::matrix<Ipp32fc> out(64, 100000);
+
+        BENCHMARK("per-row fwd() loop"){
+            for (size_t r = 0; r < in.rows(); r++)
+                dft.fwd(in.row(r), out.row(r));
+        };
+
+        BENCHMARK("fwdBatch(), default pool"){
+            dft.fwdBatch(in, out);
+        };
+    }
+}
+
+TEST_CASE("Benchmark real DFT vs promoted complex DFT", "[dftRToC],[singlethread]") {
+    SECTION("ipp32f, length 100000"){
+        ipps::DFTRToCCS<Ipp32f> rdft(100000);
+        ipps::DFTCToC<Ipp32fc> cdft(100000);
+        ipps::vector<Ipp32f> x(100000);
+        ipps::vector<Ipp32f> spectrum(rdft.getSpectrumLength());
+        ipps::vector<Ipp32fc> xc(100000);
+        ipps::vector<Ipp32fc> out(100000);
+
+        BENCHMARK("DFTRToCCS fwd()"){
+            rdft.fwd(x.data(), spectrum.data());
+        };
+
+        BENCHMARK("DFTRToCCS fwdComplex()"){
+            rdft.fwdComplex(x.data(), out.data());
+        };
+
+        BENCHMARK("RealToCplx + DFTCToC fwd()"){
+            ipps::convert::RealToCplx(x.data(), (const Ipp32f*)nullptr, xc.data(), (int)x.size());
+            cdft.fwd(xc.data(), out.data());
+        };
+    }
+}
+
+TEST_CASE("Benchmark DFT vs FFT backend, powers of 2", "[dftCToC],[fft]") {
+    for (int order = 10; order <= 24; order += 2)
+    {
+        const size_t length = (size_t)1 << order;
+        ipps::DFTCToC<Ipp32fc> fft(length); // picks the FFT automatically
+        ipps::DFTCToC<Ipp32fc> dft(length, IPP_FFT_DIV_INV_BY_N, ipps::DFTBackend::DFT);
+        ipps::vector<Ipp32fc> in(length);
+        ipps::vector<Ipp32fc> out(length);
+
+        printf("2^%d: FFT spec %zu bytes, DFT spec %zu bytes\n",
+            order, fft.getDFTSpec().size(), dft.getDFTSpec().size());
+
+        BENCHMARK("ipp32fc, 2^" + std::to_string(order) + ", DFT backend"){
+            dft.fwd(in.data(), out.data());
+        };
+
+        BENCHMARK("ipp32fc, 2^" + std::to_string(order) + ", FFT backend"){
+            fft.fwd(in.data(), out.data());
+        };
+    }
+}
+
+TEST_CASE("Benchmark STFT vs manual frame loop", "[stft],[multithread]") {
+    const size_t frameLength = 1024;
+    const size_t hop = 256;
+    const size_t length = 1 << 20;
+    const size_t numFrames = (length - frameLength) / hop + 1;
+
+    ipps::vector<Ipp32fc> x(length);
+    ipps::matrix<Ipp32f> spectrogram(numFrames, frameLength);
+
+    ipps::STFT<Ipp32fc> stft(frameLength, hop, ippWinHann, ipps::STFTScale::Power);
+    ipps::parallel::ThreadPool single(1);
+
+    // What the STFT replaces: copy, window, transform and convert each frame separately
+    ipps::DFTCToC<Ipp32fc> dft(frameLength);
+    ipps::vector<Ipp32fc> window(frameLength), frame(frameLength), spectrum(frameLength);
+    for (size_t i = 0; i < frameLength; i++)
+    {
+        window[i].re = 1;
+        window[i].im = 0;
+    }
+    ipps::transform::Win_I(ippWinHann, window.data(), (int)frameLength);
+
+    BENCHMARK("manual copy, Mul, fwd, PowerSpectr"){
+        for (size_t f = 0; f < numFrames; f++)
+        {
+            ipps::Copy(x.data() + f * hop, frame.data(), (int)frameLength);
+            ipps::math::Mul_I(window.data(), frame.data(), (int)frameLength);
+            dft.fwd(frame.data(), spectrum.data());
+            ipps::convert::PowerSpectr(spectrum.data(), spectrogram.row(f), (int)frameLength);
+        }
+    };
+
+    BENCHMARK("STFT, 1 thread"){
+        stft.reset();
+        return stft.process(x.data(), x.size(), spectrogram, single);
+    };
+
+    BENCHMARK("STFT, default pool"){
+        stft.reset();
+        return stft.process(x.data(), x.size(), spectrogram);
+    };
+}
+
+TEST_CASE("Benchmark Welch PSD vs manual loop", "[welch],[multithread]") {
+    const size_t segmentLength = 4096;
+    const size_t overlap = 2048;
+    const size_t length = 1 << 22;
+    const size_t numSegments = (length - segmentLength) / (segmentLength - overlap) + 1;
+
+    ipps::vector<Ipp32fc> x(length);
+    ipps::vector<Ipp32f> psd(segmentLength);
+
+    // What the estimator replaces: a temporary per step, summed with Add_I
+    ipps::DFTCToC<Ipp32fc> dft(segmentLength);
+    ipps::vector<Ipp32fc> window(segmentLength), segment(segmentLength), spectrum(segmentLength);
+    ipps::vector<Ipp32f> power(segmentLength);
+    for (size_t i = 0; i < segmentLength; i++)
+    {
+        window[i].re = 1;
+        window[i].im = 0;
+    }
+    ipps::transform::Win_I(ippWinHann, window.data(), (int)segmentLength);
+
+    BENCHMARK("manual Mul, fwd, PowerSpectr, Add_I"){
+        psd.zero();
+        for (size_t s = 0; s < numSegments; s++)
+        {
+            ipps::math::Mul(window.data(), x.data() + s * (segmentLength - overlap), segment.data(), (int)segmentLength);
+            dft.fwd(segment.data(), spectrum.data());
+            ipps::convert::PowerSpectr(spectrum.data(), power.data(), (int)segmentLength);
+            ipps::math::Add_I(power.data(), psd.data(), (int)segmentLength);
+        }
+        return psd[0];
+    };
+
+    ipps::Welch<Ipp32fc> welch(segmentLength, overlap);
+    ipps::parallel::ThreadPool single(1);
+
+    BENCHMARK("Welch mean, 1 thread"){
+        welch.reset();
+        welch.push(x.data(), x.size(), single);
+        welch.getPSD(psd.data());
+        return psd[0];
+    };
+
+    BENCHMARK("Welch mean, default pool"){
+        welch.reset();
+        welch.push(x.data(), x.size());
+        welch.getPSD(psd.data());
+        return psd[0];
+    };
+}
+
+TEST_CASE("Benchmark four-step DFT thread scaling", "[dftCToC],[fourstep],[multithread]") {
+    // 10^8 = 10^4 x 10^4, and 2^27 = 2^13 x 2^14
+    const size_t lengths[] = {100000000, (size_t)1 << 27};
+    const size_t threadCounts[] = {1, 2, 4, 8, 16};
+
+    for (size_t length : lengths)
+    {
+        ipps::vector<Ipp32fc> in(length);
+        ipps::vector<Ipp32fc> out(length);
+        const std::string suffix = ", length " + std::to_string(length);
+
+        ipps::DFTCToC<Ipp32fc> single(length);
+        BENCHMARK("DFTCToC fwd()" + suffix){
+            single.fwd(in.data(), out.data());
+        };
+
+        ipps::DFTFourStep<Ipp32fc> dft(length);
+        printf("Four-step split %zu x %zu\n", dft.getRows(), dft.getColumns());
+        for (size_t threads : threadCounts)
+        {
+            ipps::parallel::ThreadPool pool(threads);
+            BENCHMARK("DFTFourStep fwd(), " + std::to_string(threads) + " threads" + suffix){
+                dft.fwd(in.data(), out.data(), pool);
+            };
+        }
+    }
+}
+
+TEST_CASE("Benchmark CrossCorrelator vs manual chain", "[xcorr],[multithread]") {
+    const size_t refLength = 1024;
+    const size_t segLength = 8192;
+    const size_t count = 256;
+
+    ipps::vector<Ipp32fc> reference(refLength);
+    ipps::vector<Ipp32fc> segments(count * segLength);
+    ipps::CrossCorrelator<Ipp32fc> xc(reference, segLength);
+    const size_t fftLength = xc.getFFTLength();
+    std::vector<ipps::CorrelationPeak<Ipp32fc>> peaks(count);
+
+    // What the correlator replaces: forward DFTs of both, Conj, Mul, backward DFT, then the peak search
+    ipps::DFTCToC<Ipp32fc> dft(fftLength);
+    ipps::vector<Ipp32fc> padded(fftLength), refSpectrum(fftLength), spectrum(fftLength), result(fftLength);
+    ipps::vector<Ipp32f> power(fftLength);
+
+    BENCHMARK("manual fwd, Conj, Mul, bwd, MaxIndx"){
+        int index = 0;
+        Ipp32f peak = 0;
+        for (size_t s = 0; s < count; s++)
+        {
+            padded.zero();
+            ipps::Copy(reference.data(), padded.data(), (int)refLength);
+            dft.fwd(padded.data(), refSpectrum.data());
+            ipps::convert::Conj_I(refSpectrum.data(), (int)fftLength);
+            padded.zero();
+            ipps::Copy(segments.data() + s * segLength, padded.data(), (int)segLength);
+            dft.fwd(padded.data(), spectrum.data());
+            ipps::math::Mul_I(refSpectrum.data(), spectrum.data(), (int)fftLength);
+            dft.bwd(spectrum.data(), result.data());
+            ipps::convert::PowerSpectr(result.data(), power.data(), (int)fftLength);
+            ipps::stats::MaxIndx(power.data(), (int)fftLength, &peak, &index);
+        }
+        return index;
+    };
+
+    ipps::parallel::ThreadPool single(1);
+    BENCHMARK("CrossCorrelator correlateBatch, 1 thread"){
+        xc.correlateBatch(segments.data(), segLength, count, peaks.data(), nullptr, 0, single);
+        return peaks[0].index;
+    };
+
+    BENCHMARK("CrossCorrelator correlateBatch, default pool"){
+        xc.correlateBatch(segments.data(), segLength, count, peaks.data());
+        return peaks[0].index;
+    };
+}
+
+TEST_CASE("Benchmark CAF vs manual Doppler loop", "[caf],[multithread]") {
+    const size_t refLength = 1024;
+    const size_t segLength = 3072;
+    const int maxBin = 32;
+
+    ipps::vector<Ipp32fc> reference(refLength);
+    ipps::vector<Ipp32fc> segment(segLength);
+    std::vector<double> dopplers;
+    for (int k = -maxBin; k <= maxBin; k++)
+        dopplers.push_back(k / 4096.0);
+    ipps::CAF<Ipp32fc> caf(reference, segLength, dopplers, 4096);
+    const size_t fftLength = caf.getFFTLength();
+    ippi::image<Ipp32f, ippi::channels::C1> surface(caf.getNumLags(), dopplers.size());
+
+    // What the CAF replaces: a Tone, Mul and forward DFT per Doppler, then Mul, bwd and magnitude
+    ipps::DFTCToC<Ipp32fc> dft(fftLength);
+    ipps::vector<Ipp32fc> tone(segLength), padded(fftLength), spectrum(fftLength), result(fftLength);
+    ipps::vector<Ipp32fc> refSpectrum(fftLength);
+    ipps::vector<Ipp32f> row(fftLength);
+    padded.zero();
+    ipps::Copy(reference.data(), padded.data(), (int)refLength);
+    dft.fwd(padded.data(), refSpectrum.data());
+    ipps::convert::Conj_I(refSpectrum.data(), (int)fftLength);
+
+    BENCHMARK("manual Tone, Mul, fwd, Mul, bwd, Magnitude"){
+        for (size_t d = 0; d < dopplers.size(); d++)
+        {
+            Ipp32f phase = 0;
+            Ipp32f freq = (Ipp32f)(-dopplers[d] - std::floor(-dopplers[d]));
+            ipps::generator::Tone(tone.data(), (int)segLength, (Ipp32f)1.0f, freq, &phase, ippAlgHintFast);
+            padded.zero();
+            ipps::math::Mul(tone.data(), segment.data(), padded.data(), (int)segLength);
+            dft.fwd(padded.data(), spectrum.data());
+            ipps::math::Mul_I(refSpectrum.data(), spectrum.data(), (int)fftLength);
+            dft.bwd(spectrum.data(), result.data());
+            ipps::convert::Magnitude(result.data(), row.data(), (int)fftLength);
+        }
+        return row[0];
+    };
+
+    ipps::parallel::ThreadPool single(1);
+    BENCHMARK("CAF compute, 1 thread"){
+        caf.compute(segment.data(), surface, single);
+        return surface.data()[0];
+    };
+
+    BENCHMARK("CAF compute, default pool"){
+        caf.compute(segment.data(), surface);
+        return surface.data()[0];
+    };
+}
+
+TEST_CASE("Benchmark Chirp-Z zoom vs zero-padded DFT", "[chirpz],[singlethread]") {
+    // 1000 bins over 1% of the band from 2^16 samples, at 1/64 of a bin spacing
+    const size_t length = 1 << 16;
+    const size_t bins = 1000;
+    const size_t zoom = 64;
+
+    ipps::vector<Ipp32fc> x(length);
+    ipps::ChirpZ<Ipp32fc> czt(length, bins, 0.1, 1.0 / (length * zoom));
+    ipps::vector<Ipp32fc> spectrum(bins);
+
+    // The same resolution by padding to 64 times the length
+    ipps::DFTCToC<Ipp32fc> dft(length * zoom);
+    ipps::vector<Ipp32fc> padded(length * zoom), full(length * zoom);
+    padded.zero();
+
+    BENCHMARK("zero-padded DFTCToC fwd()"){
+        ipps::Copy(x.data(), padded.data(), (int)length);
+        dft.fwd(padded.data(), full.data());
+        return full[0];
+    };
+
+    BENCHMARK("ChirpZ transform()"){
+        czt.transform(x.data(), spectrum.data());
+        return spectrum[0];
+    };
+}
+
+TEST_CASE("Benchmark Goertzel bank vs per-tone Goertz", "[goertzel],[multithread]") {
+    const size_t length = 8192;
+    const size_t channels = 64;
+    const size_t tones = 64;
+
+    ipps::vector<Ipp32fc> x(channels * length);
+    std::vector<double> frequencies;
+    for (size_t k = 0; k < tones; k++)
+        frequencies.push_back((double)(3 * k + 1) / length);
+    ipps::vector<Ipp32fc> bins(channels * tones);
+
+    BENCHMARK("transform::Goertz per tone and channel"){
+        for (size_t c = 0; c < channels; c++)
+            for (size_t k = 0; k < tones; k++)
+                ipps::transform::Goertz(x.data() + c * length, (int)length, &bins[c * tones + k], (Ipp32f)frequencies[k]);
+        return bins[0];
+    };
+
+    ipps::parallel::ThreadPool single(1);
+    ipps::GoertzelBank<Ipp32fc> goertzel(frequencies, length, ipps::GoertzelMethod::Goertzel);
+    ipps::GoertzelBank<Ipp32fc> dft(frequencies, length, ipps::GoertzelMethod::DFT);
+
+    BENCHMARK("GoertzelBank Goertzel, 1 thread"){
+        goertzel.computeBatch(x.data(), length, channels, bins.data(), tones, single);
+        return bins[0];
+    };
+
+    BENCHMARK("GoertzelBank DFT, 1 thread"){
+        dft.computeBatch(x.data(), length, channels, bins.data(), tones, single);
+        return bins[0];
+    };
+
+    BENCHMARK("GoertzelBank Auto, default pool"){
+        ipps::GoertzelBank<Ipp32fc> automatic(frequencies, length);
+        automatic.computeBatch(x.data(), length, channels, bins.data(), tones);
+        return bins[0];
+    };
+}
+
+TEST_CASE("Benchmark sliding DFT vs Goertzel recompute", "[slidingdft],[singlethread]") {
+    const size_t length = 4096;
+    const size_t hop = 16;
+    const size_t total = 1 << 18;
+    std::vector<int> bins;
+    for (int k = 0; k < 32; k++)
+        bins.push_back(7 * k + 3);
+
+    ipps::vector<Ipp32fc> x(total + length);
+    const size_t outputs = total / hop;
+    ipps::vector<Ipp32fc> out(outputs * bins.size());
+
+    // Recomputing every bin over the whole window at each hop
+    BENCHMARK("transform::Goertz per bin per hop"){
+        for (size_t r = 0; r < outputs; r++)
+            for (size_t k = 0; k < bins.size(); k++)
+                ipps::transform::Goertz(x.data() + r * hop, (int)length, &out[r * bins.size() + k],
+                                        (Ipp32f)bins[k] / (Ipp32f)length);
+        return out[0];
+    };
+
+    std::vector<double> frequencies;
+    for (int k : bins)
+        frequencies.push_back((double)k / length);
+    ipps::GoertzelBank<Ipp32fc> bank(frequencies, length, ipps::GoertzelMethod::Goertzel);
+    BENCHMARK("GoertzelBank per hop"){
+        for (size_t r = 0; r < outputs; r++)
+            bank.compute(x.data() + r * hop, out.data() + r * bins.size());
+        return out[0];
+    };
+
+    ipps::SlidingDFT<Ipp32fc> sdft(length, bins, hop);
+    sdft.process(x.data(), length);
+    BENCHMARK("SlidingDFT process()"){
+        sdft.process(x.data() + length, total, out.data(), bins.size());
+        return out[0];
+    };
+}
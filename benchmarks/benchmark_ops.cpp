@@ -210,3 +210,99 @@ TEST_CASE("Benchmark statistics/reductions", "[statistics]")
         };
     }
 }
+
+// Prints the time per call of func, along with the effective bandwidth for the given number of bytes moved
+template <typename F>
+void printScaling(const char* name, size_t length, size_t threads, double bytesPerCall, F&& func, int iterations = 10)
+{
+    func(); // warm up (page faults, waking the pool)
+    auto t1 = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; i++)
+        func();
+    auto t2 = std::chrono::high_resolution_clock::now();
+
+    double secs = std::chrono::duration<double>(t2 - t1).count() / iterations;
+    std::cout << name << ", " << length << " elements, " << threads << " threads: "
+              << secs * 1e3 << " ms, " << bytesPerCall / secs / 1e9 << " GB/s" << std::endl;
+}
+
+TEST_CASE("Benchmark parallel elementwise math scaling", "[parallel],[scaling]")
+{
+    const size_t lengths[] = {100000, 1000000, 10000000, 100000000};
+    const size_t maxThreads = std::max<unsigned int>(1, std::thread::hardware_concurrency());
+
+    for (size_t length : lengths)
+    {
+        DYNAMIC_SECTION("length " << length)
+        {
+            ipps::vector<Ipp32f> in1(length, 1.0f);
+            ipps::vector<Ipp32f> in2(length, 2.0f);
+            ipps::vector<Ipp32f> out(length);
+
+            printScaling("ippsAdd_32f (serial)", length, 1, 3.0 * length * sizeof(Ipp32f),
+                [&](){ ipps::math::Add(in1.data(), in2.data(), out.data(), length); });
+
+            for (size_t threads = 2; threads <= maxThreads; threads *= 2)
+            {
+                ipps::parallel::ThreadPool pool(threads);
+
+                printScaling("parallel::Add 32f", length, threads, 3.0 * length * sizeof(Ipp32f),
+                    [&](){ ipps::parallel::Add(in1.data(), in2.data(), out.data(), length, pool); });
+                printScaling("parallel::Exp 32f", length, threads, 2.0 * length * sizeof(Ipp32f),
+                    [&](){ ipps::parallel::Exp(in1.data(), out.data(), length, pool); });
+            }
+
+            // The Catch benchmarks for the extremes, for comparison with the other results in this file
+            ipps::parallel::ThreadPool pool(maxThreads);
+            BENCHMARK("ippsAdd_32f, 1 thread")
+            {
+                return ipps::math::Add(in1.data(), in2.data(), out.data(), length);
+            };
+            BENCHMARK("ippsAdd_32f, all threads")
+            {
+                return ipps::parallel::Add(in1.data(), in2.data(), out.data(), length, pool);
+            };
+        }
+    }
+}
+
+TEST_CASE("Benchmark fused expression vs naive chain, z = a*b + c*d", "[expr],[fusion]")
+{
+    const size_t lengths[] = {100000, 1000000, 10000000};
+
+    for (size_t length : lengths)
+    {
+        DYNAMIC_SECTION("length " << length)
+        {
+            ipps::vector<Ipp32f> a(length, 1.0f), b(length, 2.0f), c(length, 3.0f), d(length, 4.0f);
+            ipps::vector<Ipp32f> z(length);
+            ipps::vector<Ipp32f> t1(length), t2(length);
+
+            // Naive: two full-length temporaries, 3 passes touching 9 arrays' worth of memory
+            auto naive = [&](){
+                ipps::math::Mul(a.data(), b.data(), t1.data(), length);
+                ipps::math::Mul(c.data(), d.data(), t2.data(), length);
+                ipps::math::Add(t1.data(), t2.data(), z.data(), length);
+            };
+            // Fused: a single tiled pass reading 4 arrays and writing 1
+            auto fused = [&](){
+                z = a * b + c * d;
+            };
+
+            printScaling("naive Mul, Mul, Add", length, 1, 9.0 * length * sizeof(Ipp32f), naive);
+            printScaling("fused expression", length, 1, 5.0 * length * sizeof(Ipp32f), fused);
+
+            BENCHMARK("naive Mul, Mul, Add")
+            {
+                naive();
+                return z[0];
+            };
+
+            BENCHMARK("fused expression")
+            {
+                fused();
+                return z[0];
+            };
+        }
+    }
+}
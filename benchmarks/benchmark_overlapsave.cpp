@@ -0,0 +1,80 @@
+#include <iostream>
+#include <string>
+
+#include "../include/ipp_ext.h"
+
+#include <catch2/catch_test_macros.hpp>
+// Also include benchmarking headers, i don't really know which one is necessary
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+TEST_CASE("Benchmark OverlapSave vs FIRSR crossover", "[overlapsave],[FIRSR]")
+{
+    // Input length per call, and filter lengths spanning short to very long filters
+    const size_t length = 1 << 18;
+    const size_t tapLengths[] = {16, 64, 256, 1024, 4096, 16384, 65536};
+
+    ipps::vector<Ipp32fc> data(length);
+    ipps::vector<Ipp32fc> result(length);
+
+    for (size_t numTaps : tapLengths)
+    {
+        ipps::vector<Ipp32fc> taps = ipps::filter::generateLowpassTaps<Ipp32fc>(0.1, (int)numTaps, ippWinHamming, ippTrue);
+
+        ipps::filter::OverlapSave<Ipp32fc> overlapSave(taps);
+        ipps::filter::FIRSR<Ipp32fc, Ipp32fc> firDirect(taps, ippAlgDirect);
+        ipps::filter::FIRSR<Ipp32fc, Ipp32fc> firFFT(taps, ippAlgFFT);
+
+        const std::string suffix = ", " + std::to_string(numTaps) + " taps";
+
+        // The direct form is far too slow to be worth timing for the longest filters
+        if (numTaps <= 4096)
+        {
+            BENCHMARK("FIRSR ippAlgDirect" + suffix)
+            {
+                firDirect.filter(data.data(), result.data(), (int)length);
+                return 0;
+            };
+        }
+
+        BENCHMARK("FIRSR ippAlgFFT" + suffix)
+        {
+            firFFT.filter(data.data(), result.data(), (int)length);
+            return 0;
+        };
+
+        BENCHMARK("OverlapSave, FFT length " + std::to_string(overlapSave.getFFTLength()) + suffix)
+        {
+            overlapSave.filter(data.data(), result.data(), length);
+            return 0;
+        };
+    }
+}
+
+TEST_CASE("Benchmark PartitionedConvolution vs OverlapSave, long filter", "[partitioned],[overlapsave]")
+{
+    // A very long filter, fed in small real-time sized chunks
+    const size_t numTaps = 100000;
+    const size_t chunk = 256;
+    const size_t length = 1 << 16;
+
+    ipps::vector<Ipp32fc> taps = ipps::filter::generateLowpassTaps<Ipp32fc>(0.1, (int)numTaps, ippWinHamming, ippTrue);
+    ipps::vector<Ipp32fc> data(length);
+    ipps::vector<Ipp32fc> result(length);
+
+    ipps::filter::OverlapSave<Ipp32fc> overlapSave(taps);
+    ipps::filter::PartitionedConvolution<Ipp32fc> partitioned(taps, chunk);
+
+    BENCHMARK("OverlapSave, FFT length " + std::to_string(overlapSave.getFFTLength()) + ", " + std::to_string(chunk) + " sample chunks")
+    {
+        for (size_t i = 0; i < length; i += chunk)
+            overlapSave.filter(data.data() + i, result.data() + i, chunk);
+        return 0;
+    };
+
+    BENCHMARK("PartitionedConvolution, " + std::to_string(partitioned.getNumPartitions()) + " partitions of " + std::to_string(chunk))
+    {
+        for (size_t i = 0; i < length; i += chunk)
+            partitioned.filter(data.data() + i, result.data() + i, chunk);
+        return 0;
+    };
+}
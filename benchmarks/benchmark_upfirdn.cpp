@@ -1,5 +1,7 @@
 #include <iostream>
+#include <string>
 #include <vector>
+#include <algorithm>
 #include <thread>
 #include <chrono>
 
@@ -54,3 +56,195 @@ TEST_CASE("Benchmark upfirdn implementations", "[upfirdn],[naive],[FIRMR]")
         };
     }
 }
+
+TEST_CASE("Benchmark streaming Resampler", "[upfirdn],[resampler]")
+{
+    SECTION("Ipp32fc data length 30000, factors 5/3, packets of varying size")
+    {
+        ipps::vector<Ipp32fc> data(30000);
+        int up = 5, down = 3;
+        ipps::filter::Resampler<Ipp32fc> resampler(up, down);
+        ipps::filter::FIRMR<Ipp32fc, Ipp32fc> filter(
+            ipps::vector<Ipp32fc>(resampler.getTaps()), up, 0, down, 0
+        );
+        ipps::vector<Ipp32fc> result(data.size() * up / down);
+
+        // Packet sizes that are mostly not multiples of the down factor
+        std::vector<size_t> packets;
+        for (size_t total = 0, i = 0; total < data.size(); i++)
+        {
+            size_t size = std::min((size_t)(97 + (i * 389) % 1400), data.size() - total);
+            packets.push_back(size);
+            total += size;
+        }
+
+        BENCHMARK("FIRMR, whole input")
+        {
+            filter.filter(
+                data.data(), result.data(),
+                (int)data.size(), (int)result.size()
+            );
+            return 0;
+        };
+
+        BENCHMARK("Resampler, packets")
+        {
+            resampler.reset();
+            size_t offset = 0, produced = 0;
+            for (size_t size : packets)
+            {
+                produced += resampler.process(data.data() + offset, size, result.data() + produced);
+                offset += size;
+            }
+            return produced;
+        };
+    }
+}
+
+TEST_CASE("Benchmark Farrow resampler", "[upfirdn],[farrow]")
+{
+    SECTION("Ipp32fc data length 30000, ratio near 5/3")
+    {
+        ipps::vector<Ipp32fc> data(30000);
+        int up = 5, down = 3;
+        ipps::filter::FIRMR<Ipp32fc, Ipp32fc> filter(
+            ipps::filter::Resampler<Ipp32fc>::defaultTaps(up, down), up, 0, down, 0
+        );
+        ipps::vector<Ipp32fc> result(data.size() * 2);
+
+        BENCHMARK("FIRMR 5/3")
+        {
+            filter.filter(
+                data.data(), result.data(),
+                (int)data.size(), (int)result.size()
+            );
+            return 0;
+        };
+
+        // Slightly off the rational ratio, as when correcting for clock drift
+        const double ratio = 5.0 / 3.0 * (1 + 20e-6);
+        ipps::filter::FarrowResampler<Ipp32fc> cubic(ratio, 3);
+        BENCHMARK("Farrow, cubic")
+        {
+            cubic.reset();
+            return cubic.process(data.data(), data.size(), result.data());
+        };
+
+        ipps::filter::FarrowResampler<Ipp32fc> quintic(ratio, 5);
+        BENCHMARK("Farrow, order 5")
+        {
+            quintic.reset();
+            return quintic.process(data.data(), data.size(), result.data());
+        };
+
+        ipps::filter::FarrowResampler<Ipp32fc> seventh(ratio, 7);
+        BENCHMARK("Farrow, order 7")
+        {
+            seventh.reset();
+            return seventh.process(data.data(), data.size(), result.data());
+        };
+    }
+
+    SECTION("Ipp32f data length 30000, ratio near 3/5")
+    {
+        ipps::vector<Ipp32f> data(30000);
+        int up = 3, down = 5;
+        ipps::filter::FIRMR<Ipp32f, Ipp32f> filter(
+            ipps::filter::Resampler<Ipp32f>::defaultTaps(up, down), up, 0, down, 0
+        );
+        ipps::vector<Ipp32f> result(data.size());
+
+        BENCHMARK("FIRMR 3/5")
+        {
+            filter.filter(
+                data.data(), result.data(),
+                (int)data.size(), (int)result.size()
+            );
+            return 0;
+        };
+
+        ipps::filter::FarrowResampler<Ipp32f> cubic(3.0 / 5.0 * (1 - 20e-6), 3);
+        BENCHMARK("Farrow, cubic")
+        {
+            cubic.reset();
+            return cubic.process(data.data(), data.size(), result.data());
+        };
+    }
+}
+
+TEST_CASE("Benchmark PolyphaseChannelizer vs per-channel shift and FIRMR", "[channelizer],[FIRMR]")
+{
+    // Many channels out of one wideband capture, critically sampled
+    const size_t numChannels = 128;
+    const size_t tapsPerChannel = 16;
+    const size_t length = 1 << 16;
+
+    ipps::vector<Ipp32fc> data(length);
+    ipps::vector<Ipp32fc> shifted(length);
+    ipps::matrix<Ipp32fc> channels(numChannels, length / numChannels);
+
+    // What the channelizer replaces: a tone mix and a decimating FIR for every channel
+    ipps::vector<Ipp32fc> taps = ipps::filter::PolyphaseChannelizer<Ipp32fc>::prototype(numChannels, tapsPerChannel);
+    std::vector<ipps::filter::FIRMR<Ipp32fc, Ipp32fc>> firs;
+    firs.reserve(numChannels); // the filters hold IPP specs, so keep them where they were built
+    for (size_t m = 0; m < numChannels; m++)
+        firs.emplace_back(taps, 1, 0, (int)numChannels, 0);
+
+    BENCHMARK("Tone, Mul and FIRMR per channel, " + std::to_string(numChannels) + " channels")
+    {
+        for (size_t m = 0; m < numChannels; m++)
+        {
+            Ipp32f phase = 0;
+            Ipp32f freq = (Ipp32f)((numChannels - m) % numChannels) / (Ipp32f)numChannels;
+            ipps::generator::Tone(shifted.data(), (int)length, (Ipp32f)1.0f, freq, &phase, ippAlgHintFast);
+            ipps::math::Mul_I(data.data(), shifted.data(), (int)length);
+            firs[m].filter(shifted.data(), channels.row(m), (int)length, (int)channels.columns());
+        }
+        return 0;
+    };
+
+    ipps::filter::PolyphaseChannelizer<Ipp32fc> channelizer(numChannels, tapsPerChannel);
+    BENCHMARK("PolyphaseChannelizer, " + std::to_string(numChannels) + " channels")
+    {
+        return channelizer.process(data.data(), length, channels.data(), channels.columns());
+    };
+}
+
+TEST_CASE("Benchmark PolyphaseSynthesizer vs per-channel FIRMR and shift", "[synthesizer],[FIRMR]")
+{
+    // The reverse of the channelizer benchmark: many channels back into one stream
+    const size_t numChannels = 128;
+    const size_t tapsPerChannel = 16;
+    const size_t length = 1 << 16;
+
+    ipps::matrix<Ipp32fc> channels(numChannels, length / numChannels);
+    ipps::vector<Ipp32fc> wideband(length);
+    ipps::vector<Ipp32fc> upsampled(length);
+    ipps::vector<Ipp32fc> tone(length);
+
+    // What the synthesizer replaces: an interpolating FIR, a tone mix and an add for every channel
+    ipps::vector<Ipp32fc> taps = ipps::filter::PolyphaseSynthesizer<Ipp32fc>::defaultTaps(numChannels, tapsPerChannel);
+    std::vector<ipps::filter::FIRMR<Ipp32fc, Ipp32fc>> firs;
+    firs.reserve(numChannels); // the filters hold IPP specs, so keep them where they were built
+    for (size_t m = 0; m < numChannels; m++)
+        firs.emplace_back(taps, (int)numChannels, 0, 1, 0);
+
+    BENCHMARK("FIRMR, Tone and AddProduct per channel, " + std::to_string(numChannels) + " channels")
+    {
+        wideband.zero();
+        for (size_t m = 0; m < numChannels; m++)
+        {
+            firs[m].filter(channels.row(m), upsampled.data(), (int)channels.columns(), (int)length);
+            Ipp32f phase = 0;
+            ipps::generator::Tone(tone.data(), (int)length, (Ipp32f)1.0f, (Ipp32f)m / (Ipp32f)numChannels, &phase, ippAlgHintFast);
+            ipps::math::AddProduct(tone.data(), upsampled.data(), wideband.data(), (int)length);
+        }
+        return 0;
+    };
+
+    ipps::filter::PolyphaseSynthesizer<Ipp32fc> synthesizer(numChannels, tapsPerChannel);
+    BENCHMARK("PolyphaseSynthesizer, " + std::to_string(numChannels) + " channels")
+    {
+        return synthesizer.process(channels, wideband.data());
+    };
+}
@@ -2,7 +2,9 @@
 
 #include "ipp.h"
 #include "../ipp_ext_errors.h"
+#include "../ipp_ext_pool.h"
 #include "channels.h"
+#include "../signal/ipp_ext_view.h"
 
 #ifndef NDEBUG
 #define DEBUG(x) printf(x);
@@ -21,10 +23,28 @@ protected:
   size_t m_heightPix = 0;
   IppSizeL m_stepBytes = 0; // This is returned during ippiMalloc functions
   T* m_data = nullptr;
+  bool m_pooled = ippe::pool::enabled(); // whether m_data comes from (and goes back to) ippe::pool
 
   // Internal allocator (see specializations below)
   T* internal_malloc(const IppSizeL width, const IppSizeL height);
 
+  // Pooled equivalent of internal_malloc; rows are padded to 64 bytes like ippiMalloc
+  T* pooled_malloc(const IppSizeL width, const IppSizeL height)
+  {
+    IppSizeL rowBytes = width * static_cast<IppSizeL>(sizeof(T) * numChannels());
+    m_stepBytes = (rowBytes + 63) / 64 * 64;
+    return static_cast<T*>(ippe::pool::allocateBytes(static_cast<size_t>(m_stepBytes * height)));
+  }
+
+  // Frees m_data according to how it was allocated
+  void internal_free()
+  {
+    if (m_pooled)
+      ippe::pool::releaseBytes(m_data, static_cast<size_t>(m_stepBytes) * m_heightPix);
+    else
+      ippiFree(m_data);
+  }
+
 public:
   // Default constructor
   image()
@@ -50,6 +70,7 @@ public:
 
   // Copy constructor
   image(const image& other)
+    : m_pooled(other.m_pooled)
   {
     DEBUG("image(const image&)\n");
     reserve(other.m_widthPix, other.m_heightPix); // this will set internal member sizes
@@ -79,7 +100,8 @@ public:
     : m_widthPix(other.m_widthPix),
     m_heightPix(other.m_heightPix),
     m_stepBytes(other.m_stepBytes),
-    m_data(other.m_data)
+    m_data(other.m_data),
+    m_pooled(other.m_pooled)
   {
     DEBUG("image(image&&)\n");
     other.m_data = nullptr;
@@ -95,13 +117,14 @@ public:
     if (this!= &other)
     {
       // Free old data
-      ippiFree(m_data);
+      internal_free();
 
       // Copy data from other
       m_widthPix = other.m_widthPix;
       m_heightPix = other.m_heightPix;
       m_stepBytes = other.m_stepBytes;
       m_data = other.m_data;
+      m_pooled = other.m_pooled;
 
       // Reset other
       other.m_data = nullptr;
@@ -118,7 +141,33 @@ public:
   ~image()
   {
     DEBUG("~image()\n");
-    ippiFree(m_data);
+    internal_free();
+  }
+
+  // Choose whether future allocations of this instance go through ippe::pool
+  // (the default is ippe::pool::enabled()). Existing data is not preserved.
+  void setPooled(bool pooled)
+  {
+    if (pooled == m_pooled)
+      return;
+
+    size_t width = m_widthPix, height = m_heightPix;
+    internal_free();
+    m_data = nullptr;
+    m_widthPix = 0;
+    m_heightPix = 0;
+    m_stepBytes = 0;
+    m_pooled = pooled;
+    if (width > 0 && height > 0)
+      reserve(width, height);
+  }
+
+  bool isPooled() const { return m_pooled; }
+
+  // Number of interleaved channels per pixel
+  static constexpr size_t numChannels()
+  {
+    return U == channels::C1 ? 1 : U == channels::C2 ? 2 : U == channels::C3 ? 3 : 4;
   }
 
   // Vector-like reserve, to be template specialized
@@ -133,15 +182,24 @@ public:
     if (width != m_widthPix || height != m_heightPix)
     {
       DEBUG("Attempting internal_malloc\n");
-      T* newdata = internal_malloc(
-        static_cast<IppSizeL>(width),
-        static_cast<IppSizeL>(height)
-      ); // note that this sets m_stepBytes internally
+      // Keep the old step so that the old data can still be released correctly
+      IppSizeL oldStepBytes = m_stepBytes;
+      T* newdata = m_pooled ?
+        pooled_malloc(
+          static_cast<IppSizeL>(width),
+          static_cast<IppSizeL>(height)
+        ) :
+        internal_malloc(
+          static_cast<IppSizeL>(width),
+          static_cast<IppSizeL>(height)
+        ); // note that this sets m_stepBytes internally
+      IppSizeL newStepBytes = m_stepBytes;
 
       // Check not null
       if (newdata == nullptr)
       {
         DEBUG("internal_malloc() failed, throwing..\n");
+        m_stepBytes = oldStepBytes;
         throw std::bad_alloc();
       }
       DEBUG("internal_malloc() succeeded\n");
@@ -149,9 +207,11 @@ public:
       // TODO: copy properly somehow if possible?
 
       // Free old
-      ippiFree(m_data);
+      m_stepBytes = oldStepBytes;
+      internal_free();
 
       // Set all new internal values
+      m_stepBytes = newStepBytes;
       m_widthPix = width;
       m_heightPix = height;
       m_data = newdata;
@@ -198,6 +258,20 @@ public:
     return reinterpret_cast<T*>(bytePtr + row * m_stepBytes);
   }
 
+  // View over one row (all channels interleaved), e.g. to pass to the ipps:: view overloads.
+  // Throws std::out_of_range if row is out of bounds
+  ipps::vector_view<T> rowView(const size_t row) {
+    if (row >= m_heightPix)
+      throw std::out_of_range("row out of bounds");
+    return ipps::vector_view<T>((*this)[row], m_widthPix * numChannels());
+  }
+
+  ipps::vector_view<const T> rowView(const size_t row) const {
+    if (row >= m_heightPix)
+      throw std::out_of_range("row out of bounds");
+    return ipps::vector_view<const T>((*this)[row], m_widthPix * numChannels());
+  }
+
   // Throws std::out_of_range if row or col is out of bounds
   T& at(const size_t row, const size_t col) {
     if (row >= m_heightPix || col >= m_widthPix)
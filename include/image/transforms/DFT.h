@@ -1,22 +1,24 @@
 #pragma once
 
 #include "ipp.h"
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include "../../signal/ipp_ext_vec.h"
 #include "../../ipp_ext_errors.h"
+#include "../../ipp_ext_plancache.h"
 #include "../channels.h"
 
 namespace ippi
 {
 
+/// @brief Read-only 2D real DFT spec for a given ROI size and flag. Safe to share between threads;
+/// each DFT_RToPack using it allocates its own work buffer.
 template <typename T>
-class DFT_RToPack
+class DFT_RToPackPlan
 {
 public:
-  DFT_RToPack() = default;
-
-  DFT_RToPack(IppiSize roiSize, int flag = IPP_FFT_NODIV_BY_ANY)
+  DFT_RToPackPlan(IppiSize roiSize, int flag = IPP_FFT_NODIV_BY_ANY)
     : m_roiSize(roiSize), m_flag(flag)
   {
     if (roiSize.width <= 0 || roiSize.height <= 0)
@@ -25,6 +27,59 @@ public:
     prepare_dft();
   }
 
+  /// @brief Returns a shared plan from ippe::plancache, building and caching it on a miss.
+  static std::shared_ptr<const DFT_RToPackPlan> cached(IppiSize roiSize, int flag = IPP_FFT_NODIV_BY_ANY)
+  {
+    // Invalid sizes are rejected by the constructor before anything is cached
+    return ippe::plancache::get<DFT_RToPackPlan>(
+      ippe::plancache::makeKey<DFT_RToPackPlan>(
+        static_cast<size_t>(static_cast<unsigned int>(roiSize.width)),
+        static_cast<size_t>(static_cast<unsigned int>(roiSize.height)),
+        flag
+      ),
+      [roiSize, flag](){ return std::make_shared<const DFT_RToPackPlan>(roiSize, flag); }
+    );
+  }
+
+  // Getters
+  IppiSize roiSize() const { return m_roiSize; }
+  int flag() const { return m_flag; }
+  const Ipp8u* spec() const { return m_DFTSpec.data(); }
+  size_t bufferSize() const { return m_bufferSize; }
+  size_t getMemoryBytes() const { return m_DFTSpec.size(); }
+
+private:
+  IppiSize m_roiSize = {0, 0};
+  int m_flag = 0;
+  size_t m_bufferSize = 0;
+
+  ipps::vector<Ipp8u> m_DFTSpec;
+
+  void prepare_dft();
+};
+
+template <typename T>
+class DFT_RToPack
+{
+public:
+  DFT_RToPack() = default;
+
+  DFT_RToPack(IppiSize roiSize, int flag = IPP_FFT_NODIV_BY_ANY)
+    : DFT_RToPack(std::make_shared<const DFT_RToPackPlan<T>>(roiSize, flag))
+  {
+  }
+
+  /// @brief Uses an existing (e.g. cached) plan, only allocating a work buffer.
+  explicit DFT_RToPack(std::shared_ptr<const DFT_RToPackPlan<T>> plan)
+    : m_plan(std::move(plan))
+  {
+    if (!m_plan)
+      throw std::invalid_argument("DFT_RToPack: plan cannot be null");
+
+    if (m_plan->bufferSize() > 0)
+      m_MemBuffer.resize(m_plan->bufferSize());
+  }
+
   template <channels U>
   void fwd(const T* src, int srcStep, T* dst, int dstStep);
 
@@ -32,33 +87,37 @@ public:
   void inv(const T* src, int srcStep, T* dst, int dstStep);
 
   // Getters
-  IppiSize roiSize() const { return m_roiSize; }
+  IppiSize roiSize() const { return m_plan ? m_plan->roiSize() : IppiSize{0, 0}; }
+  const std::shared_ptr<const DFT_RToPackPlan<T>>& plan() const { return m_plan; }
 
   // Fwd output size (for real types)
   IppiSize fwdOutputSize() const{
+    IppiSize roi = roiSize();
     // NOTE: this is columns * rows
     return {
-      m_roiSize.width,
-      m_roiSize.height % 2 == 0 ?
-        m_roiSize.height :   // even rows
-        m_roiSize.height + 1 // odd rows
+      roi.width,
+      roi.height % 2 == 0 ?
+        roi.height :   // even rows
+        roi.height + 1 // odd rows
     };
   }
 
   // Bwd output size (for real types)
   IppiSize bwdOutputSize() const{
     // NOTE: this is columns * rows
-    return { m_roiSize.width, 1 };
+    return { roiSize().width, 1 };
   }
 
 private:
-  IppiSize m_roiSize = {0, 0};
-  int m_flag = 0;
-
-  ipps::vector<Ipp8u> m_DFTSpec;
+  std::shared_ptr<const DFT_RToPackPlan<T>> m_plan;
   ipps::vector<Ipp8u> m_MemBuffer;
 
-  void prepare_dft();
+  const Ipp8u* spec() const
+  {
+    if (!m_plan)
+      throw std::runtime_error("DFT_RToPack: no plan, construct with an ROI size first");
+    return m_plan->spec();
+  }
 
 };
 
@@ -68,7 +127,7 @@ private:
 
 // Ipp32f
 template <>
-inline void DFT_RToPack<Ipp32f>::prepare_dft()
+inline void DFT_RToPackPlan<Ipp32f>::prepare_dft()
 {
   int sizeSpec, sizeInit, sizeBuffer;
   IPP_NO_ERROR(
@@ -79,10 +138,9 @@ inline void DFT_RToPack<Ipp32f>::prepare_dft()
     "ippiDFTGetSize_R_32f"
   );
 
-  // Resize the buffers
+  // Resize the spec; the work buffer belongs to each DFT_RToPack
   m_DFTSpec.resize(sizeSpec);
-  if (sizeBuffer > 0)
-    m_MemBuffer.resize(sizeBuffer);
+  m_bufferSize = sizeBuffer > 0 ? static_cast<size_t>(sizeBuffer) : 0;
 
   // Temporary memInit buffer if required
   ipps::vector<Ipp8u> memInit;
@@ -114,7 +172,7 @@ inline void DFT_RToPack<Ipp32f>::fwd<channels::C1>(
   IPP_NO_ERROR(
     ippiDFTFwd_RToPack_32f_C1R(
       src, srcStep, dst, dstStep,
-      reinterpret_cast<IppiDFTSpec_R_32f*>(m_DFTSpec.data()),
+      reinterpret_cast<const IppiDFTSpec_R_32f*>(spec()),
       m_MemBuffer.data()
     ),
     "ippiDFTFwd_RToPack_32f_C1R"
@@ -130,7 +188,7 @@ inline void DFT_RToPack<Ipp32f>::fwd<channels::C3>(
   IPP_NO_ERROR(
     ippiDFTFwd_RToPack_32f_C3R(
       src, srcStep, dst, dstStep,
-      reinterpret_cast<IppiDFTSpec_R_32f*>(m_DFTSpec.data()),
+      reinterpret_cast<const IppiDFTSpec_R_32f*>(spec()),
       m_MemBuffer.data()
     ),
     "ippiDFTFwd_RToPack_32f_C3R"
@@ -146,7 +204,7 @@ inline void DFT_RToPack<Ipp32f>::fwd<channels::C4>(
   IPP_NO_ERROR(
     ippiDFTFwd_RToPack_32f_C4R(
       src, srcStep, dst, dstStep,
-      reinterpret_cast<IppiDFTSpec_R_32f*>(m_DFTSpec.data()),
+      reinterpret_cast<const IppiDFTSpec_R_32f*>(spec()),
       m_MemBuffer.data()
     ),
     "ippiDFTFwd_RToPack_32f_C4R"
@@ -162,7 +220,7 @@ inline void DFT_RToPack<Ipp32f>::fwd<channels::AC4>(
   IPP_NO_ERROR(
     ippiDFTFwd_RToPack_32f_AC4R(
       src, srcStep, dst, dstStep,
-      reinterpret_cast<IppiDFTSpec_R_32f*>(m_DFTSpec.data()),
+      reinterpret_cast<const IppiDFTSpec_R_32f*>(spec()),
       m_MemBuffer.data()
     ),
     "ippiDFTFwd_RToPack_32f_AC4R"
@@ -183,7 +241,7 @@ inline void DFT_RToPack<Ipp32f>::inv<channels::C1>(
   IPP_NO_ERROR(
     ippiDFTInv_PackToR_32f_C1R(
       src, srcStep, dst, dstStep,
-      reinterpret_cast<IppiDFTSpec_R_32f*>(m_DFTSpec.data()),
+      reinterpret_cast<const IppiDFTSpec_R_32f*>(spec()),
       m_MemBuffer.data()
     ),
     "ippiDFTInv_PackToR_32f_C1R"
@@ -199,7 +257,7 @@ inline void DFT_RToPack<Ipp32f>::inv<channels::C3>(
   IPP_NO_ERROR(
     ippiDFTInv_PackToR_32f_C3R(
       src, srcStep, dst, dstStep,
-      reinterpret_cast<IppiDFTSpec_R_32f*>(m_DFTSpec.data()),
+      reinterpret_cast<const IppiDFTSpec_R_32f*>(spec()),
       m_MemBuffer.data()
     ),
     "ippiDFTInv_PackToR_32f_C3R"
@@ -215,7 +273,7 @@ inline void DFT_RToPack<Ipp32f>::inv<channels::C4>(
   IPP_NO_ERROR(
     ippiDFTInv_PackToR_32f_C4R(
       src, srcStep, dst, dstStep,
-      reinterpret_cast<IppiDFTSpec_R_32f*>(m_DFTSpec.data()),
+      reinterpret_cast<const IppiDFTSpec_R_32f*>(spec()),
       m_MemBuffer.data()
     ),
     "ippiDFTInv_PackToR_32f_C4R"
@@ -231,7 +289,7 @@ inline void DFT_RToPack<Ipp32f>::inv<channels::AC4>(
   IPP_NO_ERROR(
     ippiDFTInv_PackToR_32f_AC4R(
       src, srcStep, dst, dstStep,
-      reinterpret_cast<IppiDFTSpec_R_32f*>(m_DFTSpec.data()),
+      reinterpret_cast<const IppiDFTSpec_R_32f*>(spec()),
       m_MemBuffer.data()
     ),
     "ippiDFTInv_PackToR_32f_AC4R"
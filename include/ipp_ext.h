@@ -1,6 +1,8 @@
 #pragma once
 
 #include "ipp_ext_errors.h"
+#include "ipp_ext_pool.h"
+#include "ipp_ext_plancache.h"
 
 // Signal
 #include "ipp_ext_signal.h"
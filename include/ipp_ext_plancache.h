@@ -0,0 +1,189 @@
+/*
+Process-wide cache of immutable transform plans (DFT specs and the like), shared by ipps and ippi.
+
+Plans are keyed on their type and dimensions (which include the data type and any flags), and held
+in least-recently-used order up to a byte capacity. Evicting a plan only drops the cache's reference;
+objects still using it keep it alive. Plans larger than the capacity are built but never cached.
+
+Example:
+    auto plan = ipps::DFTCToCPlan<Ipp32fc>::cached(100000); // miss, runs ippsDFTInit
+    ipps::DFTCToC<Ipp32fc> dft(plan);
+    auto again = ipps::DFTCToCPlan<Ipp32fc>::cached(100000); // hit, same plan
+    ippe::plancache::Stats s = ippe::plancache::getStats();
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <typeinfo>
+
+namespace ippe
+{
+namespace plancache
+{
+    /// @brief Snapshot of the cache counters.
+    struct Stats
+    {
+        uint64_t hits = 0;      // lookups served from the cache
+        uint64_t misses = 0;    // lookups that had to build a new plan
+        uint64_t evictions = 0; // plans dropped to stay under the capacity
+        uint64_t entries = 0;   // plans currently cached
+        uint64_t bytesHeld = 0; // bytes of the plans currently cached
+    };
+
+    /// @brief Identifies a plan; the plan type carries the data type, the rest its dimensions and flag.
+    struct Key
+    {
+        std::type_index type;
+        size_t dim0;
+        size_t dim1;
+        int flag;
+
+        bool operator<(const Key& other) const
+        {
+            if (type != other.type) return type < other.type;
+            if (dim0 != other.dim0) return dim0 < other.dim0;
+            if (dim1 != other.dim1) return dim1 < other.dim1;
+            return flag < other.flag;
+        }
+    };
+
+    /// @brief Builds the key for a plan of type Plan.
+    template <typename Plan>
+    inline Key makeKey(size_t dim0, size_t dim1, int flag)
+    {
+        return Key{std::type_index(typeid(Plan)), dim0, dim1, flag};
+    }
+
+    namespace detail
+    {
+        struct Entry
+        {
+            Key key;
+            std::shared_ptr<const void> plan;
+            size_t bytes;
+        };
+
+        struct Cache
+        {
+            std::mutex mutex;
+            std::list<Entry> lru; // most recently used at the front
+            std::map<Key, std::list<Entry>::iterator> index;
+            size_t capacity = (size_t)256 * 1024 * 1024; // 256 MB by default
+            Stats stats;
+
+            // Caller must hold the mutex
+            void evict_to(size_t bytes)
+            {
+                while (!lru.empty() && stats.bytesHeld > bytes)
+                {
+                    Entry& last = lru.back();
+                    stats.bytesHeld -= last.bytes;
+                    stats.entries--;
+                    stats.evictions++;
+                    index.erase(last.key);
+                    lru.pop_back();
+                }
+            }
+        };
+
+        inline Cache& cache()
+        {
+            static Cache c;
+            return c;
+        }
+    }
+
+    /// @brief Returns the cached plan for key, or calls make() (outside the lock) to build one and caches it.
+    /// @tparam Plan Plan type, which must provide size_t getMemoryBytes() const.
+    /// @param make Callable returning std::shared_ptr<const Plan>. Exceptions propagate and nothing is cached.
+    template <typename Plan, typename Make>
+    inline std::shared_ptr<const Plan> get(const Key& key, Make make)
+    {
+        detail::Cache& c = detail::cache();
+        {
+            std::lock_guard<std::mutex> lock(c.mutex);
+            auto it = c.index.find(key);
+            if (it != c.index.end())
+            {
+                c.lru.splice(c.lru.begin(), c.lru, it->second);
+                c.stats.hits++;
+                return std::static_pointer_cast<const Plan>(it->second->plan);
+            }
+            c.stats.misses++;
+        }
+
+        // Building may take a while, so don't block other lookups meanwhile
+        std::shared_ptr<const Plan> plan = make();
+        size_t bytes = plan->getMemoryBytes();
+
+        std::lock_guard<std::mutex> lock(c.mutex);
+        auto it = c.index.find(key);
+        if (it != c.index.end()) // another thread built the same plan first; use theirs
+        {
+            c.lru.splice(c.lru.begin(), c.lru, it->second);
+            return std::static_pointer_cast<const Plan>(it->second->plan);
+        }
+
+        if (bytes > c.capacity)
+            return plan;
+
+        c.evict_to(c.capacity - bytes);
+        c.lru.push_front(detail::Entry{key, plan, bytes});
+        c.index[key] = c.lru.begin();
+        c.stats.entries++;
+        c.stats.bytesHeld += bytes;
+        return plan;
+    }
+
+    /// @brief Sets the maximum number of bytes of plans to keep, evicting the least recently used as required.
+    inline void setCapacity(size_t bytes)
+    {
+        detail::Cache& c = detail::cache();
+        std::lock_guard<std::mutex> lock(c.mutex);
+        c.capacity = bytes;
+        c.evict_to(bytes);
+    }
+
+    inline size_t capacity()
+    {
+        detail::Cache& c = detail::cache();
+        std::lock_guard<std::mutex> lock(c.mutex);
+        return c.capacity;
+    }
+
+    /// @brief Drops every cached plan. Plans still in use elsewhere stay alive until released.
+    inline void clear()
+    {
+        detail::Cache& c = detail::cache();
+        std::lock_guard<std::mutex> lock(c.mutex);
+        c.lru.clear();
+        c.index.clear();
+        c.stats.entries = 0;
+        c.stats.bytesHeld = 0;
+    }
+
+    inline Stats getStats()
+    {
+        detail::Cache& c = detail::cache();
+        std::lock_guard<std::mutex> lock(c.mutex);
+        return c.stats;
+    }
+
+    /// @brief Resets the hit/miss/eviction counters. entries and bytesHeld are left alone since they track live state.
+    inline void resetStats()
+    {
+        detail::Cache& c = detail::cache();
+        std::lock_guard<std::mutex> lock(c.mutex);
+        c.stats.hits = 0;
+        c.stats.misses = 0;
+        c.stats.evictions = 0;
+    }
+}
+}
@@ -0,0 +1,236 @@
+/*
+Opt-in pooled allocator shared by ipps::vector and ippi::image.
+
+Blocks are allocated with ippsMalloc (so they are 64-byte aligned and may always be
+released with ippsFree), rounded up to power-of-two size classes, and recycled via
+per-thread free lists. Nothing is pooled unless it is enabled, either globally
+via ippe::pool::setEnabled(true) or per instance via setPooled(true) on the container.
+
+Example:
+    ippe::pool::setEnabled(true); // every vector/image constructed from now on is pooled
+    {
+        ipps::vector<Ipp32fc> tmp(4096); // miss, allocated with ippsMalloc
+    } // returned to this thread's free list
+    ipps::vector<Ipp32fc> tmp2(4000); // hit, same 32768 byte size class
+    ippe::pool::Stats s = ippe::pool::getStats();
+*/
+
+#pragma once
+
+#include "ipp.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace ippe
+{
+namespace pool
+{
+    /// @brief Snapshot of the pool counters, summed over all threads.
+    struct Stats
+    {
+        uint64_t hits = 0;      // allocations served from a free list
+        uint64_t misses = 0;    // allocations that had to call ippsMalloc
+        uint64_t bytesHeld = 0; // bytes currently sitting in free lists
+    };
+
+    namespace detail
+    {
+        // Size classes are powers of two from 64 bytes (one cache line) up to 2^40 bytes.
+        // Anything larger is simply not pooled.
+        const int MIN_CLASS_SHIFT = 6;
+        const int NUM_CLASSES = 35;
+
+        struct Counters
+        {
+            std::atomic<uint64_t> hits{0};
+            std::atomic<uint64_t> misses{0};
+            std::atomic<uint64_t> bytesHeld{0};
+        };
+
+        inline Counters& counters()
+        {
+            static Counters c;
+            return c;
+        }
+
+        inline std::atomic<bool>& enabledFlag()
+        {
+            static std::atomic<bool> flag{false};
+            return flag;
+        }
+
+        inline std::atomic<size_t>& threadLimit()
+        {
+            static std::atomic<size_t> limit{(size_t)256 * 1024 * 1024}; // 256 MB per thread by default
+            return limit;
+        }
+
+        /// @brief Returns the size class for a request in bytes, or -1 if it is too large to pool.
+        inline int sizeClass(size_t bytes)
+        {
+            int k = 0;
+            while (((size_t)1 << (k + MIN_CLASS_SHIFT)) < bytes)
+            {
+                k++;
+                if (k >= NUM_CLASSES)
+                    return -1;
+            }
+            return k;
+        }
+
+        inline size_t classBytes(int k)
+        {
+            return (size_t)1 << (k + MIN_CLASS_SHIFT);
+        }
+
+        // Trivially destructible, so it remains readable while (and after) the cache below is destroyed.
+        // This lets containers with static storage duration still free their memory at exit.
+        inline bool& cacheDestroyed()
+        {
+            static thread_local bool destroyed = false;
+            return destroyed;
+        }
+
+        struct ThreadCache
+        {
+            std::vector<void*> lists[NUM_CLASSES];
+            size_t bytesHeld = 0;
+
+            void trim()
+            {
+                for (int k = 0; k < NUM_CLASSES; k++)
+                {
+                    for (void* p : lists[k])
+                        ippsFree(p);
+                    lists[k].clear();
+                }
+                counters().bytesHeld -= bytesHeld;
+                bytesHeld = 0;
+            }
+
+            ~ThreadCache()
+            {
+                trim();
+                cacheDestroyed() = true;
+            }
+        };
+
+        inline ThreadCache& threadCache()
+        {
+            static thread_local ThreadCache cache;
+            return cache;
+        }
+    }
+
+    /// @brief Sets whether containers constructed from now on use the pool by default.
+    inline void setEnabled(bool enabled){ detail::enabledFlag() = enabled; }
+
+    /// @brief Returns whether containers use the pool by default.
+    inline bool enabled(){ return detail::enabledFlag(); }
+
+    /// @brief Sets the maximum number of bytes each thread may keep in its free lists.
+    /// Blocks released beyond this are returned to ippsFree immediately.
+    inline void setThreadCacheLimit(size_t bytes){ detail::threadLimit() = bytes; }
+
+    inline size_t threadCacheLimit(){ return detail::threadLimit(); }
+
+    /// @brief Allocates at least the requested number of bytes, 64-byte aligned.
+    /// Returns nullptr if the underlying ippsMalloc fails.
+    inline void* allocateBytes(size_t bytes)
+    {
+        int k = detail::sizeClass(bytes);
+        if (k >= 0 && !detail::cacheDestroyed())
+        {
+            detail::ThreadCache& cache = detail::threadCache();
+            std::vector<void*>& list = cache.lists[k];
+            if (!list.empty())
+            {
+                void* p = list.back();
+                list.pop_back();
+                cache.bytesHeld -= detail::classBytes(k);
+                detail::counters().bytesHeld -= detail::classBytes(k);
+                detail::counters().hits++;
+                return p;
+            }
+        }
+
+        detail::counters().misses++;
+        return ippsMalloc_8u_L(k >= 0 ? (IppSizeL)detail::classBytes(k) : (IppSizeL)bytes);
+    }
+
+    /// @brief Releases a block obtained from allocateBytes(). The byte count must be the one
+    /// that was requested during the allocation (anything in the same size class works).
+    inline void releaseBytes(void* p, size_t bytes)
+    {
+        if (p == nullptr)
+            return;
+
+        int k = detail::sizeClass(bytes);
+        // bytes == 0 means the caller lost track of the size; the block is still from ippsMalloc
+        if (k < 0 || bytes == 0 || detail::cacheDestroyed())
+        {
+            ippsFree(p);
+            return;
+        }
+
+        detail::ThreadCache& cache = detail::threadCache();
+        if (cache.bytesHeld + detail::classBytes(k) > detail::threadLimit())
+        {
+            ippsFree(p);
+            return;
+        }
+
+        try
+        {
+            cache.lists[k].push_back(p);
+        }
+        catch (const std::bad_alloc&)
+        {
+            ippsFree(p);
+            return;
+        }
+        cache.bytesHeld += detail::classBytes(k);
+        detail::counters().bytesHeld += detail::classBytes(k);
+    }
+
+    /// @brief Typed helper around allocateBytes().
+    template <typename T>
+    inline T* allocate(size_t count)
+    {
+        return static_cast<T*>(allocateBytes(count * sizeof(T)));
+    }
+
+    /// @brief Typed helper around releaseBytes(); count must match the one used in allocate().
+    template <typename T>
+    inline void release(T* p, size_t count)
+    {
+        releaseBytes(static_cast<void*>(p), count * sizeof(T));
+    }
+
+    /// @brief Frees every block held in the calling thread's free lists.
+    inline void trim()
+    {
+        if (!detail::cacheDestroyed())
+            detail::threadCache().trim();
+    }
+
+    inline Stats getStats()
+    {
+        Stats s;
+        s.hits = detail::counters().hits;
+        s.misses = detail::counters().misses;
+        s.bytesHeld = detail::counters().bytesHeld;
+        return s;
+    }
+
+    /// @brief Resets the hit/miss counters. bytesHeld is left alone since it tracks live state.
+    inline void resetStats()
+    {
+        detail::counters().hits = 0;
+        detail::counters().misses = 0;
+    }
+}
+}
@@ -2,6 +2,15 @@
 
 #include "signal/ipp_ext_vec.h"
 #include "signal/ipp_ext_dft.h"
+#include "signal/ipp_ext_dft_real.h"
+#include "signal/ipp_ext_dft_fourstep.h"
+#include "signal/ipp_ext_chirpz.h"
+#include "signal/ipp_ext_goertzel.h"
+#include "signal/ipp_ext_sliding_dft.h"
+#include "signal/ipp_ext_stft.h"
+#include "signal/ipp_ext_welch.h"
+#include "signal/ipp_ext_xcorr.h"
+#include "signal/ipp_ext_caf.h"
 #include "signal/ipp_ext_filter.h"
 #include "signal/ipp_ext_random.h"
 #include "signal/ipp_ext_matrix.h"
@@ -12,3 +21,5 @@
 #include "signal/ipp_ext_stats.h"
 #include "signal/ipp_ext_logical.h"
 #include "signal/ipp_ext_sampling.h"
+#include "signal/ipp_ext_parallel.h"
+#include "signal/ipp_ext_expr.h"
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "../ipp_ext_chunked.h"
+#include "Convert.h"
+#include "Conj.h"
+#include "PolarCart.h"
+#include "PowerSpectr.h"
+#include "RealCplx.h"
+
+/*
+size_t-length overloads of the convert functions.
+These are picked for any integral length other than int, and split the call into int-sized chunks,
+so buffers longer than INT_MAX can be processed in one call.
+*/
+
+namespace ipps{
+    namespace convert{
+
+        template <typename T, typename U, typename L>
+        inline typename detail::enable_if_long<L>::type Convert(const T* src, U* dst, L length)
+        {
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                Convert(src + offset, dst + offset, len);
+            });
+        }
+
+        template <typename T, typename U, typename L>
+        inline typename detail::enable_if_long<L>::type Convert_Sfs(const T* src, U* dst, L length, int scaleFactor, IppRoundMode rndMode=IppRoundMode::ippRndZero)
+        {
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                Convert_Sfs(src + offset, dst + offset, len, scaleFactor, rndMode);
+            });
+        }
+
+        template <typename T, typename L>
+        inline typename detail::enable_if_long<L>::type Conj(const T* src, T* dst, L length)
+        {
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                Conj(src + offset, dst + offset, len);
+            });
+        }
+
+        template <typename T, typename U, typename L>
+        inline typename detail::enable_if_long<L>::type PolarToCart(const T* srcMagn, const T* srcPhase, U* dst, L length)
+        {
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                PolarToCart(srcMagn + offset, srcPhase + offset, dst + offset, len);
+            });
+        }
+
+        template <typename T, typename U, typename L>
+        inline typename detail::enable_if_long<L>::type CartToPolar(const T* src, U* dstMagn, U* dstPhase, L length)
+        {
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                CartToPolar(src + offset, dstMagn + offset, dstPhase + offset, len);
+            });
+        }
+
+        template <typename T, typename L>
+        inline typename detail::enable_if_long<L>::type PolarToCartDeinterleaved(const T* srcMagn, const T* srcPhase, T* dstRe, T* dstIm, L length)
+        {
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                PolarToCartDeinterleaved(srcMagn + offset, srcPhase + offset, dstRe + offset, dstIm + offset, len);
+            });
+        }
+
+        template <typename T, typename U, typename L>
+        inline typename detail::enable_if_long<L>::type PowerSpectr(const T* src, U* dst, L length)
+        {
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                PowerSpectr(src + offset, dst + offset, len);
+            });
+        }
+
+        template <typename T, typename U, typename L>
+        inline typename detail::enable_if_long<L>::type PowerSpectr(const T* srcRe, const T* srcIm, U* dst, L length)
+        {
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                PowerSpectr(srcRe + offset, srcIm + offset, dst + offset, len);
+            });
+        }
+
+        template <typename T, typename U, typename L>
+        inline typename detail::enable_if_long<L>::type RealToCplx(const T* srcRe, const T* srcIm, U* dst, L length)
+        {
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                RealToCplx(srcRe + offset, srcIm + offset, dst + offset, len);
+            });
+        }
+
+        template <typename T, typename U, typename L>
+        inline typename detail::enable_if_long<L>::type CplxToReal(const T* src, U* dstRe, U* dstIm, L length)
+        {
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                CplxToReal(src + offset, dstRe + offset, dstIm + offset, len);
+            });
+        }
+
+    }
+}
@@ -14,6 +14,10 @@ namespace ipps{
         template <typename T>
         void Conj_I(T* srcDst, int len);
 
+        /// @brief dst[i] = conj(src[len-1-i]), e.g. to fill the upper half of a real signal's spectrum.
+        template <typename T>
+        void ConjFlip(const T* src, T* dst, int len);
+
         // ============================
         // ============================ 
         //  Conj Specializations
@@ -77,5 +81,30 @@ namespace ipps{
             IppStatus sts = ippsConj_64fc_I(srcDst, len);
             IPP_NO_ERROR(sts, "ippsConj_64fc_I");
         }
+
+        // ============================
+        // ============================ 
+        //  ConjFlip Specializations
+        // ============================
+        // ============================
+
+        template <typename T>
+        inline void ConjFlip(const T* src, T* dst, int len){
+            throw std::runtime_error("ippsConjFlip not implemented for generic types");
+        }
+
+        // 32fc
+        template <>
+        inline void ConjFlip(const Ipp32fc* src, Ipp32fc* dst, int len){
+            IppStatus sts = ippsConjFlip_32fc(src, dst, len);
+            IPP_NO_ERROR(sts, "ippsConjFlip_32fc");
+        }
+
+        // 64fc
+        template <>
+        inline void ConjFlip(const Ipp64fc* src, Ipp64fc* dst, int len){
+            IppStatus sts = ippsConjFlip_64fc(src, dst, len);
+            IPP_NO_ERROR(sts, "ippsConjFlip_64fc");
+        }
     }
 }
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "ipp.h"
+#include "../../ipp_ext_errors.h"
+#include <stdexcept>
+#include <string>
+
+namespace ipps{
+    namespace convert{
+
+        // complex interleaved inputs
+
+        template <typename T, typename U>
+        void Magnitude(const T* src, U* dst, int len);
+
+        // ============================
+        // ============================ 
+        //  Magnitude Specializations
+        // ============================
+        // ============================
+
+        template <typename T, typename U>
+        inline void Magnitude(const T* src, U* dst, int len){
+            throw std::runtime_error("Magnitude not implemented for generic types");
+        }
+
+        // 64fc to 64f
+        template <>
+        inline void Magnitude(const Ipp64fc* src, Ipp64f* dst, int len){
+            IppStatus sts = ippsMagnitude_64fc(src, dst, len);
+            IPP_NO_ERROR(sts, "ippsMagnitude_64fc");
+        }
+
+        // 32fc to 32f
+        template <>
+        inline void Magnitude(const Ipp32fc* src, Ipp32f* dst, int len){
+            IppStatus sts = ippsMagnitude_32fc(src, dst, len);
+            IPP_NO_ERROR(sts, "ippsMagnitude_32fc");
+        }
+
+    }
+}
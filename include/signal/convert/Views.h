@@ -0,0 +1,89 @@
+#pragma once
+
+#include "../ipp_ext_view.h"
+#include "Convert.h"
+#include "Conj.h"
+#include "PowerSpectr.h"
+#include "RealCplx.h"
+
+/*
+vector_view overloads of the convert functions.
+All views must be the same size; strided views are processed in tiles (see ipp_ext_view.h).
+*/
+
+namespace ipps{
+    namespace convert{
+
+        /// @brief View overload of Convert.
+        template <typename T, typename U>
+        inline void Convert(const vector_view<T>& src, const vector_view<U>& dst)
+        {
+            typedef typename vector_view<T>::value_type Tn;
+            detail::checkViewSizes(src.size(), dst.size(), "convert::Convert");
+            detail::unaryTiles(src, dst, [](const Tn* a, U* c, int len){
+                Convert(a, c, len);
+            });
+        }
+
+        /// @brief View overload of Conj. Pass the same view twice for in-place.
+        template <typename T, typename U>
+        inline void Conj(const vector_view<T>& src, const vector_view<U>& dst)
+        {
+            typedef typename vector_view<T>::value_type Tn;
+            detail::checkViewSizes(src.size(), dst.size(), "convert::Conj");
+            detail::unaryTiles(src, dst, [](const Tn* a, U* c, int len){
+                Conj(a, c, len);
+            });
+        }
+
+        /// @brief View overload of PowerSpectr (interleaved complex input).
+        template <typename T, typename U>
+        inline void PowerSpectr(const vector_view<T>& src, const vector_view<U>& dst)
+        {
+            typedef typename vector_view<T>::value_type Tn;
+            detail::checkViewSizes(src.size(), dst.size(), "convert::PowerSpectr");
+            detail::unaryTiles(src, dst, [](const Tn* a, U* c, int len){
+                PowerSpectr(a, c, len);
+            });
+        }
+
+        /// @brief View overload of RealToCplx.
+        template <typename T, typename U, typename V>
+        inline void RealToCplx(const vector_view<T>& srcRe, const vector_view<U>& srcIm, const vector_view<V>& dst)
+        {
+            typedef typename vector_view<T>::value_type Tn;
+            typedef typename vector_view<U>::value_type Un;
+            detail::checkViewSizes(srcRe.size(), srcIm.size(), "convert::RealToCplx");
+            detail::checkViewSizes(srcRe.size(), dst.size(), "convert::RealToCplx");
+            detail::binaryTiles(srcRe, srcIm, dst, [](const Tn* a, const Un* b, V* c, int len){
+                RealToCplx(a, b, c, len);
+            });
+        }
+
+        /// @brief View overload of CplxToReal.
+        template <typename T, typename U>
+        inline void CplxToReal(const vector_view<T>& src, const vector_view<U>& dstRe, const vector_view<U>& dstIm)
+        {
+            typedef typename vector_view<T>::value_type Tn;
+            detail::checkViewSizes(src.size(), dstRe.size(), "convert::CplxToReal");
+            detail::checkViewSizes(src.size(), dstIm.size(), "convert::CplxToReal");
+
+            if (src.contiguous() && dstRe.contiguous() && dstIm.contiguous())
+            {
+                if (src.size() > 0)
+                    CplxToReal(src.data(), dstRe.data(), dstIm.data(), (int)src.size());
+                return;
+            }
+
+            // Two outputs, so the generic tile helpers don't apply; write the tiles out here
+            U rebuf[detail::VIEW_TILE];
+            U imbuf[detail::VIEW_TILE];
+            detail::reduceTiles(src, [&](const Tn* a, int len, size_t offset){
+                CplxToReal(a, rebuf, imbuf, len);
+                detail::scatter(rebuf, dstRe, offset, (size_t)len);
+                detail::scatter(imbuf, dstIm, offset, (size_t)len);
+            });
+        }
+
+    }
+}
@@ -0,0 +1,223 @@
+/*
+Polyphase FFT channelizer (analysis filterbank), splitting a complex input into M equally spaced channels.
+
+Channel m is centred on m / M cycles per sample (so channels above M / 2 are the negative frequencies),
+and its output is what a frequency shift, a lowpass FIR with the prototype taps h and a decimation by D
+would give:
+
+    y_m[n] = sum_l h[l] * x[nD - l] * exp(-2 pi i m (nD - l) / M)
+
+Rather than doing that for every channel, each output instant sums the windowed input down to M
+polyphase branches and feeds them through a single length-M DFTCToC, so the cost per output is one pass
+over the taps plus one DFT, for all M channels together.
+
+Two modes are supported: critically sampled (D = M) and 2x oversampled (D = M / 2, M even), where
+neighbouring channels overlap so that signals on channel edges are not lost. The input history is kept
+between calls, so a stream can be pushed in chunks of any size.
+
+Example:
+    ipps::filter::PolyphaseChannelizer<Ipp32fc> channelizer(256, 8, ipps::filter::ChannelizerMode::Oversampled);
+    ipps::matrix<Ipp32fc> channels(256, channelizer.outputsFor(x.size()));
+    channelizer.process(x.data(), x.size(), channels); // row m is channel m
+*/
+
+#pragma once
+
+#include "ipp.h"
+#include "../../ipp_ext_errors.h"
+#include "../ipp_ext_vec.h"
+#include "../ipp_ext_copy.h"
+#include "../ipp_ext_math.h"
+#include "../ipp_ext_matrix.h"
+#include "../ipp_ext_dft.h"
+#include "FIRGen.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace ipps{
+    namespace filter
+    {
+        /// @brief Output rate of a polyphase filterbank, relative to its number of channels M.
+        enum class ChannelizerMode
+        {
+            Critical,   // decimation by M
+            Oversampled // decimation by M / 2
+        };
+
+        /// @brief Polyphase analysis filterbank: M channels from one complex stream, for 32fc/64fc.
+        /// @tparam T Type of the taps and the input/output.
+        template <typename T>
+        class PolyphaseChannelizer
+        {
+        public:
+            PolyphaseChannelizer()
+            {}
+
+            /// @brief Uses a prototype lowpass from generateLowpassTaps, cut off at half the channel spacing.
+            /// @param numChannels M.
+            /// @param tapsPerChannel Length of each polyphase branch; the prototype has M times this many taps.
+            /// @param mode Critically sampled or 2x oversampled.
+            /// @param winType Window for the prototype design.
+            PolyphaseChannelizer(size_t numChannels, size_t tapsPerChannel,
+                                 ChannelizerMode mode = ChannelizerMode::Critical, IppWinType winType = ippWinHamming)
+                : PolyphaseChannelizer(prototype(numChannels, tapsPerChannel, winType), numChannels, mode)
+            {}
+
+            /// @param taps Prototype lowpass, of any length; it is zero-padded to a multiple of M.
+            /// @param numChannels M.
+            /// @param mode Critically sampled or 2x oversampled.
+            PolyphaseChannelizer(const vector<T>& taps, size_t numChannels, ChannelizerMode mode = ChannelizerMode::Critical)
+                : m_numChannels{numChannels}, m_mode{mode}
+            {
+                if (numChannels < 2)
+                    throw std::invalid_argument("PolyphaseChannelizer: need at least 2 channels");
+                if (taps.size() == 0)
+                    throw std::invalid_argument("PolyphaseChannelizer: taps cannot be empty");
+                if (mode == ChannelizerMode::Oversampled && numChannels % 2 != 0)
+                    throw std::invalid_argument("PolyphaseChannelizer: oversampling needs an even number of channels, not " +
+                        std::to_string(numChannels));
+
+                m_decimation = mode == ChannelizerMode::Critical ? numChannels : numChannels / 2;
+                m_taps = taps;
+
+                // Reversed, so that a forward-running window of the input lines up with it
+                size_t branches = (taps.size() + numChannels - 1) / numChannels;
+                m_windowLength = branches * numChannels;
+                m_reversed.resize(m_windowLength);
+                m_reversed.zero();
+                for (size_t i = 0; i < taps.size(); i++)
+                    m_reversed[m_windowLength - 1 - i] = taps[i];
+
+                m_dft = DFTCToC<T>(numChannels);
+                m_history.resize(m_windowLength - 1 + maxChunk());
+                m_product.resize(m_windowLength);
+                m_branches.resize(numChannels);
+                m_spectrum.resize(numChannels);
+                reset();
+            }
+
+            /// @brief Channelizes len samples, writing outputsFor(len) samples of every channel.
+            /// @param out Channel m goes to out + m * outStride, from its first element.
+            /// @return The number of samples written per channel.
+            size_t process(const T* in, size_t len, T* out, size_t outStride)
+            {
+                if (m_numChannels == 0)
+                    throw std::runtime_error("PolyphaseChannelizer: not configured, construct with taps first");
+                if (outStride < outputsFor(len))
+                    throw std::invalid_argument("PolyphaseChannelizer: output row stride must be at least the number of outputs");
+
+                const size_t delay = m_windowLength - 1;
+                size_t written = 0;
+                while (len > 0)
+                {
+                    size_t chunk = std::min(len, maxChunk());
+                    Copy(in, m_history.data() + delay, chunk);
+
+                    // Sample m_samples + i is at delay + i, so its window starts at i
+                    size_t i = (m_decimation - m_samples % m_decimation) % m_decimation;
+                    for (; i < chunk; i += m_decimation)
+                    {
+                        output(m_history.data() + i);
+                        for (size_t m = 0; m < m_numChannels; m++)
+                            out[m * outStride + written] = m_spectrum[m];
+                        written++;
+                    }
+
+                    // Keep the last delay samples as the history for the next chunk
+                    std::copy(m_history.data() + chunk, m_history.data() + chunk + delay, m_history.data());
+                    m_samples += chunk;
+                    in += chunk;
+                    len -= chunk;
+                }
+                return written;
+            }
+
+            /// @brief process() into the rows of a matrix with getNumChannels() rows and at least outputsFor(len) columns.
+            size_t process(const T* in, size_t len, matrix<T>& out)
+            {
+                if (out.rows() != m_numChannels)
+                    throw std::invalid_argument("PolyphaseChannelizer: matrix has " + std::to_string(out.rows()) +
+                        " rows, expected one per channel (" + std::to_string(m_numChannels) + ")");
+                if (out.columns() < outputsFor(len))
+                    throw std::invalid_argument("PolyphaseChannelizer: matrix needs at least " + std::to_string(outputsFor(len)) +
+                        " columns");
+                return process(in, len, out.data(), out.columns());
+            }
+
+            /// @brief Number of samples per channel that process() will produce for the next len input samples.
+            size_t outputsFor(size_t len) const
+            {
+                if (m_decimation == 0)
+                    return 0;
+                // Outputs fall on the samples that are multiples of the decimation
+                size_t first = (m_decimation - m_samples % m_decimation) % m_decimation;
+                return len > first ? (len - first - 1) / m_decimation + 1 : 0;
+            }
+
+            /// @brief Clears the input history, as if no samples had been pushed.
+            void reset()
+            {
+                m_history.zero();
+                m_samples = 0;
+            }
+
+            size_t getNumChannels() const { return m_numChannels; }
+            size_t getDecimation() const { return m_decimation; }
+            ChannelizerMode getMode() const { return m_mode; }
+            const vector<T>& getTaps() const { return m_taps; }
+            /// @brief Total input samples pushed since construction or the last reset().
+            size_t getSampleCount() const { return m_samples; }
+
+            /// @brief The default prototype: M * tapsPerChannel taps, cut off at half the channel spacing, unit gain at DC.
+            static vector<T> prototype(size_t numChannels, size_t tapsPerChannel, IppWinType winType = ippWinHamming)
+            {
+                if (numChannels < 2 || tapsPerChannel == 0)
+                    throw std::invalid_argument("PolyphaseChannelizer: need at least 2 channels and 1 tap per channel");
+                return generateLowpassTaps<T>(0.5 / (double)numChannels, (int)(numChannels * tapsPerChannel), winType, ippTrue);
+            }
+
+        private:
+            size_t m_numChannels = 0;
+            size_t m_decimation = 0;
+            ChannelizerMode m_mode = ChannelizerMode::Critical;
+            vector<T> m_taps;
+            vector<T> m_reversed;   // taps reversed and zero-padded to the window length
+            size_t m_windowLength = 0;
+
+            DFTCToC<T> m_dft;
+            vector<T> m_history;    // the last m_windowLength - 1 samples, then the current chunk
+            vector<T> m_product;
+            vector<T> m_branches;
+            vector<T> m_spectrum;
+            size_t m_samples = 0;   // input samples pushed so far
+
+            // Bounds the history buffer; a few hundred outputs per chunk
+            size_t maxChunk() const { return 256 * m_decimation; }
+
+            // Computes all channels for the output whose newest sample ends the window at window[m_windowLength - 1]
+            void output(const T* window)
+            {
+                const size_t M = m_numChannels;
+                const size_t n = (m_samples + (size_t)(window - m_history.data())) / m_decimation;
+
+                // Branch r sums the windowed input at offsets r, r + M, r + 2M, ...
+                math::Mul(m_reversed.data(), window, m_product.data(), (int)m_windowLength);
+                T* branches = m_branches.data();
+                Copy(m_product.data(), branches, M);
+                for (size_t p = M; p < m_windowLength; p += M)
+                    math::Add_I(m_product.data() + p, branches, (int)M);
+
+                // The DFT wants the branches rotated by one, and by a further M / 2 on the odd outputs
+                // when oversampled, which puts in the (-1)^m phase of those outputs
+                size_t shift = 1;
+                if (m_mode == ChannelizerMode::Oversampled && n % 2 == 1)
+                    shift += M / 2;
+                T* rotated = m_product.data(); // free again, and at least M long
+                Copy(branches + (M - shift), rotated, shift);
+                Copy(branches, rotated + shift, M - shift);
+                m_dft.fwd(rotated, m_spectrum.data());
+            }
+        };
+    }
+}
@@ -0,0 +1,283 @@
+/*
+Farrow resampler: conversion by any ratio of output to input rate, including irrational ones and ones
+that drift, for 32f/64f/32fc/64fc streams.
+
+Each output falls at some fractional time n + mu (0 <= mu < 1) on the input, and is taken from the
+Lagrange polynomial of order P through the P + 1 input samples around it, centred on [n, n + 1]. In
+Farrow form that polynomial is
+
+    y = sum_k c_k[n] * mu^k,    c_k[n] = sum_j C[k][j] * x[n - (P - 1) / 2 + j]
+
+so each c_k is a fixed FIR of the input, independent of the ratio. A block of input is run through
+the P + 1 branch filters with AddProductC, the branch outputs at each output's n are gathered, and
+the polynomials are evaluated by Horner's rule with Mul_I and Add_I over the whole block of outputs.
+Complex samples are treated as interleaved real pairs throughout, since the coefficients are real.
+
+The output time advances by 1 / ratio input samples per output, in fixed point with 32 fractional
+bits, so the outputs do not depend on how the input is split across calls. setRatio() changes the
+ratio from the next output on, e.g. to track a measured clock drift.
+
+Order 3 (cubic) is a common choice; higher odd orders are flatter and reject more of the images, up
+to order 9. The interpolator is not an anti-aliasing filter: when the ratio is well below 1, lowpass
+the input first (e.g. FIRSR with taps from generateLowpassTaps).
+
+Example:
+    ipps::filter::FarrowResampler<Ipp32fc> resampler(48000.0 / 44100.0 * (1 + 12e-6));
+    ipps::vector<Ipp32fc> out(resampler.outputsFor(packet.size()));
+    size_t written = resampler.process(packet.data(), packet.size(), out.data());
+*/
+
+#pragma once
+
+#include "ipp.h"
+#include "../../ipp_ext_errors.h"
+#include "../ipp_ext_vec.h"
+#include "../ipp_ext_copy.h"
+#include "../ipp_ext_math.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ipps{
+    namespace filter
+    {
+        namespace detail
+        {
+            // The real type underneath a sample, and how many of them make one sample
+            template <typename T>
+            struct sample_parts;
+
+            template <>
+            struct sample_parts<Ipp32f> { typedef Ipp32f type; static const size_t count = 1; };
+
+            template <>
+            struct sample_parts<Ipp64f> { typedef Ipp64f type; static const size_t count = 1; };
+
+            template <>
+            struct sample_parts<Ipp32fc> { typedef Ipp32f type; static const size_t count = 2; };
+
+            template <>
+            struct sample_parts<Ipp64fc> { typedef Ipp64f type; static const size_t count = 2; };
+        }
+
+        /// @brief Resampler by an arbitrary, adjustable ratio with a Farrow-structure Lagrange interpolator.
+        /// @tparam T Type of the input/output: 32f, 64f, 32fc or 64fc.
+        template <typename T>
+        class FarrowResampler
+        {
+        public:
+            typedef typename detail::sample_parts<T>::type real_type;
+
+            FarrowResampler()
+            {}
+
+            /// @param ratio Output samples per input sample.
+            /// @param order Order P of the interpolating polynomial: odd, from 1 (linear) to 9.
+            FarrowResampler(double ratio, int order = 3)
+                : m_order{order}
+            {
+                if (order < 1 || order > 9 || order % 2 == 0)
+                    throw std::invalid_argument("FarrowResampler: order must be odd and from 1 to 9, not " +
+                        std::to_string(order));
+                setRatio(ratio);
+
+                const size_t P = (size_t)order;
+                const size_t parts = detail::sample_parts<T>::count;
+                m_coefs = coefficients(order);
+                m_buffer.resize(P + maxChunk);
+                m_branches.resize((P + 1) * maxChunk * parts);
+                m_gathered.resize((P + 1) * maxOutputs * parts);
+                m_mu.resize(maxOutputs * parts);
+                reset();
+            }
+
+            /// @brief Resamples len samples, which may be any number.
+            /// @param out Room for at least outputsFor(len) samples.
+            /// @return The number of output samples written.
+            size_t process(const T* in, size_t len, T* out)
+            {
+                if (m_order == 0)
+                    throw std::runtime_error("FarrowResampler: not configured, construct with a ratio first");
+
+                const size_t P = (size_t)m_order;
+                size_t written = 0;
+                while (len > 0)
+                {
+                    size_t chunk = len < maxChunk ? len : maxChunk;
+                    Copy(in, m_buffer.data() + P, chunk);
+
+                    // Only blocks with an output in them need the branch filters
+                    if ((m_time >> fracBits) < chunk)
+                    {
+                        run_branches(chunk);
+                        written += evaluate(chunk, out + written);
+                    }
+
+                    // The last P samples are the start of the next block's stencils
+                    std::copy(m_buffer.data() + chunk, m_buffer.data() + chunk + P, m_buffer.data());
+                    m_time -= (uint64_t)chunk << fracBits;
+                    in += chunk;
+                    len -= chunk;
+                }
+                return written;
+            }
+
+            /// @brief Number of output samples that process() will produce for the next len input samples,
+            /// at the current ratio.
+            size_t outputsFor(size_t len) const
+            {
+                if (m_step == 0)
+                    return 0;
+                uint64_t time = m_time;
+                size_t count = 0;
+                while (len > 0)
+                {
+                    size_t chunk = len < maxChunk ? len : maxChunk;
+                    uint64_t end = (uint64_t)chunk << fracBits;
+                    if (time < end)
+                    {
+                        uint64_t n = (end - 1 - time) / m_step + 1;
+                        count += (size_t)n;
+                        time += n * m_step;
+                    }
+                    time -= end;
+                    len -= chunk;
+                }
+                return count;
+            }
+
+            /// @brief Changes the ratio of output to input samples, from the next output on.
+            void setRatio(double ratio)
+            {
+                if (!(ratio >= 1.0 / maxStepSamples) || !(ratio <= (double)(1ULL << fracBits)))
+                    throw std::invalid_argument("FarrowResampler: ratio must be from 1/" + std::to_string(maxStepSamples) +
+                        " to 2^" + std::to_string(fracBits) + ", not " + std::to_string(ratio));
+                m_ratio = ratio;
+                m_step = (uint64_t)std::llround((double)(1ULL << fracBits) / ratio);
+            }
+
+            /// @brief Clears the input history to zeros and restarts the output time.
+            void reset()
+            {
+                m_buffer.zero();
+                m_time = 0;
+            }
+
+            double getRatio() const { return m_ratio; }
+            int getOrder() const { return m_order; }
+            /// @brief Output k is the input at time k / ratio - getDelay(), in input samples, i.e. (P + 1) / 2.
+            size_t getDelay() const { return (size_t)(m_order + 1) / 2; }
+            /// @brief C[k][j], the weight of stencil sample j in the coefficient of mu^k.
+            const std::vector<std::vector<double>>& getCoefficients() const { return m_coefs; }
+
+            /// @brief The Farrow coefficients of the order-P Lagrange interpolator, on the stencil
+            /// -(P - 1) / 2, ..., (P + 1) / 2 and evaluated at mu in [0, 1).
+            static std::vector<std::vector<double>> coefficients(int order)
+            {
+                const int P = order;
+                const int h = (P - 1) / 2;
+                std::vector<std::vector<double>> coefs((size_t)P + 1, std::vector<double>((size_t)P + 1, 0.0));
+                for (int j = 0; j <= P; j++)
+                {
+                    // L_j(mu) = prod_{m != j} (mu - d_m) / (d_j - d_m), expanded in powers of mu
+                    std::vector<double> poly(1, 1.0);
+                    for (int m = 0; m <= P; m++)
+                    {
+                        if (m == j)
+                            continue;
+                        double dm = (double)(m - h);
+                        double scale = 1.0 / (double)(j - m);
+                        std::vector<double> next(poly.size() + 1, 0.0);
+                        for (size_t k = 0; k < poly.size(); k++)
+                        {
+                            next[k + 1] += poly[k] * scale;
+                            next[k] -= poly[k] * dm * scale;
+                        }
+                        poly.swap(next);
+                    }
+                    for (int k = 0; k <= P; k++)
+                        coefs[(size_t)k][(size_t)j] = poly[(size_t)k];
+                }
+                return coefs;
+            }
+
+        private:
+            // Input samples per block, and outputs per Horner pass
+            static const size_t maxChunk = 4096;
+            static const size_t maxOutputs = 1024;
+            // Fixed point output time, in input samples
+            static const int fracBits = 32;
+            static const uint64_t maxStepSamples = 1ULL << 20;
+
+            int m_order = 0;
+            double m_ratio = 1.0;
+            uint64_t m_step = 0; // input samples per output, in fixed point
+            uint64_t m_time = 0; // stencil start of the next output in m_buffer, in fixed point
+            std::vector<std::vector<double>> m_coefs;
+
+            vector<T> m_buffer;             // the last P samples, then the current block
+            vector<real_type> m_branches;   // c_k for every stencil start in the block, one row per k
+            vector<real_type> m_gathered;   // c_k at each output's stencil start, one row per k
+            vector<real_type> m_mu;         // mu for each output, repeated for each part of a sample
+
+            void run_branches(size_t chunk)
+            {
+                const size_t P = (size_t)m_order;
+                const size_t parts = detail::sample_parts<T>::count;
+                const int len = (int)(chunk * parts);
+                const real_type* samples = reinterpret_cast<const real_type*>(m_buffer.data());
+                for (size_t k = 0; k <= P; k++)
+                {
+                    real_type* branch = m_branches.data() + k * maxChunk * parts;
+                    m_branches.zero((int)(k * maxChunk * parts), len);
+                    for (size_t j = 0; j <= P; j++)
+                    {
+                        if (m_coefs[k][j] != 0.0)
+                            math::AddProductC(samples + j * parts, (real_type)m_coefs[k][j], branch, len);
+                    }
+                }
+            }
+
+            // Writes every output whose stencil starts in the block, and returns how many
+            size_t evaluate(size_t chunk, T* out)
+            {
+                const size_t P = (size_t)m_order;
+                const size_t parts = detail::sample_parts<T>::count;
+                const uint64_t end = (uint64_t)chunk << fracBits;
+                const uint64_t fracMask = (1ULL << fracBits) - 1;
+                const double fracScale = 1.0 / (double)(1ULL << fracBits);
+                size_t written = 0;
+                while (m_time < end)
+                {
+                    size_t n = 0;
+                    for (; n < maxOutputs && m_time < end; n++, m_time += m_step)
+                    {
+                        size_t s = (size_t)(m_time >> fracBits);
+                        real_type mu = (real_type)((double)(m_time & fracMask) * fracScale);
+                        for (size_t p = 0; p < parts; p++)
+                        {
+                            m_mu[n * parts + p] = mu;
+                            for (size_t k = 0; k <= P; k++)
+                                m_gathered[k * maxOutputs * parts + n * parts + p] = m_branches[k * maxChunk * parts + s * parts + p];
+                        }
+                    }
+
+                    // Horner's rule over the whole batch, straight into the output
+                    const int len = (int)(n * parts);
+                    real_type* acc = reinterpret_cast<real_type*>(out + written);
+                    Copy(m_gathered.data() + P * maxOutputs * parts, acc, len);
+                    for (size_t k = P; k-- > 0;)
+                    {
+                        math::Mul_I(m_mu.data(), acc, len);
+                        math::Add_I(m_gathered.data() + k * maxOutputs * parts, acc, len);
+                    }
+                    written += n;
+                }
+                return written;
+            }
+        };
+    }
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "ipp.h"
+#include "../../ipp_ext_errors.h"
+#include "../ipp_ext_vec.h"
+#include "../ipp_ext_copy.h"
+#include "../ipp_ext_math.h"
+#include "../ipp_ext_dft.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace ipps{
+    namespace filter
+    {
+        /// @brief Single-rate FIR filter using overlap-save fast convolution, for long filters.
+        /// Produces the same output as FIRSR (out[i] = sum_k taps[k] * in[i-k]), with the last
+        /// numTaps-1 inputs carried across calls in the same way as FIRSR's delay.
+        /// @tparam T Type of the taps and the input/output, 32fc or 64fc.
+        template <typename T>
+        class OverlapSave
+        {
+        public:
+            OverlapSave()
+            {}
+
+            /// @param taps Filter taps.
+            /// @param fftLength DFT length used per block; must be at least taps.size().
+            /// 0 picks the power of 2 that minimises the work per output sample.
+            /// Larger values are more efficient for long inputs, smaller ones reduce the latency of each block.
+            OverlapSave(const vector<T>& taps, size_t fftLength = 0)
+                : m_taps{taps}
+            {
+                prepare(fftLength);
+            }
+
+            OverlapSave(vector<T>&& taps, size_t fftLength = 0)
+                : m_taps{std::move(taps)}
+            {
+                prepare(fftLength);
+            }
+
+            /// @brief Filters len samples. Any length is accepted; partial blocks are zero-padded,
+            /// so the output is never delayed. in and out may be the same.
+            void filter(const T* in, T* out, size_t len)
+            {
+                if (m_taps.size() == 0)
+                    throw std::runtime_error("OverlapSave: no taps, construct with taps first");
+
+                const size_t hist = m_dly.size();
+                const size_t block = getBlockLength();
+                while (len > 0)
+                {
+                    size_t count = std::min(block, len);
+
+                    // [history, new samples, zeros]
+                    if (hist > 0)
+                        Copy(m_dly.data(), m_block.data(), hist);
+                    Copy(in, m_block.data() + hist, count);
+                    if (hist + count < m_block.size())
+                        m_block.zero((int)(hist + count), (int)(m_block.size() - hist - count));
+
+                    m_dft.fwd(m_block.data(), m_freq.data());
+
+                    // The last hist inputs become the next history
+                    if (hist > 0)
+                        Copy(m_block.data() + count, m_dly.data(), hist);
+
+                    math::Mul(m_freq.data(), m_response.data(), m_freq.data(), m_freq.size());
+                    m_dft.bwd(m_freq.data(), m_block.data());
+
+                    // Only the outputs past the history are free of wrap-around
+                    Copy(m_block.data() + hist, out, count);
+
+                    in += count;
+                    out += count;
+                    len -= count;
+                }
+            }
+
+            // Accessors for the delay vector, as in FIRSR
+
+            void reset(){ if (m_dly.size() > 0) m_dly.zero(); }
+            void setDelay(const T* dly)
+            {
+                Copy(dly, m_dly.data(), m_dly.size());
+            }
+            const vector<T>& getDelayVector() { return m_dly; }
+            const T* getDelay() { return m_dly.data(); }
+
+            const vector<T>& getTaps() { return m_taps; }
+
+            /// @brief DFT length used for each block.
+            size_t getFFTLength() const { return m_freq.size(); }
+            /// @brief Maximum number of outputs produced by each block.
+            size_t getBlockLength() const { return m_freq.size() - m_dly.size(); }
+
+            /// @brief The power of 2 that minimises the DFT work per output sample for the given number of taps.
+            /// Always at least the number of taps.
+            static size_t chooseFFTLength(size_t numTaps)
+            {
+                size_t best = 0;
+                double bestCost = 0;
+                size_t n = 1;
+                while (n < numTaps)
+                    n <<= 1;
+                // Search up to 2^24, or further for longer filters, so that there is always a candidate
+                const size_t limit = std::max((size_t)1 << 24, 2 * n);
+                for (; n <= limit; n <<= 1)
+                {
+                    // Forward and inverse transforms plus the multiply, spread over the new outputs
+                    double cost = (2.0 * n * std::log2((double)n) + n) / (double)(n - numTaps + 1);
+                    if (best == 0 || cost < bestCost)
+                    {
+                        best = n;
+                        bestCost = cost;
+                    }
+                }
+                return best;
+            }
+
+        private:
+            vector<T> m_taps;
+            vector<T> m_dly; // last taps.size()-1 inputs
+            vector<T> m_response; // DFT of the zero-padded taps
+            vector<T> m_block;
+            vector<T> m_freq;
+            DFTCToC<T> m_dft;
+
+            void prepare(size_t fftLength)
+            {
+                if (m_taps.size() == 0)
+                    throw std::invalid_argument("OverlapSave: taps cannot be empty");
+                if (fftLength == 0)
+                    fftLength = chooseFFTLength(m_taps.size());
+                if (fftLength < m_taps.size())
+                    throw std::invalid_argument("OverlapSave: FFT length " + std::to_string(fftLength) +
+                        " must be at least the number of taps " + std::to_string(m_taps.size()));
+
+                m_dft = DFTCToC<T>(DFTCToCPlan<T>::cached(fftLength));
+                m_dly.resize(m_taps.size() - 1);
+                m_block.resize(fftLength);
+                m_freq.resize(fftLength);
+                m_response.resize(fftLength);
+                reset();
+
+                // Precompute the frequency response once
+                m_block.zero();
+                Copy(m_taps.data(), m_block.data(), m_taps.size());
+                m_dft.fwd(m_block.data(), m_response.data());
+            }
+        };
+    }
+}
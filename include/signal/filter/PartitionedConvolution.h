@@ -0,0 +1,199 @@
+#pragma once
+
+#include "ipp.h"
+#include "../../ipp_ext_errors.h"
+#include "../ipp_ext_vec.h"
+#include "../ipp_ext_copy.h"
+#include "../ipp_ext_math.h"
+#include "../ipp_ext_dft.h"
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace ipps{
+    namespace filter
+    {
+        /// @brief Frequency responses of a filter split into equal partitions, for PartitionedConvolution.
+        /// Immutable once built, so one instance can be shared by any number of channels (and threads).
+        /// @tparam T Type of the taps, 32fc or 64fc.
+        template <typename T>
+        class PartitionedResponse
+        {
+        public:
+            /// @param taps Filter taps, of any length.
+            /// @param blockLength Samples per partition; each uses a DFT of twice this length.
+            PartitionedResponse(const vector<T>& taps, size_t blockLength)
+                : m_numTaps{taps.size()}, m_blockLength{blockLength}
+            {
+                if (taps.size() == 0)
+                    throw std::invalid_argument("PartitionedResponse: taps cannot be empty");
+                if (blockLength == 0)
+                    throw std::invalid_argument("PartitionedResponse: block length cannot be 0");
+
+                m_plan = DFTCToCPlan<T>::cached(2 * blockLength);
+                m_numPartitions = (taps.size() + blockLength - 1) / blockLength;
+                m_spectra.resize(m_numPartitions * 2 * blockLength);
+
+                // Each partition is zero-padded to the DFT length and transformed once
+                DFTCToC<T> dft(m_plan);
+                vector<T> padded(2 * blockLength);
+                for (size_t p = 0; p < m_numPartitions; p++)
+                {
+                    size_t count = std::min(blockLength, taps.size() - p * blockLength);
+                    padded.zero();
+                    Copy(taps.data() + p * blockLength, padded.data(), count);
+                    dft.fwd(padded.data(), partition(p));
+                }
+            }
+
+            size_t getNumTaps() const { return m_numTaps; }
+            size_t getBlockLength() const { return m_blockLength; }
+            size_t getNumPartitions() const { return m_numPartitions; }
+            const std::shared_ptr<const DFTCToCPlan<T>>& getPlan() const { return m_plan; }
+
+            /// @brief Spectrum of partition p, of length 2 * getBlockLength().
+            const T* partition(size_t p) const { return m_spectra.data() + p * 2 * m_blockLength; }
+
+        private:
+            size_t m_numTaps;
+            size_t m_blockLength;
+            size_t m_numPartitions;
+            std::shared_ptr<const DFTCToCPlan<T>> m_plan;
+            vector<T> m_spectra; // partitions back to back
+
+            T* partition(size_t p) { return m_spectra.data() + p * 2 * m_blockLength; }
+        };
+
+        /// @brief Single-rate FIR filter using uniformly partitioned overlap-save convolution.
+        /// Unlike OverlapSave, the DFT length depends only on the block length and not on the filter length,
+        /// so very long filters can run with short blocks. Produces the same output as FIRSR, with no added delay.
+        /// @tparam T Type of the taps and the input/output, 32fc or 64fc.
+        template <typename T>
+        class PartitionedConvolution
+        {
+        public:
+            PartitionedConvolution()
+            {}
+
+            /// @brief Uses (and shares) an existing response, e.g. one per filter across many channels.
+            explicit PartitionedConvolution(std::shared_ptr<const PartitionedResponse<T>> response)
+                : m_response{std::move(response)}
+            {
+                if (!m_response)
+                    throw std::invalid_argument("PartitionedConvolution: response cannot be null");
+                prepare();
+            }
+
+            PartitionedConvolution(const vector<T>& taps, size_t blockLength)
+                : PartitionedConvolution(std::make_shared<const PartitionedResponse<T>>(taps, blockLength))
+            {}
+
+            /// @brief Filters len samples. Any length is accepted; outputs are available as soon as their
+            /// inputs are, at the cost of an extra DFT pair for each call that ends mid-block. in and out may be the same.
+            void filter(const T* in, T* out, size_t len)
+            {
+                if (!m_response)
+                    throw std::runtime_error("PartitionedConvolution: no response, construct with taps first");
+
+                const size_t block = m_response->getBlockLength();
+                const size_t fftLength = 2 * block;
+                while (len > 0)
+                {
+                    size_t count = std::min(block - m_fill, len);
+                    Copy(in, m_input.data() + block + m_fill, count);
+
+                    // The older partitions don't change until the block is complete, so sum them once per block
+                    if (!m_tailValid)
+                        accumulate_tail();
+
+                    // [previous block, current block so far, zeros]
+                    m_dft.fwd(m_input.data(), current_slot());
+                    Copy(m_tail.data(), m_acc.data(), fftLength);
+                    math::AddProduct(current_slot(), m_response->partition(0), m_acc.data(), fftLength);
+                    m_dft.bwd(m_acc.data(), m_acc.data());
+                    Copy(m_acc.data() + block + m_fill, out, count);
+
+                    m_fill += count;
+                    in += count;
+                    out += count;
+                    len -= count;
+
+                    if (m_fill == block)
+                        next_block();
+                }
+            }
+
+            /// @brief Clears the input history, as if no samples had been filtered yet.
+            void reset()
+            {
+                m_input.zero();
+                m_delayLine.zero();
+                m_fill = 0;
+                m_head = 0;
+                m_tailValid = false;
+            }
+
+            size_t getBlockLength() const { return m_response ? m_response->getBlockLength() : 0; }
+            size_t getNumPartitions() const { return m_response ? m_response->getNumPartitions() : 0; }
+            const std::shared_ptr<const PartitionedResponse<T>>& getResponse() const { return m_response; }
+
+        private:
+            std::shared_ptr<const PartitionedResponse<T>> m_response;
+            DFTCToC<T> m_dft;
+            vector<T> m_input;     // previous and current input blocks
+            vector<T> m_delayLine; // spectra of the last getNumPartitions() blocks, as a ring
+            vector<T> m_tail;      // sum of the products of all but the newest block
+            vector<T> m_acc;
+            size_t m_fill = 0;     // samples so far in the current block
+            size_t m_head = 0;     // delay line slot of the current block
+            bool m_tailValid = false;
+
+            void prepare()
+            {
+                const size_t fftLength = 2 * m_response->getBlockLength();
+                m_dft = DFTCToC<T>(m_response->getPlan());
+                m_input.resize(fftLength);
+                m_delayLine.resize(m_response->getNumPartitions() * fftLength);
+                m_tail.resize(fftLength);
+                m_acc.resize(fftLength);
+                reset();
+            }
+
+            T* slot(size_t s)
+            {
+                return m_delayLine.data() + s * 2 * m_response->getBlockLength();
+            }
+
+            T* current_slot()
+            {
+                return slot(m_head);
+            }
+
+            void accumulate_tail()
+            {
+                const size_t fftLength = 2 * m_response->getBlockLength();
+                const size_t numPartitions = m_response->getNumPartitions();
+                m_tail.zero();
+                for (size_t p = 1; p < numPartitions; p++)
+                {
+                    // Block k-p sits p slots behind the current one
+                    size_t s = (m_head + numPartitions - p) % numPartitions;
+                    math::AddProduct(slot(s), m_response->partition(p), m_tail.data(), fftLength);
+                }
+                m_tailValid = true;
+            }
+
+            void next_block()
+            {
+                // The current slot already holds the complete block's spectrum; just move on from it
+                const size_t block = m_response->getBlockLength();
+                m_head = (m_head + 1) % m_response->getNumPartitions();
+                Copy(m_input.data() + block, m_input.data(), block);
+                m_input.zero((int)block, (int)block);
+                m_fill = 0;
+                m_tailValid = false;
+            }
+        };
+    }
+}
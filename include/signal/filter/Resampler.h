@@ -0,0 +1,180 @@
+#pragma once
+
+#include "ipp.h"
+#include "../../ipp_ext_errors.h"
+#include "../ipp_ext_vec.h"
+#include "../ipp_ext_copy.h"
+#include "../ipp_ext_math.h"
+#include "FIRGen.h"
+#include "FIRMR.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace ipps{
+    namespace filter
+    {
+        namespace detail
+        {
+            // A real constant as a tap value, for real or complex taps
+            template <typename T>
+            inline T real_constant(double v) { return (T)v; }
+
+            template <>
+            inline Ipp32fc real_constant<Ipp32fc>(double v) { Ipp32fc c = {(Ipp32f)v, 0}; return c; }
+
+            template <>
+            inline Ipp64fc real_constant<Ipp64fc>(double v) { Ipp64fc c = {v, 0}; return c; }
+        }
+
+        /// @brief Streaming rational resampler by up/down on top of FIRMR, for input in chunks of any size.
+        /// FIRMR itself only consumes whole multiples of the down factor; the remainder of each chunk is kept
+        /// here until the next call, so the output is the same as one FIRMR call on the whole stream.
+        /// Nothing is allocated after construction.
+        /// @tparam T Type of the taps and the input/output: 32f, 64f, 32fc or 64fc.
+        template <typename T>
+        class Resampler
+        {
+        public:
+            Resampler()
+            {}
+
+            /// @brief Designs the taps from the factors with defaultTaps().
+            /// @param up Interpolation factor.
+            /// @param down Decimation factor. up/down is reduced to lowest terms first.
+            /// @param zeroCrossings Zero crossings of the sinc on each side of its centre; more gives a sharper filter.
+            /// @param winType Window for the design.
+            Resampler(int up, int down, int zeroCrossings = 10, IppWinType winType = ippWinHamming)
+                : Resampler(defaultTaps(up, down, zeroCrossings, winType), up, down)
+            {}
+
+            /// @param taps Filter at the upsampled rate, used as given; its passband gain should be the (reduced) up factor.
+            /// @param up Interpolation factor.
+            /// @param down Decimation factor. up/down is reduced to lowest terms first.
+            Resampler(const vector<T>& taps, int up, int down)
+            {
+                if (up < 1 || down < 1)
+                    throw std::invalid_argument("Resampler: factors must be at least 1, not " +
+                        std::to_string(up) + "/" + std::to_string(down));
+                if (taps.size() == 0)
+                    throw std::invalid_argument("Resampler: taps cannot be empty");
+
+                int g = gcd(up, down);
+                m_up = up / g;
+                m_down = down / g;
+                m_fir = FIRMR<T, T>(vector<T>(taps), m_up, 0, m_down, 0);
+                m_pending.resize((size_t)m_down);
+                m_fill = 0;
+            }
+
+            /// @brief Resamples len samples, which may be any number.
+            /// @param out Room for at least outputsFor(len) samples.
+            /// @return The number of output samples written.
+            size_t process(const T* in, size_t len, T* out)
+            {
+                if (m_up == 0)
+                    throw std::runtime_error("Resampler: not configured, construct with the factors first");
+
+                const size_t up = (size_t)m_up;
+                const size_t down = (size_t)m_down;
+                size_t written = 0;
+
+                // Complete the samples left over from the last call first
+                if (m_fill > 0)
+                {
+                    size_t take = std::min(len, down - m_fill);
+                    Copy(in, m_pending.data() + m_fill, take);
+                    m_fill += take;
+                    in += take;
+                    len -= take;
+                    if (m_fill < down)
+                        return 0;
+                    m_fir.filter(m_pending.data(), out, (int)down, (int)up);
+                    written += up;
+                    m_fill = 0;
+                }
+
+                // Then every whole multiple of the down factor straight from the input, in int-sized pieces
+                const size_t maxIters = (size_t)std::numeric_limits<int>::max() / std::max(up, down);
+                size_t iters = len / down;
+                while (iters > 0)
+                {
+                    size_t n = std::min(iters, maxIters);
+                    m_fir.filter(in, out + written, (int)(n * down), (int)(n * up));
+                    in += n * down;
+                    len -= n * down;
+                    written += n * up;
+                    iters -= n;
+                }
+
+                // And keep the rest for the next call
+                if (len > 0)
+                {
+                    Copy(in, m_pending.data(), len);
+                    m_fill = len;
+                }
+                return written;
+            }
+
+            /// @brief Number of output samples that process() will produce for the next len input samples.
+            size_t outputsFor(size_t len) const
+            {
+                return m_down == 0 ? 0 : (m_fill + len) / (size_t)m_down * (size_t)m_up;
+            }
+
+            /// @brief Clears the filter's delay line and any buffered input.
+            void reset()
+            {
+                m_fir.reset();
+                m_fill = 0;
+            }
+
+            int getUpFactor() const { return m_up; }
+            int getDownFactor() const { return m_down; }
+            const vector<T>& getTaps() { return m_fir.getTaps(); }
+            /// @brief Input samples held over until the next call, always fewer than the down factor.
+            size_t getBufferedCount() const { return m_fill; }
+
+            /// @brief A lowpass at the upsampled rate, cut off at the lower of the two Nyquist frequencies, with a passband
+            /// gain of up (after reducing up/down). It has 2 * zeroCrossings * max(up, down) + 1 taps, so its delay is
+            /// zeroCrossings * max(up, down) samples at the upsampled rate.
+            static vector<T> defaultTaps(int up, int down, int zeroCrossings = 10, IppWinType winType = ippWinHamming)
+            {
+                if (up < 1 || down < 1)
+                    throw std::invalid_argument("Resampler: factors must be at least 1, not " +
+                        std::to_string(up) + "/" + std::to_string(down));
+                if (zeroCrossings < 1)
+                    throw std::invalid_argument("Resampler: need at least 1 zero crossing");
+                int g = gcd(up, down);
+                up /= g;
+                down /= g;
+
+                int widest = std::max(up, down);
+                // FIRGenLowpass needs at least 5 taps
+                int numTaps = std::max(2 * zeroCrossings * widest + 1, 5);
+                vector<T> taps = generateLowpassTaps<T>(0.5 / (double)widest, numTaps, winType, ippTrue);
+                math::MulC_I(detail::real_constant<T>((double)up), taps.data(), (int)taps.size());
+                return taps;
+            }
+
+        private:
+            int m_up = 0;
+            int m_down = 0;
+            FIRMR<T, T> m_fir;
+            vector<T> m_pending; // input left over from the last call, fewer than m_down samples
+            size_t m_fill = 0;
+
+            static int gcd(int a, int b)
+            {
+                while (b != 0)
+                {
+                    int t = a % b;
+                    a = b;
+                    b = t;
+                }
+                return a;
+            }
+        };
+    }
+}
@@ -0,0 +1,191 @@
+/*
+Polyphase synthesis filterbank (inverse channelizer), recombining M channels into one complex stream.
+
+The input is M channels at the decimated rate, such as the rows written by a PolyphaseChannelizer, with
+channel m centred on m / M cycles per sample of the output. Each channel is interpolated by D with the
+prototype taps g and shifted up to its centre, and the channels are summed:
+
+    x[k] = sum_m exp(2 pi i m k / M) * sum_n y_m[n] * g[k - nD]
+
+For each input instant, a single unnormalised DFTCToC::bwd over the M channels gives one period of the
+polyphase interpolation input for all channels together; it is tiled across the taps, weighted by g and
+overlap-added into the output, which then has D more finished samples. The overlap is kept between calls.
+
+Paired with a PolyphaseChannelizer in the 2x oversampled mode, a synthesis prototype that is flat over
+the analysis passband and cut off before the first image (defaultTaps() does this) gives near-perfect
+reconstruction, delayed by the two filters' group delays. The analysis prototype should then be a
+Nyquist(M) lowpass, i.e. one with its centre tap on a multiple of M, such as an odd M * P + 1 tap
+windowed sinc with P even. Critical sampling has no room for such a prototype, so there the aliasing
+between neighbouring channels is only as small as the prototypes' stopbands.
+
+Example:
+    ipps::filter::PolyphaseSynthesizer<Ipp32fc> synthesizer(256, 16, ipps::filter::ChannelizerMode::Oversampled);
+    ipps::vector<Ipp32fc> wideband(channels.columns() * synthesizer.getInterpolation());
+    synthesizer.process(channels, wideband.data());
+*/
+
+#pragma once
+
+#include "ipp.h"
+#include "../../ipp_ext_errors.h"
+#include "../ipp_ext_vec.h"
+#include "../ipp_ext_copy.h"
+#include "../ipp_ext_math.h"
+#include "../ipp_ext_matrix.h"
+#include "../ipp_ext_dft.h"
+#include "FIRGen.h"
+#include "Channelizer.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace ipps{
+    namespace filter
+    {
+        /// @brief Polyphase synthesis filterbank: one complex stream from M channels, for 32fc/64fc.
+        /// @tparam T Type of the taps and the input/output.
+        template <typename T>
+        class PolyphaseSynthesizer
+        {
+        public:
+            PolyphaseSynthesizer()
+            {}
+
+            /// @brief Uses defaultTaps() for the mode.
+            /// @param numChannels M.
+            /// @param tapsPerChannel The prototype has M times this many taps, plus one.
+            /// @param mode Critically sampled (interpolation by M) or 2x oversampled (by M / 2) channels.
+            /// @param winType Window for the prototype design.
+            PolyphaseSynthesizer(size_t numChannels, size_t tapsPerChannel,
+                                 ChannelizerMode mode = ChannelizerMode::Critical, IppWinType winType = ippWinHamming)
+                : PolyphaseSynthesizer(defaultTaps(numChannels, tapsPerChannel, mode, winType), numChannels, mode)
+            {}
+
+            /// @param taps Interpolation prototype, of any length, used as given; its passband gain should be
+            /// the interpolation factor, to make up for the zeros inserted between the channel samples.
+            /// @param numChannels M.
+            /// @param mode Critically sampled (interpolation by M) or 2x oversampled (by M / 2) channels.
+            PolyphaseSynthesizer(const vector<T>& taps, size_t numChannels, ChannelizerMode mode = ChannelizerMode::Critical)
+                : m_numChannels{numChannels}, m_mode{mode}
+            {
+                if (numChannels < 2)
+                    throw std::invalid_argument("PolyphaseSynthesizer: need at least 2 channels");
+                if (taps.size() == 0)
+                    throw std::invalid_argument("PolyphaseSynthesizer: taps cannot be empty");
+                if (mode == ChannelizerMode::Oversampled && numChannels % 2 != 0)
+                    throw std::invalid_argument("PolyphaseSynthesizer: oversampling needs an even number of channels, not " +
+                        std::to_string(numChannels));
+
+                m_interpolation = mode == ChannelizerMode::Critical ? numChannels : numChannels / 2;
+                m_taps = taps;
+
+                // Unnormalised, so that the sum over the channels is not scaled down
+                m_dft = DFTCToC<T>(numChannels, IPP_FFT_NODIV_BY_ANY);
+                m_column.resize(numChannels);
+                m_periodic.resize(numChannels);
+
+                // Long enough for the taps, plus the D samples finished by each instant
+                size_t blocks = (taps.size() + m_interpolation - 1) / m_interpolation;
+                m_overlap.resize((blocks + 1) * m_interpolation);
+                m_tiled.resize(taps.size());
+                reset();
+            }
+
+            /// @brief Synthesizes count instants of every channel into count * getInterpolation() output samples.
+            /// @param in Channel m starts at in + m * inStride, one sample per instant.
+            size_t process(const T* in, size_t inStride, size_t count, T* out)
+            {
+                if (m_numChannels == 0)
+                    throw std::runtime_error("PolyphaseSynthesizer: not configured, construct with taps first");
+                if (count > 0 && inStride < count)
+                    throw std::invalid_argument("PolyphaseSynthesizer: input row stride must be at least the number of instants");
+
+                const size_t M = m_numChannels;
+                const size_t D = m_interpolation;
+                const size_t numTaps = m_taps.size();
+                for (size_t n = 0; n < count; n++)
+                {
+                    for (size_t m = 0; m < M; m++)
+                        m_column[m] = in[m * inStride + n];
+                    m_dft.bwd(m_column.data(), m_periodic.data());
+
+                    // exp(2 pi i m nD / M) is (-1)^m on odd instants when oversampled, i.e. half a period of rotation
+                    size_t offset = 0;
+                    if (m_mode == ChannelizerMode::Oversampled && m_instants % 2 == 1)
+                        offset = M / 2;
+                    for (size_t start = 0; start < numTaps; start += M)
+                    {
+                        size_t len = std::min(M, numTaps - start);
+                        size_t head = std::min(len, M - offset);
+                        Copy(m_periodic.data() + offset, m_tiled.data() + start, head);
+                        if (head < len)
+                            Copy(m_periodic.data(), m_tiled.data() + start + head, len - head);
+                    }
+                    math::AddProduct(m_taps.data(), m_tiled.data(), m_overlap.data(), (int)numTaps);
+
+                    // Later instants start D samples further on, so the first D are now final
+                    Copy(m_overlap.data(), out + n * D, D);
+                    std::copy(m_overlap.data() + D, m_overlap.data() + m_overlap.size(), m_overlap.data());
+                    m_overlap.zero((int)(m_overlap.size() - D), (int)D);
+                    m_instants++;
+                }
+                return count * D;
+            }
+
+            /// @brief process() on every column of a matrix with one row per channel.
+            size_t process(const matrix<T>& channels, T* out)
+            {
+                if (channels.rows() != m_numChannels)
+                    throw std::invalid_argument("PolyphaseSynthesizer: matrix has " + std::to_string(channels.rows()) +
+                        " rows, expected one per channel (" + std::to_string(m_numChannels) + ")");
+                return process(channels.data(), channels.columns(), channels.columns(), out);
+            }
+
+            /// @brief Clears the overlap, as if no instants had been synthesized.
+            void reset()
+            {
+                m_overlap.zero();
+                m_instants = 0;
+            }
+
+            size_t getNumChannels() const { return m_numChannels; }
+            /// @brief D, the output samples per input instant.
+            size_t getInterpolation() const { return m_interpolation; }
+            ChannelizerMode getMode() const { return m_mode; }
+            const vector<T>& getTaps() const { return m_taps; }
+            /// @brief Total instants synthesized since construction or the last reset().
+            size_t getInstantCount() const { return m_instants; }
+
+            /// @brief The default prototype: M * tapsPerChannel + 1 taps, so that its delay is a whole number of samples,
+            /// with a passband gain of D. Critically sampled, it is cut off at half the channel spacing; oversampled, at
+            /// the full spacing, so that it stays flat across an analysis channel and its transition band while still
+            /// rejecting the images at 2 / M.
+            static vector<T> defaultTaps(size_t numChannels, size_t tapsPerChannel,
+                                         ChannelizerMode mode = ChannelizerMode::Critical, IppWinType winType = ippWinHamming)
+            {
+                if (numChannels < 2 || tapsPerChannel == 0)
+                    throw std::invalid_argument("PolyphaseSynthesizer: need at least 2 channels and 1 tap per channel");
+                bool critical = mode == ChannelizerMode::Critical;
+                double cutoff = (critical ? 0.5 : 1.0) / (double)numChannels;
+                vector<T> taps = generateLowpassTaps<T>(cutoff, (int)(numChannels * tapsPerChannel + 1), winType, ippTrue);
+                T gain{};
+                gain.re = (decltype(gain.re))(critical ? numChannels : numChannels / 2);
+                math::MulC_I(gain, taps.data(), (int)taps.size());
+                return taps;
+            }
+
+        private:
+            size_t m_numChannels = 0;
+            size_t m_interpolation = 0;
+            ChannelizerMode m_mode = ChannelizerMode::Critical;
+            vector<T> m_taps;
+
+            DFTCToC<T> m_dft;
+            vector<T> m_column;   // one instant across the channels
+            vector<T> m_periodic; // its bwd DFT, one period of the polyphase input
+            vector<T> m_tiled;    // the period repeated across the taps
+            vector<T> m_overlap;  // output samples still receiving contributions
+            size_t m_instants = 0;
+        };
+    }
+}
@@ -0,0 +1,301 @@
+/*
+Cross-ambiguity function (range-Doppler surface) of a segment against a reference, for 32fc/64fc.
+
+For each Doppler hypothesis f (in cycles per sample) and each lag k, the surface holds
+
+    CAF[f][k] = sum_n s[n + k] * exp(-2 pi i f (n + k)) * conj(r[n])
+
+i.e. the cross-correlation (see ipp_ext_xcorr.h) of the segment with the Doppler f removed, against
+the reference. Each row is scaled as magnitude, power or dB (see STFTScale).
+
+Dopplers that are whole multiples of the DFT bin spacing (1 / getFFTLength()) need no tone at all:
+removing them is a circular rotation of the segment's spectrum, so the segment is transformed once
+per call and each such row costs a Mul and a backward DFT. Other Dopplers use a tone table computed
+at construction and cost an extra forward DFT. Rows are spread over the thread pool.
+
+Each row holds getNumLags() = M + L - 1 values, for lags -(M-1) to L-1 (M, L the reference and segment
+lengths), so column c is lag c - (M-1). computePeaks() keeps only the peak of each row instead.
+
+Example:
+    std::vector<double> dopplers;
+    for (int k = -50; k <= 50; k++)
+        dopplers.push_back(k / 4096.0);
+    ipps::CAF<Ipp32fc> caf(reference, 3000, dopplers, 4096);
+    ippi::image<Ipp32f, ippi::channels::C1> surface(caf.getNumLags(), dopplers.size());
+    caf.compute(segment.data(), surface);
+*/
+
+#pragma once
+
+#include "ipp.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ipp_ext_vec.h"
+#include "ipp_ext_copy.h"
+#include "ipp_ext_math.h"
+#include "ipp_ext_convert.h"
+#include "ipp_ext_stats.h"
+#include "ipp_ext_generator.h"
+#include "ipp_ext_dft.h"
+#include "ipp_ext_parallel.h"
+#include "ipp_ext_stft.h"
+#include "ipp_ext_xcorr.h"
+#include "../image/image.h"
+#include "../ipp_ext_errors.h"
+
+namespace ipps
+{
+    namespace detail
+    {
+        // Tones are generated in double precision and stored at the working precision
+        inline void store_tone(const Ipp64fc* src, Ipp64fc* dst, int len)
+        {
+            Copy(src, dst, len);
+        }
+
+        inline void store_tone(const Ipp64fc* src, Ipp32fc* dst, int len)
+        {
+            convert::Convert(reinterpret_cast<const Ipp64f*>(src), reinterpret_cast<Ipp32f*>(dst), 2 * len);
+        }
+    }
+
+    /// @brief Cross-ambiguity surface engine for a fixed reference, segment length and set of Dopplers, for 32fc/64fc.
+    template <typename T>
+    class CAF
+    {
+    public:
+        typedef typename detail::complex_real<T>::type real_type;
+
+        CAF()
+        {}
+
+        /// @param reference The reference waveform.
+        /// @param segmentLength Length of every segment.
+        /// @param dopplers Doppler hypotheses in cycles per sample, one per output row.
+        /// @param fftLength DFT length, at least reference.size() + segmentLength - 1. 0 picks the smallest power of 2.
+        /// Dopplers on multiples of 1 / fftLength are the cheapest.
+        /// @param scale What each output value holds.
+        CAF(const vector<T>& reference, size_t segmentLength, const std::vector<double>& dopplers,
+            size_t fftLength = 0, STFTScale scale = STFTScale::Magnitude)
+            : m_xc{reference, segmentLength, fftLength}, m_dopplers{dopplers}, m_scale{scale}
+        {
+            if (dopplers.size() == 0)
+                throw std::invalid_argument("CAF: at least one Doppler is required");
+
+            const size_t n = m_xc.getFFTLength();
+            m_plan = DFTCToCPlan<T>::cached(n);
+
+            // Whole bins become rotations; anything else gets a tone table row
+            m_rotation.resize(dopplers.size());
+            m_toneRow.resize(dopplers.size());
+            size_t numTones = 0;
+            for (size_t d = 0; d < dopplers.size(); d++)
+            {
+                double bins = dopplers[d] * (double)n;
+                double whole = std::round(bins);
+                if (std::abs(bins - whole) < 1e-9)
+                {
+                    long long k = (long long)whole % (long long)n;
+                    m_rotation[d] = (size_t)(k < 0 ? k + (long long)n : k);
+                    m_toneRow[d] = noTone;
+                    m_numRotations++;
+                }
+                else
+                {
+                    m_rotation[d] = 0;
+                    m_toneRow[d] = numTones++;
+                }
+            }
+
+            if (numTones > 0)
+            {
+                m_tones.resize(numTones * segmentLength);
+                vector<Ipp64fc> tone(segmentLength);
+                for (size_t d = 0; d < dopplers.size(); d++)
+                {
+                    if (m_toneRow[d] == noTone)
+                        continue;
+                    // exp(-2 pi i f n) as a unit tone; Tone wants a frequency in [0, 1)
+                    double freq = -dopplers[d] - std::floor(-dopplers[d]);
+                    Ipp64f phase = 0;
+                    generator::Tone(tone.data(), (int)segmentLength, (Ipp64f)1.0, (Ipp64f)freq, &phase, ippAlgHintAccurate);
+                    detail::store_tone(tone.data(), m_tones.data() + m_toneRow[d] * segmentLength, (int)segmentLength);
+                }
+            }
+        }
+
+        /// @brief Computes the full surface, one row per Doppler, each getNumLags() long.
+        /// @param out First row; row d starts at out + d * outStride.
+        void compute(const T* segment, real_type* out, size_t outStride,
+                     parallel::ThreadPool& pool = parallel::defaultPool())
+        {
+            if (m_dopplers.size() > 1 && outStride < getNumLags())
+                throw std::invalid_argument("CAF: output row stride must be at least the number of lags");
+            run(segment, out, outStride, nullptr, pool);
+        }
+
+        /// @brief compute() into an image of getNumLags() x getNumDopplers() pixels.
+        void compute(const T* segment, ippi::image<real_type, ippi::channels::C1>& out,
+                     parallel::ThreadPool& pool = parallel::defaultPool())
+        {
+            if (out.width() != getNumLags() || out.height() != getNumDopplers())
+                throw std::invalid_argument("CAF: image must be " + std::to_string(getNumLags()) + " x " +
+                    std::to_string(getNumDopplers()) + " pixels");
+            if (out.stepBytes() % sizeof(real_type) != 0)
+                throw std::invalid_argument("CAF: image step must be a whole number of pixels");
+            compute(segment, out.data(), (size_t)out.stepBytes() / sizeof(real_type), pool);
+        }
+
+        /// @brief Keeps only the peak of each Doppler row, without storing the surface.
+        /// @param peaks Receives getNumDopplers() peaks; index is the column, lag the delay.
+        void computePeaks(const T* segment, CorrelationPeak<T>* peaks,
+                          parallel::ThreadPool& pool = parallel::defaultPool())
+        {
+            run(segment, nullptr, 0, peaks, pool);
+        }
+
+        /// @brief Lag of column c of each row.
+        long long lagAt(size_t column) const { return (long long)column - (long long)(m_xc.getReferenceLength() - 1); }
+
+        size_t getNumLags() const { return m_xc.getReferenceLength() + m_xc.getSegmentLength() - 1; }
+        size_t getNumDopplers() const { return m_dopplers.size(); }
+        const std::vector<double>& getDopplers() const { return m_dopplers; }
+        size_t getFFTLength() const { return m_xc.getFFTLength(); }
+        size_t getSegmentLength() const { return m_xc.getSegmentLength(); }
+        STFTScale getScale() const { return m_scale; }
+        /// @brief Whether Doppler row d is done by rotating the spectrum, rather than with a tone.
+        bool isRotation(size_t d) const { return m_toneRow[d] == noTone; }
+
+    private:
+        static const size_t noTone = (size_t)-1;
+
+        CrossCorrelator<T> m_xc; // holds the conjugated reference spectrum
+        std::shared_ptr<const DFTCToCPlan<T>> m_plan;
+        std::vector<double> m_dopplers;
+        STFTScale m_scale = STFTScale::Magnitude;
+        std::vector<size_t> m_rotation; // bins to rotate by, for rotation rows
+        std::vector<size_t> m_toneRow;  // row of m_tones, or noTone
+        size_t m_numRotations = 0;
+        vector<T> m_tones;
+        vector<T> m_segmentSpectrum;
+
+        // Per-task scratch, see parallel::prepareTasks
+        struct Workspace
+        {
+            vector<T> time;
+            vector<T> spectrum;
+            vector<real_type> row;  // scaled row, for the peak search
+            vector<Ipp8u> dftBuf;
+        };
+        std::vector<Workspace> m_tasks;
+
+        void prepare_tasks(size_t numTasks)
+        {
+            const size_t n = m_plan->getLength();
+            parallel::prepareTasks(m_tasks, numTasks, [&](Workspace& w){
+                if (w.time.size() != n)
+                {
+                    w.time.resize(n);
+                    w.spectrum.resize(n);
+                    w.row.resize(getNumLags());
+                }
+                if (w.dftBuf.size() < m_plan->getBufferSize())
+                    w.dftBuf.resize(m_plan->getBufferSize());
+            });
+        }
+
+        void run(const T* segment, real_type* out, size_t outStride, CorrelationPeak<T>* peaks,
+                 parallel::ThreadPool& pool)
+        {
+            if (!m_plan)
+                throw std::runtime_error("CAF: no reference, construct with one first");
+
+            const size_t numDopplers = m_dopplers.size();
+            const parallel::Partition blocks = parallel::partition(numDopplers, pool);
+            prepare_tasks(blocks.parts);
+
+            // The rotation rows all share the segment's spectrum
+            if (m_numRotations > 0)
+            {
+                if (m_segmentSpectrum.size() != m_plan->getLength())
+                    m_segmentSpectrum.resize(m_plan->getLength());
+                pad(m_tasks[0], segment, nullptr);
+                m_plan->fwd(m_tasks[0].time.data(), m_segmentSpectrum.data(), m_tasks[0].dftBuf.data());
+            }
+
+            pool.run(blocks.parts, [&](size_t part){
+                Workspace& w = m_tasks[part];
+                for (size_t d = blocks.begin(part); d < blocks.end(part); d++)
+                {
+                    correlate_row(w, segment, d);
+                    real_type* row = out != nullptr ? out + d * outStride : w.row.data();
+                    scale_row(w.time.data(), row);
+                    if (peaks != nullptr)
+                        find_peak(w.time.data(), row, peaks[d]);
+                }
+            });
+        }
+
+        // Zero-pads the segment into w.time, optionally removing a tone first
+        void pad(Workspace& w, const T* segment, const T* tone) const
+        {
+            const int segmentLength = (int)m_xc.getSegmentLength();
+            const int n = (int)m_plan->getLength();
+            if (tone != nullptr)
+                math::Mul(tone, segment, w.time.data(), segmentLength);
+            else
+                Copy(segment, w.time.data(), segmentLength);
+            if (n > segmentLength)
+                w.time.zero(segmentLength, n - segmentLength);
+        }
+
+        // Leaves the correlation for Doppler row d in w.time
+        void correlate_row(Workspace& w, const T* segment, size_t d) const
+        {
+            const size_t n = m_plan->getLength();
+            const T* reference = m_xc.getReferenceSpectrum().data();
+            if (m_toneRow[d] == noTone)
+            {
+                // spectrum[m] = S[(m + k) mod n] * conj(R[m])
+                size_t k = m_rotation[d];
+                math::Mul(m_segmentSpectrum.data() + k, reference, w.spectrum.data(), (int)(n - k));
+                if (k > 0)
+                    math::Mul(m_segmentSpectrum.data(), reference + (n - k), w.spectrum.data() + (n - k), (int)k);
+            }
+            else
+            {
+                pad(w, segment, m_tones.data() + m_toneRow[d] * m_xc.getSegmentLength());
+                m_plan->fwd(w.time.data(), w.spectrum.data(), w.dftBuf.data());
+                math::Mul_I(reference, w.spectrum.data(), (int)n);
+            }
+            m_plan->bwd(w.spectrum.data(), w.time.data(), w.dftBuf.data());
+        }
+
+        // Writes the lags -(M-1)..L-1 of the correlation, in order, to row
+        void scale_row(const T* correlation, real_type* row) const
+        {
+            const size_t n = m_plan->getLength();
+            const size_t negative = m_xc.getReferenceLength() - 1;
+            if (negative > 0)
+                detail::scale_spectrum(m_scale, correlation + (n - negative), row, (int)negative);
+            detail::scale_spectrum(m_scale, correlation, row + negative, (int)m_xc.getSegmentLength());
+        }
+
+        void find_peak(const T* correlation, const real_type* row, CorrelationPeak<T>& peak) const
+        {
+            // Every scale is monotonic in the magnitude, so the scaled row has the same peak
+            real_type best = 0;
+            int column = 0;
+            stats::MaxIndx(row, (int)getNumLags(), &best, &column);
+            peak.index = (size_t)column;
+            peak.lag = lagAt(peak.index);
+            size_t n = m_plan->getLength();
+            peak.value = correlation[peak.lag < 0 ? (size_t)((long long)n + peak.lag) : (size_t)peak.lag];
+            peak.power = peak.value.re * peak.value.re + peak.value.im * peak.value.im;
+        }
+    };
+}
@@ -0,0 +1,213 @@
+/*
+Chirp-Z transform (zoom FFT) for 32fc/64fc: M spectrum values over an arbitrary frequency span.
+
+For an input x of length N, a start frequency f0 and a step df (both in cycles per sample), the
+output is
+
+    X[k] = sum_n x[n] * exp(-2 pi i (f0 + k df) n),   for k in [0, M)
+
+so f0 = 0, df = 1/N and M = N gives the ordinary DFT. A narrow span at fine resolution is far
+cheaper than zero-padding a DFT until its bins are that close together.
+
+Bluestein's identity nk = (n^2 + k^2 - (k - n)^2) / 2 turns the sum into a convolution with a
+chirp, done with DFTs of a length L >= N + M - 1. The input and output chirps and the DFT of the
+convolution chirp are computed once at construction, so each call costs two DFTs of length L and
+three Muls.
+
+Example:
+    // 2000 bins between 0.1 and 0.12 cycles/sample, from 1M samples
+    ipps::ChirpZ<Ipp32fc> czt(1000000, 2000, 0.1, 0.02 / 2000);
+    czt.transform(x.data(), spectrum.data());
+*/
+
+#pragma once
+
+#include "ipp.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ipp_ext_vec.h"
+#include "ipp_ext_copy.h"
+#include "ipp_ext_math.h"
+#include "ipp_ext_dft.h"
+#include "ipp_ext_dft_real.h"
+#include "ipp_ext_parallel.h"
+#include "../ipp_ext_errors.h"
+
+namespace ipps
+{
+    /// @brief Chirp-Z transform over a fixed input length and frequency grid, via Bluestein's algorithm, for 32fc/64fc.
+    template <typename T>
+    class ChirpZ
+    {
+    public:
+        typedef typename detail::complex_real<T>::type real_type;
+
+        ChirpZ()
+        {}
+
+        /// @param inputLength N, the number of input samples per transform.
+        /// @param outputLength M, the number of frequencies evaluated.
+        /// @param startFrequency f0, the first frequency, in cycles per sample.
+        /// @param stepFrequency df, the spacing of the frequencies, in cycles per sample. May be negative.
+        /// @param fftLength DFT length, at least N + M - 1. 0 picks the smallest power of 2.
+        ChirpZ(size_t inputLength, size_t outputLength, double startFrequency, double stepFrequency,
+               size_t fftLength = 0)
+            : m_inputLength{inputLength}, m_outputLength{outputLength},
+              m_startFrequency{startFrequency}, m_stepFrequency{stepFrequency}
+        {
+            if (inputLength == 0)
+                throw std::invalid_argument("ChirpZ: input length cannot be 0");
+            if (outputLength == 0)
+                throw std::invalid_argument("ChirpZ: output length cannot be 0");
+
+            size_t minLength = inputLength + outputLength - 1;
+            if (fftLength == 0)
+            {
+                fftLength = 1;
+                while (fftLength < minLength)
+                    fftLength <<= 1;
+            }
+            if (fftLength < minLength)
+                throw std::invalid_argument("ChirpZ: FFT length " + std::to_string(fftLength) +
+                    " must be at least " + std::to_string(minLength) + " to avoid wrapping");
+
+            m_plan = DFTCToCPlan<T>::cached(fftLength);
+
+            // x[n] is multiplied by exp(-2 pi i f0 n) exp(-pi i df n^2) on the way in...
+            m_inputChirp.resize(inputLength);
+            for (size_t n = 0; n < inputLength; n++)
+                m_inputChirp[n] = unit(-(startFrequency * (double)n + chirp_cycles(n)));
+
+            // ...and the result by exp(-pi i df k^2) on the way out
+            m_outputChirp.resize(outputLength);
+            for (size_t k = 0; k < outputLength; k++)
+                m_outputChirp[k] = unit(-chirp_cycles(k));
+
+            // The convolution chirp exp(pi i df m^2), for m in (-N, M), with the negative m wrapped to the end
+            prepare_tasks(1);
+            Workspace& w = m_tasks[0];
+            w.time.zero();
+            for (size_t m = 0; m < outputLength; m++)
+                w.time[m] = unit(chirp_cycles(m));
+            for (size_t m = 1; m < inputLength; m++)
+                w.time[fftLength - m] = unit(chirp_cycles(m));
+            m_chirpSpectrum.resize(fftLength);
+            m_plan->fwd(w.time.data(), m_chirpSpectrum.data(), w.dftBuf.data());
+        }
+
+        /// @brief Evaluates the getOutputLength() frequencies for getInputLength() samples of src.
+        void transform(const T* src, T* dst)
+        {
+            check();
+            prepare_tasks(1);
+            transform_with(m_tasks[0], src, dst);
+        }
+
+        /// @brief transform() on count inputs, spread over the pool.
+        /// Input i starts at src + i * srcStride, and its output at dst + i * dstStride.
+        void transformBatch(const T* src, size_t srcStride, T* dst, size_t dstStride, size_t count,
+                            parallel::ThreadPool& pool = parallel::defaultPool())
+        {
+            check();
+            if (count == 0)
+                return;
+            if (count > 1 && srcStride < m_inputLength)
+                throw std::invalid_argument("ChirpZ: input stride must be at least the input length");
+            if (count > 1 && dstStride < m_outputLength)
+                throw std::invalid_argument("ChirpZ: output stride must be at least the output length");
+
+            const parallel::Partition blocks = parallel::partition(count, pool);
+            prepare_tasks(blocks.parts);
+
+            pool.run(blocks.parts, [&](size_t part){
+                for (size_t i = blocks.begin(part); i < blocks.end(part); i++)
+                    transform_with(m_tasks[part], src + i * srcStride, dst + i * dstStride);
+            });
+        }
+
+        /// @brief The frequency of output k, in cycles per sample.
+        double frequencyAt(size_t k) const { return m_startFrequency + (double)k * m_stepFrequency; }
+
+        size_t getInputLength() const { return m_inputLength; }
+        size_t getOutputLength() const { return m_outputLength; }
+        double getStartFrequency() const { return m_startFrequency; }
+        double getStepFrequency() const { return m_stepFrequency; }
+        size_t getFFTLength() const { return m_plan ? m_plan->getLength() : 0; }
+
+    private:
+        size_t m_inputLength = 0;
+        size_t m_outputLength = 0;
+        double m_startFrequency = 0;
+        double m_stepFrequency = 0;
+        std::shared_ptr<const DFTCToCPlan<T>> m_plan;
+        vector<T> m_inputChirp;
+        vector<T> m_outputChirp;
+        vector<T> m_chirpSpectrum;
+
+        // Per-task scratch, see parallel::prepareTasks
+        struct Workspace
+        {
+            vector<T> time;
+            vector<T> spectrum;
+            vector<Ipp8u> dftBuf;
+        };
+        std::vector<Workspace> m_tasks;
+
+        void check() const
+        {
+            if (!m_plan)
+                throw std::runtime_error("ChirpZ: no plan, construct with the lengths and frequencies first");
+        }
+
+        // df m^2 / 2 in cycles, reduced to [0, 1) so that the phase stays accurate for large m
+        double chirp_cycles(size_t m) const
+        {
+            double mm = (double)m;
+            double cycles = 0.5 * m_stepFrequency * mm * mm;
+            return cycles - std::floor(cycles);
+        }
+
+        static T unit(double cycles)
+        {
+            double phase = 2.0 * IPP_PI * cycles;
+            T v;
+            v.re = (real_type)std::cos(phase);
+            v.im = (real_type)std::sin(phase);
+            return v;
+        }
+
+        void prepare_tasks(size_t numTasks)
+        {
+            const size_t fftLength = m_plan->getLength();
+            parallel::prepareTasks(m_tasks, numTasks, [&](Workspace& w){
+                if (w.time.size() != fftLength)
+                {
+                    w.time.resize(fftLength);
+                    w.spectrum.resize(fftLength);
+                }
+                if (w.dftBuf.size() < m_plan->getBufferSize())
+                    w.dftBuf.resize(m_plan->getBufferSize());
+            });
+        }
+
+        void transform_with(Workspace& w, const T* src, T* dst) const
+        {
+            const int fftLength = (int)m_plan->getLength();
+            const int inputLength = (int)m_inputLength;
+
+            // The padding is zeroed on every call, since the backward DFT overwrites it
+            math::Mul(m_inputChirp.data(), src, w.time.data(), inputLength);
+            if (fftLength > inputLength)
+                w.time.zero(inputLength, fftLength - inputLength);
+
+            m_plan->fwd(w.time.data(), w.spectrum.data(), w.dftBuf.data());
+            math::Mul_I(m_chirpSpectrum.data(), w.spectrum.data(), fftLength);
+            m_plan->bwd(w.spectrum.data(), w.time.data(), w.dftBuf.data());
+            math::Mul(m_outputChirp.data(), w.time.data(), dst, (int)m_outputLength);
+        }
+    };
+}
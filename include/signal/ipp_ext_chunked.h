@@ -0,0 +1,90 @@
+/*
+Helpers for the size_t-length overloads of the ipps:: wrappers.
+
+IPP takes int lengths, so anything longer than INT_MAX has to be split up.
+The overloads (see e.g. math/Chunked.h) are only enabled for integral length types other than int,
+so existing calls with an int length still go straight to the IPP specializations, while calls with
+a size_t (e.g. vector::size()) are split into int-sized chunks and any reductions are combined.
+*/
+
+#pragma once
+
+#include "ipp.h"
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace ipps
+{
+    namespace detail
+    {
+        /// @brief Enables a size_t-length overload for any integral length type except int.
+        template <typename L>
+        struct enable_if_long : std::enable_if<std::is_integral<L>::value && !std::is_same<L, int>::value>
+        {};
+
+        /// @brief Number of elements handed to each IPP call by the chunked overloads.
+        /// A power of two, so chunks start on the same alignment as the buffer itself.
+        /// Modifiable, mainly so that tests can exercise the chunking without 2^31-element buffers.
+        inline size_t& chunkLength()
+        {
+            static size_t length = (size_t)1 << 30;
+            return length;
+        }
+
+        /// @brief Sets chunkLength() for the lifetime of the object, restoring the previous value on
+        /// destruction, even if a test fails or an exception is thrown in between.
+        class ScopedChunkLength
+        {
+        public:
+            explicit ScopedChunkLength(size_t length)
+                : m_previous{chunkLength()}
+            {
+                chunkLength() = length;
+            }
+            ~ScopedChunkLength() { chunkLength() = m_previous; }
+
+            ScopedChunkLength(const ScopedChunkLength&) = delete;
+            ScopedChunkLength& operator=(const ScopedChunkLength&) = delete;
+
+        private:
+            size_t m_previous;
+        };
+
+        /// @brief Calls f(size_t offset, int len) for consecutive chunks covering [0, length).
+        template <typename L, typename F>
+        inline void forEachChunk(L length, F f)
+        {
+            if (std::is_signed<L>::value && static_cast<long long>(length) < 0)
+                throw std::invalid_argument("Length cannot be negative: " + std::to_string(static_cast<long long>(length)));
+
+            const size_t total = static_cast<size_t>(length);
+            const size_t chunk = chunkLength();
+            for (size_t offset = 0; offset < total; offset += chunk)
+            {
+                size_t len = total - offset < chunk ? total - offset : chunk;
+                f(offset, static_cast<int>(len));
+            }
+        }
+
+        // Helpers to combine partial results of reductions
+        inline void accumulate(Ipp32f& total, const Ipp32f& part) { total += part; }
+        inline void accumulate(Ipp64f& total, const Ipp64f& part) { total += part; }
+        inline void accumulate(Ipp32fc& total, const Ipp32fc& part) { total.re += part.re; total.im += part.im; }
+        inline void accumulate(Ipp64fc& total, const Ipp64fc& part) { total.re += part.re; total.im += part.im; }
+        inline void accumulate(Ipp16sc& total, const Ipp16sc& part) { total.re += part.re; total.im += part.im; }
+        inline void accumulate(Ipp32sc& total, const Ipp32sc& part) { total.re += part.re; total.im += part.im; }
+        inline void accumulate(Ipp64sc& total, const Ipp64sc& part) { total.re += part.re; total.im += part.im; }
+        template <typename T>
+        inline void accumulate(T& total, const T& part) { total += part; }
+
+        template <typename T>
+        inline T zeroValue() { return T(0); }
+        template <> inline Ipp32fc zeroValue<Ipp32fc>() { Ipp32fc z = {0, 0}; return z; }
+        template <> inline Ipp64fc zeroValue<Ipp64fc>() { Ipp64fc z = {0, 0}; return z; }
+        template <> inline Ipp16sc zeroValue<Ipp16sc>() { Ipp16sc z = {0, 0}; return z; }
+        template <> inline Ipp32sc zeroValue<Ipp32sc>() { Ipp32sc z = {0, 0}; return z; }
+        template <> inline Ipp64sc zeroValue<Ipp64sc>() { Ipp64sc z = {0, 0}; return z; }
+    }
+}
@@ -4,4 +4,7 @@
 #include "convert/RealCplx.h"
 #include "convert/Convert.h"
 #include "convert/Conj.h"
-#include "convert/PowerSpectr.h"
\ No newline at end of file
+#include "convert/PowerSpectr.h"
+#include "convert/Magnitude.h"
+#include "convert/Chunked.h"
+#include "convert/Views.h"
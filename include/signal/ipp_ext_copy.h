@@ -3,6 +3,7 @@
 #include "../ipp_ext_errors.h"
 #include <stdexcept>
 #include <string>
+#include "ipp_ext_chunked.h"
 
 namespace ipps{
 
@@ -106,5 +107,56 @@ namespace ipps{
         IPP_NO_ERROR(sts, "ippsCopy_64fc");
     }
 
+    // The following types have no ippsCopy of their own, so they are copied as
+    // a same-width type instead, similar to what vector::zero() and vector::set() do.
+
+    // Ipp8s (as Ipp8u)
+    template <>
+    inline void Copy(const Ipp8s* src, Ipp8s* dst, int len)
+    {
+        IppStatus sts = ippsCopy_8u(reinterpret_cast<const Ipp8u*>(src), reinterpret_cast<Ipp8u*>(dst), len);
+        IPP_NO_ERROR(sts, "ippsCopy_8u");
+    }
+
+    // Ipp16u (as Ipp16s)
+    template <>
+    inline void Copy(const Ipp16u* src, Ipp16u* dst, int len)
+    {
+        IppStatus sts = ippsCopy_16s(reinterpret_cast<const Ipp16s*>(src), reinterpret_cast<Ipp16s*>(dst), len);
+        IPP_NO_ERROR(sts, "ippsCopy_16s");
+    }
+
+    // Ipp32u (as Ipp32s)
+    template <>
+    inline void Copy(const Ipp32u* src, Ipp32u* dst, int len)
+    {
+        IppStatus sts = ippsCopy_32s(reinterpret_cast<const Ipp32s*>(src), reinterpret_cast<Ipp32s*>(dst), len);
+        IPP_NO_ERROR(sts, "ippsCopy_32s");
+    }
+
+    // Ipp64u (as Ipp64s)
+    template <>
+    inline void Copy(const Ipp64u* src, Ipp64u* dst, int len)
+    {
+        IppStatus sts = ippsCopy_64s(reinterpret_cast<const Ipp64s*>(src), reinterpret_cast<Ipp64s*>(dst), len);
+        IPP_NO_ERROR(sts, "ippsCopy_64s");
+    }
+
+    // Ipp8sc (as Ipp16s, we ASSUME it is packed into 16 bits)
+    template <>
+    inline void Copy(const Ipp8sc* src, Ipp8sc* dst, int len)
+    {
+        IppStatus sts = ippsCopy_16s(reinterpret_cast<const Ipp16s*>(src), reinterpret_cast<Ipp16s*>(dst), len);
+        IPP_NO_ERROR(sts, "ippsCopy_16s");
+    }
+
+    // size_t lengths, split into int-sized chunks (see ipp_ext_chunked.h)
+    template <typename T, typename L>
+    inline typename detail::enable_if_long<L>::type Copy(const T* src, T* dst, L len)
+    {
+        detail::forEachChunk(len, [&](size_t offset, int n){
+            Copy(src + offset, dst + offset, n);
+        });
+    }
 
 }
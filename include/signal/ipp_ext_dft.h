@@ -1,53 +1,252 @@
 /*
 Note that all specializations are inlined in order to ensure that
 multiply defined symbols errors do not occur.
+
+The DFT is split into two parts:
+- DFTCToCPlan holds the IPP spec (and init memory). It is never modified after construction,
+  so one plan can be shared by any number of threads.
+- DFTCToC holds a plan along with its own work buffer. Each thread should use its own DFTCToC,
+  but they can all point to the same plan:
+
+    auto plan = std::make_shared<const ipps::DFTCToCPlan<Ipp32fc>>(length);
+    ipps::DFTCToC<Ipp32fc> dft0(plan), dft1(plan); // one for each thread, no spec re-initialisation
+
+Power-of-two lengths automatically use the ippsFFT routines instead of ippsDFT, which are faster and
+need smaller specs; pass DFTBackend::DFT to force the generic routines.
+
+DFTCToCPlan::cached() looks the plan up in the process-wide ippe::plancache instead, so that
+objects which are rebuilt often (e.g. on reconfiguration) don't pay for ippsDFTInit every time.
 */
 
 #pragma once
 
 #include "ipp.h"
+#include <algorithm>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <vector>
 #include "ipp_ext_vec.h"
+#include "ipp_ext_view.h"
+#include "ipp_ext_matrix.h"
+#include "ipp_ext_parallel.h"
+#include "../ipp_ext_plancache.h"
 
 namespace ipps
 {
+    /// @brief Which IPP routines a DFTCToCPlan uses. Auto picks the FFT for power-of-two lengths.
+    enum class DFTBackend
+    {
+        Auto,
+        DFT,
+        FFT
+    };
+
+    /// @brief Read-only DFT spec for a given length and flag. Safe to share between threads;
+    /// each caller supplies its own work buffer of getBufferSize() bytes.
+    template <typename T>
+    class DFTCToCPlan
+    {
+        public:
+            /// @param backend Auto uses the FFT routines for power-of-two lengths and the DFT otherwise.
+            /// FFT requires a power-of-two length; DFT forces the generic routines.
+            DFTCToCPlan(size_t length, int flag = IPP_FFT_DIV_INV_BY_N, DFTBackend backend = DFTBackend::Auto)
+                : m_length{length}, m_flag{flag}, m_backend{backend}
+            {
+                if (m_length == 0)
+                {
+                    throw std::invalid_argument("DFTCToC: length cannot be 0");
+                }
+                if (m_backend == DFTBackend::FFT && !is_pow2(m_length))
+                {
+                    throw std::invalid_argument("DFTCToC: FFT backend requires a power of 2 length, not " + std::to_string(m_length));
+                }
+                prepare_dft();
+            }
+
+            // FFT specs hold pointers into their own memory, so those are rebuilt rather than copied byte-wise
+            DFTCToCPlan(const DFTCToCPlan& other)
+                : m_length{other.m_length}, m_flag{other.m_flag}, m_backend{other.m_backend},
+                  m_SizeSpec{other.m_SizeSpec}, m_SizeInit{other.m_SizeInit}, m_SizeBuf{other.m_SizeBuf}
+            {
+                if (other.m_fft)
+                {
+                    prepare_dft();
+                }
+                else
+                {
+                    m_pDFTSpec = other.m_pDFTSpec;
+                    m_pMemInit = other.m_pMemInit;
+                }
+            }
+
+            // Plans are shared as const, so there is nothing to assign to
+            DFTCToCPlan& operator=(const DFTCToCPlan&) = delete;
+
+            /// @brief Returns a shared plan from ippe::plancache, building and caching it on a miss.
+            static std::shared_ptr<const DFTCToCPlan> cached(size_t length, int flag = IPP_FFT_DIV_INV_BY_N,
+                                                             DFTBackend backend = DFTBackend::Auto)
+            {
+                return ippe::plancache::get<DFTCToCPlan>(
+                    ippe::plancache::makeKey<DFTCToCPlan>(length, (size_t)backend, flag),
+                    [length, flag, backend](){ return std::make_shared<const DFTCToCPlan>(length, flag, backend); }
+                );
+            }
+
+            /// @brief Runs the forward DFT using the given work buffer (see DFTCToC::fwd for the other arguments).
+            /// @param pBuffer Work buffer of at least getBufferSize() bytes, not in use by any other thread.
+            void fwd(const T* src, T* dst, Ipp8u* pBuffer, const T* srcIm=nullptr, T* dstIm=nullptr) const;
+
+            /// @brief Runs the backward DFT using the given work buffer (see DFTCToC::bwd for the other arguments).
+            /// @param pBuffer Work buffer of at least getBufferSize() bytes, not in use by any other thread.
+            void bwd(const T* src, T* dst, Ipp8u* pBuffer, const T* srcIm=nullptr, T* dstIm=nullptr) const;
+
+            // Some getters
+            size_t getLength() const { return m_length; }
+            int getFlag() const { return m_flag; }
+            size_t getBufferSize() const { return (size_t)m_SizeBuf; }
+            const vector<Ipp8u>& getDFTSpec() const { return m_pDFTSpec; }
+            const vector<Ipp8u>& getMemInit() const { return m_pMemInit; }
+            /// @brief Bytes held by the plan itself (not including any work buffers).
+            size_t getMemoryBytes() const { return m_pDFTSpec.size() + m_pMemInit.size(); }
+            /// @brief Whether the FFT routines are used (as opposed to the generic DFT).
+            bool isFFT() const { return m_fft; }
+            /// @brief log2 of the length when isFFT(), otherwise 0.
+            int getOrder() const { return m_fft ? m_order : 0; }
+
+            static bool is_pow2(size_t length)
+            {
+                return length != 0 && (length & (length - 1)) == 0;
+            }
+
+        private:
+            size_t m_length;
+            int m_flag;
+            DFTBackend m_backend;
+            int m_SizeSpec;
+            int m_SizeInit;
+            int m_SizeBuf;
+
+            vector<Ipp8u> m_pDFTSpec;
+            vector<Ipp8u> m_pMemInit;
+
+            // FFT state; the spec is kept as an offset into m_pDFTSpec so that copies stay valid
+            bool m_fft = false;
+            int m_order = 0;
+            size_t m_fftSpecOffset = 0;
+
+            // the constructor will call this, and this will contain the specializations
+            void prepare_dft();
+
+            // Sets m_order and returns true if the FFT should be attempted
+            bool use_fft()
+            {
+                if (m_backend == DFTBackend::DFT || !is_pow2(m_length))
+                    return false;
+                m_order = 0;
+                while (((size_t)1 << m_order) < m_length)
+                    m_order++;
+                return true;
+            }
+
+            // ippsFFTInit aligns the spec within the memory it is given, so remember where it ended up
+            void set_fft_spec(const Ipp8u* pSpec)
+            {
+                m_fft = true;
+                m_fftSpecOffset = (size_t)(pSpec - m_pDFTSpec.data());
+            }
+
+            const Ipp8u* fft_spec() const
+            {
+                return m_pDFTSpec.data() + m_fftSpecOffset;
+            }
+            // which in turn calls this after it discovers the sizes, along with other things
+            void allocate_vectors()
+            {
+                m_pDFTSpec.resize(m_SizeSpec);
+                m_pMemInit.resize(m_SizeInit);
+            }
+    };
+
     template <typename T>
     class DFTCToC
     {
         public:
+            typedef DFTCToCPlan<T> plan_type;
+
             // Constructors
             DFTCToC()
-                : m_length{0}, m_flag{IPP_FFT_DIV_INV_BY_N}
             {
 
             }
 
-            DFTCToC(size_t length, int flag = IPP_FFT_DIV_INV_BY_N)
-                : m_length{length}, m_flag{flag}
+            DFTCToC(size_t length, int flag = IPP_FFT_DIV_INV_BY_N, DFTBackend backend = DFTBackend::Auto)
+                : m_plan{std::make_shared<const plan_type>(length, flag, backend)}
             {
-                if (m_length == 0)
+                m_pDFTBuf.resize(m_plan->getBufferSize());
+            }
+
+            /// @brief Creates an FFT of length 2^order.
+            static DFTCToC fromOrder(int order, int flag = IPP_FFT_DIV_INV_BY_N)
+            {
+                if (order < 0 || order > 30)
+                    throw std::invalid_argument("DFTCToC: FFT order must be between 0 and 30");
+                return DFTCToC((size_t)1 << order, flag, DFTBackend::FFT);
+            }
+
+            /// @brief Creates an executor for an existing plan, only allocating a work buffer.
+            /// Use one of these per thread to run the same DFT concurrently.
+            explicit DFTCToC(std::shared_ptr<const plan_type> plan)
+                : m_plan{std::move(plan)}
+            {
+                if (!m_plan)
+                    throw std::invalid_argument("DFTCToC: plan cannot be null");
+                m_pDFTBuf.resize(m_plan->getBufferSize());
+            }
+
+            // Copies get their own plan, so that they are fully independent of the original
+            DFTCToC(const DFTCToC& other)
+                : m_plan{other.m_plan ? std::make_shared<const plan_type>(*other.m_plan) : nullptr},
+                  m_pDFTBuf{other.m_pDFTBuf}
+            {
+
+            }
+
+            DFTCToC& operator=(const DFTCToC& other)
+            {
+                if (this != &other)
                 {
-                    throw std::invalid_argument("DFTCToC: length cannot be 0");
+                    m_plan = other.m_plan ? std::make_shared<const plan_type>(*other.m_plan) : nullptr;
+                    m_pDFTBuf = other.m_pDFTBuf;
                 }
-                prepare_dft();
+                return *this;
             }
 
-            // Main runtime methods (see below for the specializations)
+            DFTCToC(DFTCToC&& other) = default;
+            DFTCToC& operator=(DFTCToC&& other) = default;
+
+            // Main runtime methods (see DFTCToCPlan for the specializations)
 
             /// @brief Runs the forward DFT on the data.
             /// @param src Real part of input for (32f/64f), full complex input for (32fc/64fc)
             /// @param dst Real part of output for (32f/64f), full complex output for (32fc/64fc)
             /// @param srcIm Imaginary part of input for (32f/64f), ignored for (32fc/64fc)
             /// @param dstIm Imaginary part of output for (32f/64f), ignored for (32fc/64fc)
-            void fwd(const T* src, T* dst, const T* srcIm=nullptr, T* dstIm=nullptr);
+            void fwd(const T* src, T* dst, const T* srcIm=nullptr, T* dstIm=nullptr)
+            {
+                plan().fwd(src, dst, m_pDFTBuf.data(), srcIm, dstIm);
+            }
 
             /// @brief Runs the backward DFT on the data.
             /// @param src Real part of input for (32f/64f), full complex input for (32fc/64fc)
             /// @param dst Real part of output for (32f/64f), full complex output for (32fc/64fc)
             /// @param srcIm Imaginary part of input for (32f/64f), ignored for (32fc/64fc)
             /// @param dstIm Imaginary part of output for (32f/64f), ignored for (32fc/64fc)
-            void bwd(const T* src, T* dst, const T* srcIm=nullptr, T* dstIm=nullptr);
+            void bwd(const T* src, T* dst, const T* srcIm=nullptr, T* dstIm=nullptr)
+            {
+                plan().bwd(src, dst, m_pDFTBuf.data(), srcIm, dstIm);
+            }
 
             // Alias for bwd (since Inv is the name given by IPP)
             void inv(const T* src, T* dst, const T* srcIm=nullptr, T* dstIm=nullptr)
@@ -55,32 +254,230 @@ namespace ipps
                 bwd(src, dst, srcIm, dstIm); 
             }
 
+            /// @brief Runs the forward DFT on count equal-length rows, spread over the pool's threads.
+            /// Each thread uses its own work buffer, and src may equal dst (in-place).
+            /// @param srcStride Elements between the starts of consecutive input rows, at least getLength()
+            /// @param dstStride Elements between the starts of consecutive output rows, at least getLength()
+            /// @param srcIm Imaginary part of input for (32f/64f), using srcStride; ignored for (32fc/64fc)
+            /// @param dstIm Imaginary part of output for (32f/64f), using dstStride; ignored for (32fc/64fc)
+            void fwdBatch(const T* src, size_t srcStride, T* dst, size_t dstStride, size_t count,
+                          const T* srcIm=nullptr, T* dstIm=nullptr,
+                          parallel::ThreadPool& pool=parallel::defaultPool())
+            {
+                run_batch(src, srcStride, dst, dstStride, count, srcIm, dstIm, pool, true);
+            }
+
+            /// @brief Runs the backward DFT on count equal-length rows, spread over the pool's threads.
+            /// See fwdBatch for the arguments.
+            void bwdBatch(const T* src, size_t srcStride, T* dst, size_t dstStride, size_t count,
+                          const T* srcIm=nullptr, T* dstIm=nullptr,
+                          parallel::ThreadPool& pool=parallel::defaultPool())
+            {
+                run_batch(src, srcStride, dst, dstStride, count, srcIm, dstIm, pool, false);
+            }
+
+            /// @brief Runs the forward DFT on every row of src into the same row of dst, for 32fc/64fc.
+            /// The matrices must have getLength() columns and the same number of rows; they may be the same matrix.
+            void fwdBatch(const matrix<T>& src, matrix<T>& dst, parallel::ThreadPool& pool=parallel::defaultPool())
+            {
+                run_batch(src, dst, pool, true);
+            }
+
+            /// @brief Runs the backward DFT on every row of src into the same row of dst, for 32fc/64fc.
+            void bwdBatch(const matrix<T>& src, matrix<T>& dst, parallel::ThreadPool& pool=parallel::defaultPool())
+            {
+                run_batch(src, dst, pool, false);
+            }
+
+            /// @brief Runs the forward DFT on (possibly strided) views, for 32fc/64fc.
+            /// Strided views are gathered into an internal buffer, so contiguous views are preferred.
+            void fwd(const vector_view<const T>& src, const vector_view<T>& dst)
+            {
+                run_views(src, dst, true);
+            }
+
+            /// @brief Runs the backward DFT on (possibly strided) views, for 32fc/64fc.
+            void bwd(const vector_view<const T>& src, const vector_view<T>& dst)
+            {
+                run_views(src, dst, false);
+            }
+
+            /// @brief Runs the forward DFT on (possibly strided) split-complex views, for 32f/64f.
+            void fwd(const vector_view<const T>& srcRe, const vector_view<const T>& srcIm,
+                     const vector_view<T>& dstRe, const vector_view<T>& dstIm)
+            {
+                run_views(srcRe, srcIm, dstRe, dstIm, true);
+            }
+
+            /// @brief Runs the backward DFT on (possibly strided) split-complex views, for 32f/64f.
+            void bwd(const vector_view<const T>& srcRe, const vector_view<const T>& srcIm,
+                     const vector_view<T>& dstRe, const vector_view<T>& dstIm)
+            {
+                run_views(srcRe, srcIm, dstRe, dstIm, false);
+            }
+
             // Some getters
-            size_t getLength() const { return m_length; }
-            int getFlag() const { return m_flag; }
-            const vector<Ipp8u>& getDFTSpec() const { return m_pDFTSpec; }
+            size_t getLength() const { return m_plan ? m_plan->getLength() : 0; }
+            int getFlag() const { return m_plan ? m_plan->getFlag() : IPP_FFT_DIV_INV_BY_N; }
+            const vector<Ipp8u>& getDFTSpec() const { return m_plan ? m_plan->getDFTSpec() : empty_bytes(); }
             const vector<Ipp8u>& getDFTBuf() const { return m_pDFTBuf; }
-            const vector<Ipp8u>& getMemInit() const { return m_pMemInit; }
+            const vector<Ipp8u>& getMemInit() const { return m_plan ? m_plan->getMemInit() : empty_bytes(); }
+            /// @brief The (possibly shared) plan, to construct other executors from.
+            const std::shared_ptr<const plan_type>& getPlan() const { return m_plan; }
+            /// @brief Whether the FFT routines are used (as opposed to the generic DFT).
+            bool isFFT() const { return m_plan && m_plan->isFFT(); }
 
         private:
-            size_t m_length;
-            int m_flag;
-            int m_SizeSpec;
-            int m_SizeInit;
-            int m_SizeBuf;
-
-            vector<Ipp8u> m_pDFTSpec;
+            std::shared_ptr<const plan_type> m_plan;
             vector<Ipp8u> m_pDFTBuf;
-            vector<Ipp8u> m_pMemInit;
 
-            // the constructor will call this, and this will contain the specializations
-            void prepare_dft();
-            // which in turn calls this after it discovers the sizes, along with other things
-            void allocate_vectors()
+            // Scratch for strided views, only allocated the first time one is used
+            vector<T> m_viewBuf;
+            // Work buffers for the extra threads of a batch; the first thread uses m_pDFTBuf
+            std::vector<vector<Ipp8u>> m_batchBufs;
+
+            const plan_type& plan() const
             {
-                m_pDFTSpec.resize(m_SizeSpec);
-                m_pDFTBuf.resize(m_SizeBuf);
-                m_pMemInit.resize(m_SizeInit);
+                if (!m_plan)
+                    throw std::runtime_error("DFTCToC: no plan, construct with a length first");
+                return *m_plan;
+            }
+
+            static const vector<Ipp8u>& empty_bytes()
+            {
+                static const vector<Ipp8u> empty;
+                return empty;
+            }
+
+            static bool is_split()
+            {
+                return std::is_same<T, Ipp32f>::value || std::is_same<T, Ipp64f>::value;
+            }
+
+            void check_view_length(size_t size)
+            {
+                if (size != getLength())
+                    throw std::invalid_argument("DFTCToC: view size " + std::to_string(size) +
+                        " does not match DFT length " + std::to_string(getLength()));
+            }
+
+            // Returns a contiguous pointer for the view, gathering it into the scratch slot if required
+            const T* view_input(const vector_view<const T>& v, size_t slot)
+            {
+                check_view_length(v.size());
+                if (v.contiguous())
+                    return v.data();
+                T* scratch = view_scratch(slot);
+                detail::gather(v, 0, getLength(), scratch);
+                return scratch;
+            }
+
+            T* view_output(const vector_view<T>& v, size_t slot)
+            {
+                check_view_length(v.size());
+                return v.contiguous() ? v.data() : view_scratch(slot);
+            }
+
+            void view_writeback(const T* p, const vector_view<T>& v)
+            {
+                if (!v.contiguous())
+                    detail::scatter(p, v, 0, getLength());
+            }
+
+            // Sized up front by run_views, so that pointers to earlier slots stay valid
+            void reserve_view_scratch(size_t slots)
+            {
+                if (m_viewBuf.size() < slots * getLength())
+                    m_viewBuf.resize(slots * getLength());
+            }
+
+            T* view_scratch(size_t slot)
+            {
+                return m_viewBuf.data() + slot * getLength();
+            }
+
+            void run_batch(const T* src, size_t srcStride, T* dst, size_t dstStride, size_t count,
+                           const T* srcIm, T* dstIm, parallel::ThreadPool& pool, bool forward)
+            {
+                const plan_type& p = plan();
+                const size_t length = p.getLength();
+                if (count == 0)
+                    return;
+                if (count > 1 && (srcStride < length || dstStride < length))
+                    throw std::invalid_argument("DFTCToC: batch row strides must be at least the DFT length");
+
+                // One block of rows per task, so each task can own a work buffer
+                const parallel::Partition blocks = parallel::partition(count, pool);
+                const size_t parts = blocks.parts;
+
+                // Sized before running, since the tasks must not touch the outer vector
+                if (m_batchBufs.size() < parts - 1)
+                    m_batchBufs.resize(parts - 1);
+                for (size_t i = 0; i + 1 < parts; i++)
+                    if (m_batchBufs[i].size() < p.getBufferSize())
+                        m_batchBufs[i].resize(p.getBufferSize());
+
+                pool.run(parts, [&](size_t part){
+                    Ipp8u* buffer = part == 0 ? m_pDFTBuf.data() : m_batchBufs[part - 1].data();
+                    for (size_t r = blocks.begin(part); r < blocks.end(part); r++)
+                    {
+                        const T* rowSrcIm = srcIm != nullptr ? srcIm + r * srcStride : nullptr;
+                        T* rowDstIm = dstIm != nullptr ? dstIm + r * dstStride : nullptr;
+                        if (forward)
+                            p.fwd(src + r * srcStride, dst + r * dstStride, buffer, rowSrcIm, rowDstIm);
+                        else
+                            p.bwd(src + r * srcStride, dst + r * dstStride, buffer, rowSrcIm, rowDstIm);
+                    }
+                });
+            }
+
+            void run_batch(const matrix<T>& src, matrix<T>& dst, parallel::ThreadPool& pool, bool forward)
+            {
+                if (is_split())
+                    throw std::invalid_argument("DFTCToC: 32f/64f require separate real and imaginary rows, use the pointer overload");
+                if (src.columns() != getLength())
+                    throw std::invalid_argument("DFTCToC: matrix columns " + std::to_string(src.columns()) +
+                        " do not match DFT length " + std::to_string(getLength()));
+                if (dst.rows() != src.rows() || dst.columns() != src.columns())
+                    throw std::invalid_argument("DFTCToC: output matrix dimensions do not match the input");
+
+                run_batch(src.data(), src.columns(), dst.data(), dst.columns(), src.rows(), nullptr, nullptr, pool, forward);
+            }
+
+            void run_views(const vector_view<const T>& src, const vector_view<T>& dst, bool forward)
+            {
+                if (is_split())
+                    throw std::invalid_argument("DFTCToC: 32f/64f require separate real and imaginary views");
+
+                if (!src.contiguous() || !dst.contiguous())
+                    reserve_view_scratch(2);
+                const T* in = view_input(src, 0);
+                T* out = view_output(dst, 1);
+                if (forward)
+                    fwd(in, out);
+                else
+                    bwd(in, out);
+                view_writeback(out, dst);
+            }
+
+            void run_views(const vector_view<const T>& srcRe, const vector_view<const T>& srcIm,
+                           const vector_view<T>& dstRe, const vector_view<T>& dstIm, bool forward)
+            {
+                if (!is_split())
+                    throw std::invalid_argument("DFTCToC: 32fc/64fc take interleaved views, not split real/imaginary ones");
+
+                if (!srcRe.contiguous() || !srcIm.contiguous() || !dstRe.contiguous() || !dstIm.contiguous())
+                    reserve_view_scratch(4);
+                const T* inRe = view_input(srcRe, 0);
+                const T* inIm = view_input(srcIm, 1);
+                T* outRe = view_output(dstRe, 2);
+                T* outIm = view_output(dstIm, 3);
+                if (forward)
+                    fwd(inRe, outRe, inIm, outIm);
+                else
+                    bwd(inRe, outRe, inIm, outIm);
+                view_writeback(outRe, dstRe);
+                view_writeback(outIm, dstIm);
             }
     };
 
@@ -88,15 +485,36 @@ namespace ipps
     ==================== SPECIALIZATIONS FOR PREPARE ====================================
     */
     template <typename T>
-    inline void DFTCToC<T>::prepare_dft()
+    inline void DFTCToCPlan<T>::prepare_dft()
     {
         throw std::domain_error("No constructor for this type. DFTCToC currently only supports 32f, 64f, 32fc and 64fc.");
     }
 
     // specialization for Ipp32f
     template <>
-    inline void DFTCToC<Ipp32f>::prepare_dft()
+    inline void DFTCToCPlan<Ipp32f>::prepare_dft()
     {
+        // Power-of-two lengths use the FFT, which is faster and has smaller specs
+        if (use_fft())
+        {
+            IppStatus status = ippsFFTGetSize_C_32f(m_order, m_flag, ippAlgHintNone, &m_SizeSpec, &m_SizeInit, &m_SizeBuf);
+            if (status == ippStsNoErr)
+            {
+                allocate_vectors();
+                IppsFFTSpec_C_32f* pSpec = nullptr;
+                IppStatus status2 = ippsFFTInit_C_32f(&pSpec, m_order, m_flag, ippAlgHintNone, m_pDFTSpec.data(), m_pMemInit.data());
+                if (status2 != ippStsNoErr){
+                    throw std::runtime_error("ippsFFTInit_C_32f failed with error code " + std::to_string(status2));
+                }
+                set_fft_spec((const Ipp8u*)pSpec);
+                return;
+            }
+            if (m_backend == DFTBackend::FFT){
+                throw std::runtime_error("ippsFFTGetSize_C_32f failed with error code " + std::to_string(status));
+            }
+            // otherwise fall back to the DFT (e.g. for orders the FFT doesn't support)
+        }
+
         // First get the size of the structure required
         IppStatus status = ippsDFTGetSize_C_32f(
             (int)m_length,
@@ -128,8 +546,29 @@ namespace ipps
 
     // specialization for Ipp64f
     template <>
-    inline void DFTCToC<Ipp64f>::prepare_dft()
+    inline void DFTCToCPlan<Ipp64f>::prepare_dft()
     {
+        // Power-of-two lengths use the FFT, which is faster and has smaller specs
+        if (use_fft())
+        {
+            IppStatus status = ippsFFTGetSize_C_64f(m_order, m_flag, ippAlgHintNone, &m_SizeSpec, &m_SizeInit, &m_SizeBuf);
+            if (status == ippStsNoErr)
+            {
+                allocate_vectors();
+                IppsFFTSpec_C_64f* pSpec = nullptr;
+                IppStatus status2 = ippsFFTInit_C_64f(&pSpec, m_order, m_flag, ippAlgHintNone, m_pDFTSpec.data(), m_pMemInit.data());
+                if (status2 != ippStsNoErr){
+                    throw std::runtime_error("ippsFFTInit_C_64f failed with error code " + std::to_string(status2));
+                }
+                set_fft_spec((const Ipp8u*)pSpec);
+                return;
+            }
+            if (m_backend == DFTBackend::FFT){
+                throw std::runtime_error("ippsFFTGetSize_C_64f failed with error code " + std::to_string(status));
+            }
+            // otherwise fall back to the DFT (e.g. for orders the FFT doesn't support)
+        }
+
         // First get the size of the structure required
         IppStatus status = ippsDFTGetSize_C_64f(
             (int)m_length,
@@ -161,8 +600,29 @@ namespace ipps
 
     // specialization for Ipp32fc
     template <>
-    inline void DFTCToC<Ipp32fc>::prepare_dft()
+    inline void DFTCToCPlan<Ipp32fc>::prepare_dft()
     {
+        // Power-of-two lengths use the FFT, which is faster and has smaller specs
+        if (use_fft())
+        {
+            IppStatus status = ippsFFTGetSize_C_32fc(m_order, m_flag, ippAlgHintNone, &m_SizeSpec, &m_SizeInit, &m_SizeBuf);
+            if (status == ippStsNoErr)
+            {
+                allocate_vectors();
+                IppsFFTSpec_C_32fc* pSpec = nullptr;
+                IppStatus status2 = ippsFFTInit_C_32fc(&pSpec, m_order, m_flag, ippAlgHintNone, m_pDFTSpec.data(), m_pMemInit.data());
+                if (status2 != ippStsNoErr){
+                    throw std::runtime_error("ippsFFTInit_C_32fc failed with error code " + std::to_string(status2));
+                }
+                set_fft_spec((const Ipp8u*)pSpec);
+                return;
+            }
+            if (m_backend == DFTBackend::FFT){
+                throw std::runtime_error("ippsFFTGetSize_C_32fc failed with error code " + std::to_string(status));
+            }
+            // otherwise fall back to the DFT (e.g. for orders the FFT doesn't support)
+        }
+
         // First get the size of the structure required
         IppStatus status = ippsDFTGetSize_C_32fc(
             (int)m_length,
@@ -195,8 +655,29 @@ namespace ipps
 
     // specialization for Ipp64fc
     template <>
-    inline void DFTCToC<Ipp64fc>::prepare_dft()
+    inline void DFTCToCPlan<Ipp64fc>::prepare_dft()
     {
+        // Power-of-two lengths use the FFT, which is faster and has smaller specs
+        if (use_fft())
+        {
+            IppStatus status = ippsFFTGetSize_C_64fc(m_order, m_flag, ippAlgHintNone, &m_SizeSpec, &m_SizeInit, &m_SizeBuf);
+            if (status == ippStsNoErr)
+            {
+                allocate_vectors();
+                IppsFFTSpec_C_64fc* pSpec = nullptr;
+                IppStatus status2 = ippsFFTInit_C_64fc(&pSpec, m_order, m_flag, ippAlgHintNone, m_pDFTSpec.data(), m_pMemInit.data());
+                if (status2 != ippStsNoErr){
+                    throw std::runtime_error("ippsFFTInit_C_64fc failed with error code " + std::to_string(status2));
+                }
+                set_fft_spec((const Ipp8u*)pSpec);
+                return;
+            }
+            if (m_backend == DFTBackend::FFT){
+                throw std::runtime_error("ippsFFTGetSize_C_64fc failed with error code " + std::to_string(status));
+            }
+            // otherwise fall back to the DFT (e.g. for orders the FFT doesn't support)
+        }
+
         // First get the size of the structure required
         IppStatus status = ippsDFTGetSize_C_64fc(
             (int)m_length,
@@ -230,15 +711,24 @@ namespace ipps
     ======================= SPECIALIZATIONS FOR FORWARD ====================================
     */
     template <typename T>
-    inline void DFTCToC<T>::fwd(const T* /*src*/, T* /*dst*/, const T* /*srcIm*/, T* /*dstIm*/)
+    inline void DFTCToCPlan<T>::fwd(const T* /*src*/, T* /*dst*/, Ipp8u* /*pBuffer*/, const T* /*srcIm*/, T* /*dstIm*/) const
     {
         throw std::domain_error("We should never hit this error. DFTCToC currently only supports 32f, 64f, 32fc and 64fc.");
     }
 
     // specialization for Ipp32f
     template <>
-    inline void DFTCToC<Ipp32f>::fwd(const Ipp32f* src, Ipp32f* dst, const Ipp32f* srcIm, Ipp32f* dstIm)
+    inline void DFTCToCPlan<Ipp32f>::fwd(const Ipp32f* src, Ipp32f* dst, Ipp8u* pBuffer, const Ipp32f* srcIm, Ipp32f* dstIm) const
     {
+        if (m_fft)
+        {
+            IppStatus status = ippsFFTFwd_CToC_32f(src, srcIm, dst, dstIm, (const IppsFFTSpec_C_32f*) fft_spec(), pBuffer);
+            if (status != ippStsNoErr){
+                throw std::runtime_error("ippsFFTFwd_CToC_32f failed with error code " + std::to_string(status));
+            }
+            return;
+        }
+
         // call the IPP specific fwd function for Ipp32f
         IppStatus status = ippsDFTFwd_CToC_32f(
             src, 
@@ -246,7 +736,7 @@ namespace ipps
             dst, 
             dstIm, // this must be supplied for Ipp32f/Ipp64f i.e. the non-complex data types
             (const IppsDFTSpec_C_32f*) m_pDFTSpec.data(),
-            m_pDFTBuf.data()
+            pBuffer
         );
         if (status!= ippStsNoErr){
             throw std::runtime_error("ippsDFTFwd_C_32f failed with error code " + std::to_string(status));
@@ -255,8 +745,17 @@ namespace ipps
 
     // specialization for Ipp64f
     template <>
-    inline void DFTCToC<Ipp64f>::fwd(const Ipp64f* src, Ipp64f* dst, const Ipp64f* srcIm, Ipp64f* dstIm)
+    inline void DFTCToCPlan<Ipp64f>::fwd(const Ipp64f* src, Ipp64f* dst, Ipp8u* pBuffer, const Ipp64f* srcIm, Ipp64f* dstIm) const
     {
+        if (m_fft)
+        {
+            IppStatus status = ippsFFTFwd_CToC_64f(src, srcIm, dst, dstIm, (const IppsFFTSpec_C_64f*) fft_spec(), pBuffer);
+            if (status != ippStsNoErr){
+                throw std::runtime_error("ippsFFTFwd_CToC_64f failed with error code " + std::to_string(status));
+            }
+            return;
+        }
+
         // call the IPP specific fwd function for Ipp64f
         IppStatus status = ippsDFTFwd_CToC_64f(
             src, 
@@ -264,7 +763,7 @@ namespace ipps
             dst, 
             dstIm, // this must be supplied for Ipp32f/Ipp64f i.e. the non-complex data types
             (const IppsDFTSpec_C_64f*) m_pDFTSpec.data(),
-            m_pDFTBuf.data()
+            pBuffer
         );
         if (status!= ippStsNoErr){
             throw std::runtime_error("ippsDFTFwd_C_64f failed with error code " + std::to_string(status));
@@ -273,14 +772,23 @@ namespace ipps
 
     // specialization for Ipp32fc
     template <>
-    inline void DFTCToC<Ipp32fc>::fwd(const Ipp32fc* src, Ipp32fc* dst, const Ipp32fc* /*srcIm*/, Ipp32fc* /*dstIm*/)
+    inline void DFTCToCPlan<Ipp32fc>::fwd(const Ipp32fc* src, Ipp32fc* dst, Ipp8u* pBuffer, const Ipp32fc* /*srcIm*/, Ipp32fc* /*dstIm*/) const
     {
+        if (m_fft)
+        {
+            IppStatus status = ippsFFTFwd_CToC_32fc(src, dst, (const IppsFFTSpec_C_32fc*) fft_spec(), pBuffer);
+            if (status != ippStsNoErr){
+                throw std::runtime_error("ippsFFTFwd_CToC_32fc failed with error code " + std::to_string(status));
+            }
+            return;
+        }
+
         // call the IPP specific fwd function for Ipp32fc
         IppStatus status = ippsDFTFwd_CToC_32fc(
             src, 
             dst, // we ignore the srcIm and dstIm parameters (should have been left as nullptr by the user)
             (const IppsDFTSpec_C_32fc*) m_pDFTSpec.data(),
-            m_pDFTBuf.data()
+            pBuffer
         );
         if (status!= ippStsNoErr){
             throw std::runtime_error("ippsDFTFwd_C_32fc failed with error code " + std::to_string(status));
@@ -289,14 +797,23 @@ namespace ipps
 
     // specialization for Ipp64fc
     template <>
-    inline void DFTCToC<Ipp64fc>::fwd(const Ipp64fc* src, Ipp64fc* dst, const Ipp64fc* /*srcIm*/, Ipp64fc* /*dstIm*/)
+    inline void DFTCToCPlan<Ipp64fc>::fwd(const Ipp64fc* src, Ipp64fc* dst, Ipp8u* pBuffer, const Ipp64fc* /*srcIm*/, Ipp64fc* /*dstIm*/) const
     {
+        if (m_fft)
+        {
+            IppStatus status = ippsFFTFwd_CToC_64fc(src, dst, (const IppsFFTSpec_C_64fc*) fft_spec(), pBuffer);
+            if (status != ippStsNoErr){
+                throw std::runtime_error("ippsFFTFwd_CToC_64fc failed with error code " + std::to_string(status));
+            }
+            return;
+        }
+
         // call the IPP specific fwd function for Ipp64fc
         IppStatus status = ippsDFTFwd_CToC_64fc(
             src, 
             dst, // we ignore the srcIm and dstIm parameters (should have been left as nullptr by the user)
             (const IppsDFTSpec_C_64fc*) m_pDFTSpec.data(),
-            m_pDFTBuf.data()
+            pBuffer
         );
         if (status!= ippStsNoErr){
             throw std::runtime_error("ippsDFTFwd_C_64fc failed with error code " + std::to_string(status));
@@ -307,15 +824,24 @@ namespace ipps
     ======================= SPECIALIZATIONS FOR BACKWARD ====================================
     */
     template <typename T>
-    inline void DFTCToC<T>::bwd(const T* /*src*/, T* /*dst*/, const T* /*srcIm*/, T* /*dstIm*/)
+    inline void DFTCToCPlan<T>::bwd(const T* /*src*/, T* /*dst*/, Ipp8u* /*pBuffer*/, const T* /*srcIm*/, T* /*dstIm*/) const
     {
         throw std::domain_error("We should never hit this error. DFTCToC currently only supports 32f, 64f, 32fc and 64fc.");
     }
 
     // specialization for Ipp32f
     template <>
-    inline void DFTCToC<Ipp32f>::bwd(const Ipp32f* src, Ipp32f* dst, const Ipp32f* srcIm, Ipp32f* dstIm)
+    inline void DFTCToCPlan<Ipp32f>::bwd(const Ipp32f* src, Ipp32f* dst, Ipp8u* pBuffer, const Ipp32f* srcIm, Ipp32f* dstIm) const
     {
+        if (m_fft)
+        {
+            IppStatus status = ippsFFTInv_CToC_32f(src, srcIm, dst, dstIm, (const IppsFFTSpec_C_32f*) fft_spec(), pBuffer);
+            if (status != ippStsNoErr){
+                throw std::runtime_error("ippsFFTInv_CToC_32f failed with error code " + std::to_string(status));
+            }
+            return;
+        }
+
         // call the IPP specific bwd function for Ipp32f
         IppStatus status = ippsDFTInv_CToC_32f(
             src, 
@@ -323,7 +849,7 @@ namespace ipps
             dst, 
             dstIm, // this must be supplied for Ipp32f/Ipp64f i.e. the non-complex data types
             (const IppsDFTSpec_C_32f*) m_pDFTSpec.data(),
-            m_pDFTBuf.data()
+            pBuffer
         );
         if (status!= ippStsNoErr){
             throw std::runtime_error("ippsDFTInv_C_32f failed with error code " + std::to_string(status));
@@ -332,8 +858,17 @@ namespace ipps
 
     // specialization for Ipp64f
     template <>
-    inline void DFTCToC<Ipp64f>::bwd(const Ipp64f* src, Ipp64f* dst, const Ipp64f* srcIm, Ipp64f* dstIm)
+    inline void DFTCToCPlan<Ipp64f>::bwd(const Ipp64f* src, Ipp64f* dst, Ipp8u* pBuffer, const Ipp64f* srcIm, Ipp64f* dstIm) const
     {
+        if (m_fft)
+        {
+            IppStatus status = ippsFFTInv_CToC_64f(src, srcIm, dst, dstIm, (const IppsFFTSpec_C_64f*) fft_spec(), pBuffer);
+            if (status != ippStsNoErr){
+                throw std::runtime_error("ippsFFTInv_CToC_64f failed with error code " + std::to_string(status));
+            }
+            return;
+        }
+
         // call the IPP specific bwd function for Ipp64f
         IppStatus status = ippsDFTInv_CToC_64f(
             src, 
@@ -341,7 +876,7 @@ namespace ipps
             dst, 
             dstIm, // this must be supplied for Ipp32f/Ipp64f i.e. the non-complex data types
             (const IppsDFTSpec_C_64f*) m_pDFTSpec.data(),
-            m_pDFTBuf.data()
+            pBuffer
         );
         if (status!= ippStsNoErr){
             throw std::runtime_error("ippsDFTInv_C_64f failed with error code " + std::to_string(status));
@@ -350,14 +885,23 @@ namespace ipps
 
     // specialization for Ipp32fc
     template <>
-    inline void DFTCToC<Ipp32fc>::bwd(const Ipp32fc* src, Ipp32fc* dst, const Ipp32fc* /*srcIm*/, Ipp32fc* /*dstIm*/)
+    inline void DFTCToCPlan<Ipp32fc>::bwd(const Ipp32fc* src, Ipp32fc* dst, Ipp8u* pBuffer, const Ipp32fc* /*srcIm*/, Ipp32fc* /*dstIm*/) const
     {
+        if (m_fft)
+        {
+            IppStatus status = ippsFFTInv_CToC_32fc(src, dst, (const IppsFFTSpec_C_32fc*) fft_spec(), pBuffer);
+            if (status != ippStsNoErr){
+                throw std::runtime_error("ippsFFTInv_CToC_32fc failed with error code " + std::to_string(status));
+            }
+            return;
+        }
+
         // call the IPP specific bwd function for Ipp32fc
         IppStatus status = ippsDFTInv_CToC_32fc(
             src, 
             dst, // we ignore the srcIm and dstIm parameters (should have been left as nullptr by the user)
             (const IppsDFTSpec_C_32fc*) m_pDFTSpec.data(),
-            m_pDFTBuf.data()
+            pBuffer
         );
         if (status!= ippStsNoErr){
             throw std::runtime_error("ippsDFTInv_C_32fc failed with error code " + std::to_string(status));
@@ -366,14 +910,23 @@ namespace ipps
 
     // specialization for Ipp64fc
     template <>
-    inline void DFTCToC<Ipp64fc>::bwd(const Ipp64fc* src, Ipp64fc* dst, const Ipp64fc* /*srcIm*/, Ipp64fc* /*dstIm*/)
+    inline void DFTCToCPlan<Ipp64fc>::bwd(const Ipp64fc* src, Ipp64fc* dst, Ipp8u* pBuffer, const Ipp64fc* /*srcIm*/, Ipp64fc* /*dstIm*/) const
     {
+        if (m_fft)
+        {
+            IppStatus status = ippsFFTInv_CToC_64fc(src, dst, (const IppsFFTSpec_C_64fc*) fft_spec(), pBuffer);
+            if (status != ippStsNoErr){
+                throw std::runtime_error("ippsFFTInv_CToC_64fc failed with error code " + std::to_string(status));
+            }
+            return;
+        }
+
         // call the IPP specific bwd function for Ipp64fc
         IppStatus status = ippsDFTInv_CToC_64fc(
             src, 
             dst, // we ignore the srcIm and dstIm parameters (should have been left as nullptr by the user)
             (const IppsDFTSpec_C_64fc*) m_pDFTSpec.data(),
-            m_pDFTBuf.data()
+            pBuffer
         );
         if (status!= ippStsNoErr){
             throw std::runtime_error("ippsDFTInv_C_64fc failed with error code " + std::to_string(status));
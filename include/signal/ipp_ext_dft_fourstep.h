@@ -0,0 +1,278 @@
+/*
+Four-step (Bailey) DFT for very long complex transforms, spread over a thread pool.
+
+A single DFTCToC call runs on one thread and, for lengths far beyond the cache, is bound by memory
+bandwidth. Writing N = N1 * N2, the length-N DFT becomes N2 DFTs of length N1, a twiddle multiply,
+and N1 DFTs of length N2, with transposes in between so that every sub-DFT works on a contiguous row
+that fits in cache:
+
+    1. transpose the input from N1 x N2 to N2 x N1
+    2. DFT each row (length N1) and multiply element k1 of row n2 by exp(-+2 pi i n2 k1 / N)
+    3. transpose to N1 x N2
+    4. DFT each row (length N2)
+    5. transpose to N2 x N1, which is the output in natural order
+
+The rows of each step, and the tiles of each transpose, are split across the pool. Twiddles are
+generated per row rather than stored, so the only extra memory is one length-N work buffer.
+
+Lengths with no factor pair (primes) fall back to a single DFTCToC.
+
+Example:
+    ipps::DFTFourStep<Ipp32fc> dft(100000000);
+    dft.fwd(x.data(), y.data()); // same as DFTCToC::fwd, on all cores
+*/
+
+#pragma once
+
+#include "ipp.h"
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ipp_ext_vec.h"
+#include "ipp_ext_copy.h"
+#include "ipp_ext_math.h"
+#include "ipp_ext_convert.h"
+#include "ipp_ext_generator.h"
+#include "ipp_ext_dft.h"
+#include "ipp_ext_parallel.h"
+#include "../ipp_ext_errors.h"
+
+namespace ipps
+{
+    namespace detail
+    {
+        /// @brief dst (cols x rows) = transpose of src (rows x cols), in square tiles spread over the pool.
+        /// src and dst must not overlap.
+        template <typename T>
+        inline void transpose_tiled(const T* src, size_t rows, size_t cols, T* dst,
+                                    parallel::ThreadPool& pool = parallel::defaultPool())
+        {
+            // Small enough that a tile of src and of dst both stay in L1
+            const size_t tile = 32;
+            const size_t tileRows = (rows + tile - 1) / tile;
+
+            const parallel::Partition blocks = parallel::partition(tileRows, pool);
+            pool.run(blocks.parts, [&](size_t part){
+                size_t rowEnd = std::min(rows, blocks.end(part) * tile);
+                for (size_t r0 = blocks.begin(part) * tile; r0 < rowEnd; r0 += tile)
+                {
+                    size_t r1 = std::min(r0 + tile, rows);
+                    for (size_t c0 = 0; c0 < cols; c0 += tile)
+                    {
+                        size_t c1 = std::min(c0 + tile, cols);
+                        for (size_t r = r0; r < r1; r++)
+                            for (size_t c = c0; c < c1; c++)
+                                dst[c * rows + r] = src[r * cols + c];
+                    }
+                }
+            });
+        }
+
+        // row *= twiddles, where the twiddles were generated in double precision
+        inline void apply_twiddles(const Ipp64fc* tw, Ipp64fc* row, int len, Ipp64fc* /*scratch*/)
+        {
+            math::Mul_I(tw, row, len);
+        }
+
+        inline void apply_twiddles(const Ipp64fc* tw, Ipp32fc* row, int len, Ipp32fc* scratch)
+        {
+            convert::Convert(reinterpret_cast<const Ipp64f*>(tw), reinterpret_cast<Ipp32f*>(scratch), 2 * len);
+            math::Mul_I(scratch, row, len);
+        }
+    }
+
+    /// @brief Length-N complex DFT computed as N1 x N2 sub-DFTs over a thread pool, for 32fc/64fc.
+    /// Gives the same results as DFTCToC (up to rounding) for the same length and flag.
+    template <typename T>
+    class DFTFourStep
+    {
+    public:
+        typedef DFTCToCPlan<T> plan_type;
+
+        DFTFourStep()
+        {}
+
+        /// @param length DFT length.
+        /// @param flag Normalisation, as for DFTCToC; the sub-DFTs' factors multiply to the same overall scale.
+        /// @param rows N1, a divisor of length. 0 picks the largest divisor not above sqrt(length).
+        DFTFourStep(size_t length, int flag = IPP_FFT_DIV_INV_BY_N, size_t rows = 0)
+            : m_length{length}, m_flag{flag}
+        {
+            if (length == 0)
+                throw std::invalid_argument("DFTFourStep: length cannot be 0");
+            if (rows == 0)
+                rows = chooseRows(length);
+            if (length % rows != 0)
+                throw std::invalid_argument("DFTFourStep: rows " + std::to_string(rows) +
+                    " must divide the length " + std::to_string(length));
+
+            m_rows = rows;
+            m_cols = length / rows;
+            if (m_rows == 1 || m_cols == 1)
+            {
+                // Nothing to split; a single transform it is
+                m_direct = DFTCToC<T>(plan_type::cached(length, flag));
+                m_rows = 1;
+                m_cols = length;
+                return;
+            }
+
+            m_rowPlan = plan_type::cached(m_rows, flag);
+            m_colPlan = plan_type::cached(m_cols, flag);
+            m_work.resize(length);
+        }
+
+        /// @brief Forward DFT of getLength() samples. src and dst may be the same.
+        void fwd(const T* src, T* dst, parallel::ThreadPool& pool = parallel::defaultPool())
+        {
+            run(src, dst, pool, true);
+        }
+
+        /// @brief Backward DFT of getLength() samples. src and dst may be the same.
+        void bwd(const T* src, T* dst, parallel::ThreadPool& pool = parallel::defaultPool())
+        {
+            run(src, dst, pool, false);
+        }
+
+        size_t getLength() const { return m_length; }
+        int getFlag() const { return m_flag; }
+        /// @brief N1, the length of the first set of sub-DFTs (1 if the length could not be split).
+        size_t getRows() const { return m_rows; }
+        /// @brief N2, the length of the second set of sub-DFTs.
+        size_t getColumns() const { return m_cols; }
+
+        /// @brief The largest divisor of length that is not above sqrt(length), i.e. the most square split.
+        static size_t chooseRows(size_t length)
+        {
+            size_t best = 1;
+            for (size_t d = 2; d * d <= length; d++)
+                if (length % d == 0)
+                    best = d;
+            return best;
+        }
+
+    private:
+        size_t m_length = 0;
+        int m_flag = IPP_FFT_DIV_INV_BY_N;
+        size_t m_rows = 0; // N1
+        size_t m_cols = 0; // N2
+        DFTCToC<T> m_direct; // only when the length can't be split
+        std::shared_ptr<const plan_type> m_rowPlan;
+        std::shared_ptr<const plan_type> m_colPlan;
+        vector<T> m_work;
+
+        // Per-task scratch, see parallel::prepareTasks
+        struct Workspace
+        {
+            vector<Ipp8u> dftBuf;
+            vector<Ipp64fc> twiddles;
+            vector<T> converted;
+        };
+        std::vector<Workspace> m_tasks;
+
+        void run(const T* src, T* dst, parallel::ThreadPool& pool, bool forward)
+        {
+            if (m_length == 0)
+                throw std::runtime_error("DFTFourStep: no plan, construct with a length first");
+
+            if (m_direct.getLength() > 0)
+            {
+                if (forward)
+                    m_direct.fwd(src, dst);
+                else
+                    m_direct.bwd(src, dst);
+                return;
+            }
+
+            prepare_tasks(pool.size());
+
+            // Out of place, the first transpose can go straight to dst. In-place, dst is still the input,
+            // so start in the work buffer and finish with a copy instead.
+            bool inPlace = src == dst;
+            T* stage1 = inPlace ? m_work.data() : dst;
+            T* stage2 = inPlace ? dst : m_work.data();
+
+            detail::transpose_tiled(src, m_rows, m_cols, stage1, pool); // now N2 x N1
+            rows_with_twiddles(stage1, pool, forward);
+            detail::transpose_tiled(stage1, m_cols, m_rows, stage2, pool); // now N1 x N2
+            rows(stage2, m_cols, m_rows, *m_colPlan, pool, forward);
+
+            if (inPlace)
+            {
+                detail::transpose_tiled(stage2, m_rows, m_cols, m_work.data(), pool);
+                T* work = m_work.data();
+                parallel::forEachRange<T>(m_length, [&](size_t offset, size_t count){
+                    Copy(work + offset, dst + offset, (int)count);
+                }, pool);
+            }
+            else
+            {
+                detail::transpose_tiled(stage2, m_rows, m_cols, dst, pool);
+            }
+        }
+
+        void prepare_tasks(size_t numTasks)
+        {
+            size_t bufferSize = std::max(m_rowPlan->getBufferSize(), m_colPlan->getBufferSize());
+            parallel::prepareTasks(m_tasks, numTasks, [&](Workspace& w){
+                if (w.dftBuf.size() < bufferSize)
+                    w.dftBuf.resize(bufferSize);
+                if (w.twiddles.size() < m_rows)
+                {
+                    w.twiddles.resize(m_rows);
+                    w.converted.resize(m_rows);
+                }
+            });
+        }
+
+        // Splits count rows into contiguous blocks, calling f(task, row) for each row
+        template <typename F>
+        void for_rows(size_t count, parallel::ThreadPool& pool, F f)
+        {
+            const parallel::Partition blocks = parallel::partition(count, pool);
+            pool.run(blocks.parts, [&](size_t part){
+                for (size_t r = blocks.begin(part); r < blocks.end(part); r++)
+                    f(part, r);
+            });
+        }
+
+        // Step 2: length-N1 DFTs on the N2 rows of data, each followed by its twiddles while still in cache
+        void rows_with_twiddles(T* data, parallel::ThreadPool& pool, bool forward)
+        {
+            const plan_type& p = *m_rowPlan;
+            const size_t n1 = m_rows;
+            const double length = (double)m_length;
+            for_rows(m_cols, pool, [&](size_t task, size_t n2){
+                Workspace& w = m_tasks[task];
+                T* row = data + n2 * n1;
+                if (forward)
+                    p.fwd(row, row, w.dftBuf.data());
+                else
+                    p.bwd(row, row, w.dftBuf.data());
+
+                if (n2 == 0)
+                    return; // all ones
+
+                // exp(-+2 pi i n2 k1 / N) as a unit tone; Tone wants a frequency in [0, 1)
+                Ipp64f freq = forward ? 1.0 - (double)n2 / length : (double)n2 / length;
+                Ipp64f phase = 0;
+                generator::Tone(w.twiddles.data(), (int)n1, (Ipp64f)1.0, freq, &phase, ippAlgHintAccurate);
+                detail::apply_twiddles(w.twiddles.data(), row, (int)n1, w.converted.data());
+            });
+        }
+
+        // Step 4: length-N2 DFTs on the N1 rows of data
+        void rows(T* data, size_t length, size_t count, const plan_type& p, parallel::ThreadPool& pool, bool forward)
+        {
+            for_rows(count, pool, [&](size_t task, size_t r){
+                T* row = data + r * length;
+                if (forward)
+                    p.fwd(row, row, m_tasks[task].dftBuf.data());
+                else
+                    p.bwd(row, row, m_tasks[task].dftBuf.data());
+            });
+        }
+    };
+}
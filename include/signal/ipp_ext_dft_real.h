@@ -0,0 +1,397 @@
+/*
+Real-input DFTs, avoiding the promotion to complex (and the doubled memory and compute) of DFTCToC.
+
+A real signal of length N has a conjugate-symmetric spectrum, so IPP only returns the non-redundant half,
+in one of three layouts (R/I are the real/imaginary parts of bin k):
+- CCS:  R0, 0, R1, I1, ..., R(N/2), I(N/2)         N+2 values for even N, N+1 for odd N
+- Pack: R0, R1, I1, ..., R(N/2-1), I(N/2-1), R(N/2) N values (the last bin only for even N)
+- Perm: R0, R(N/2), R1, I1, ..., R(N/2-1), I(N/2-1) N values (same as Pack for odd N)
+
+CCS can be read directly as N/2+1 complex values. Use toComplex()/fwdComplex() to expand to all N bins
+only when the full spectrum is actually needed.
+
+As with DFTCToC, the spec lives in a read-only DFTRToCPlan which can be shared between threads
+(and fetched from ippe::plancache via DFTRToCPlan::cached()); the executors only own a work buffer.
+
+Example:
+    ipps::DFTRToCCS<Ipp32f> dft(1000);
+    ipps::vector<Ipp32f> x(1000), spectrum(dft.getSpectrumLength());
+    dft.fwd(x.data(), spectrum.data());
+*/
+
+#pragma once
+
+#include "ipp.h"
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "ipp_ext_vec.h"
+#include "ipp_ext_convert.h"
+#include "../ipp_ext_errors.h"
+#include "../ipp_ext_plancache.h"
+
+namespace ipps
+{
+    /// @brief Output layouts of the real DFT (see the top of this file).
+    enum class RealDFTFormat
+    {
+        CCS,
+        Pack,
+        Perm
+    };
+
+    namespace detail
+    {
+        template <typename T>
+        struct real_dft_complex;
+
+        template <>
+        struct real_dft_complex<Ipp32f> { typedef Ipp32fc type; };
+
+        template <>
+        struct real_dft_complex<Ipp64f> { typedef Ipp64fc type; };
+
+        // The reverse mapping, from a complex type to its parts
+        template <typename T>
+        struct complex_real;
+
+        template <>
+        struct complex_real<Ipp32fc> { typedef Ipp32f type; };
+
+        template <>
+        struct complex_real<Ipp64fc> { typedef Ipp64f type; };
+    }
+
+    /// @brief Read-only real DFT spec for a given length and flag, for 32f/64f. Safe to share between threads;
+    /// each caller supplies its own work buffer of getBufferSize() bytes. The same plan serves all three formats.
+    template <typename T>
+    class DFTRToCPlan
+    {
+        public:
+            DFTRToCPlan(size_t length, int flag = IPP_FFT_DIV_INV_BY_N)
+                : m_length{length}, m_flag{flag}
+            {
+                if (m_length == 0)
+                {
+                    throw std::invalid_argument("DFTRToC: length cannot be 0");
+                }
+                prepare_dft();
+            }
+
+            /// @brief Returns a shared plan from ippe::plancache, building and caching it on a miss.
+            static std::shared_ptr<const DFTRToCPlan> cached(size_t length, int flag = IPP_FFT_DIV_INV_BY_N)
+            {
+                return ippe::plancache::get<DFTRToCPlan>(
+                    ippe::plancache::makeKey<DFTRToCPlan>(length, 0, flag),
+                    [length, flag](){ return std::make_shared<const DFTRToCPlan>(length, flag); }
+                );
+            }
+
+            /// @brief Runs the forward DFT from getLength() reals into the given format.
+            /// @param pBuffer Work buffer of at least getBufferSize() bytes, not in use by any other thread.
+            void fwd(const T* src, T* dst, RealDFTFormat format, Ipp8u* pBuffer) const;
+
+            /// @brief Runs the inverse DFT from the given format back to getLength() reals.
+            /// @param pBuffer Work buffer of at least getBufferSize() bytes, not in use by any other thread.
+            void inv(const T* src, T* dst, RealDFTFormat format, Ipp8u* pBuffer) const;
+
+            // Some getters
+            size_t getLength() const { return m_length; }
+            int getFlag() const { return m_flag; }
+            size_t getBufferSize() const { return (size_t)m_SizeBuf; }
+            const vector<Ipp8u>& getDFTSpec() const { return m_pDFTSpec; }
+            /// @brief Bytes held by the plan itself (not including any work buffers).
+            size_t getMemoryBytes() const { return m_pDFTSpec.size(); }
+
+        private:
+            size_t m_length;
+            int m_flag;
+            int m_SizeSpec;
+            int m_SizeInit;
+            int m_SizeBuf;
+
+            vector<Ipp8u> m_pDFTSpec;
+
+            // the constructor will call this, and this will contain the specializations
+            void prepare_dft();
+    };
+
+    /// @brief Real-input DFT executor, writing the spectrum in the given format.
+    /// @tparam T Ipp32f or Ipp64f.
+    template <typename T, RealDFTFormat F>
+    class DFTRToC
+    {
+        public:
+            typedef DFTRToCPlan<T> plan_type;
+            typedef typename detail::real_dft_complex<T>::type complex_type;
+
+            // Constructors
+            DFTRToC()
+            {
+
+            }
+
+            DFTRToC(size_t length, int flag = IPP_FFT_DIV_INV_BY_N)
+                : DFTRToC(std::make_shared<const plan_type>(length, flag))
+            {
+
+            }
+
+            /// @brief Creates an executor for an existing plan, only allocating a work buffer.
+            explicit DFTRToC(std::shared_ptr<const plan_type> plan)
+                : m_plan{std::move(plan)}
+            {
+                if (!m_plan)
+                    throw std::invalid_argument("DFTRToC: plan cannot be null");
+                m_pDFTBuf.resize(m_plan->getBufferSize());
+            }
+
+            /// @brief Runs the forward DFT.
+            /// @param src getLength() reals
+            /// @param dst getSpectrumLength() reals, in this executor's format
+            void fwd(const T* src, T* dst)
+            {
+                plan().fwd(src, dst, F, m_pDFTBuf.data());
+            }
+
+            /// @brief Runs the backward DFT.
+            /// @param src getSpectrumLength() reals, in this executor's format
+            /// @param dst getLength() reals
+            void bwd(const T* src, T* dst)
+            {
+                plan().inv(src, dst, F, m_pDFTBuf.data());
+            }
+
+            // Alias for bwd (since Inv is the name given by IPP)
+            void inv(const T* src, T* dst)
+            {
+                bwd(src, dst);
+            }
+
+            /// @brief Expands a spectrum in this executor's format into all getLength() complex bins.
+            /// @param spectrum Output of fwd(); must not overlap full
+            /// @param full getLength() complex values
+            void toComplex(const T* spectrum, complex_type* full) const
+            {
+                const size_t length = getLength();
+                T* ccs = reinterpret_cast<T*>(full); // 2*length reals, enough room for the CCS layout
+
+                // Rearrange into CCS within the output, then mirror
+                if (F == RealDFTFormat::CCS)
+                {
+                    std::memcpy(ccs, spectrum, getSpectrumLength() * sizeof(T));
+                }
+                else
+                {
+                    ccs[0] = spectrum[0];
+                    ccs[1] = 0;
+                    if (F == RealDFTFormat::Perm && length % 2 == 0)
+                    {
+                        // Perm keeps the Nyquist bin in the second slot
+                        std::memcpy(ccs + 2, spectrum + 2, (length - 2) * sizeof(T));
+                        ccs[length] = spectrum[1];
+                    }
+                    else // Pack, or Perm for odd lengths, which is the same
+                    {
+                        std::memcpy(ccs + 2, spectrum + 1, (length - 1) * sizeof(T));
+                    }
+                    if (length % 2 == 0)
+                        ccs[length + 1] = 0;
+                }
+                mirror(full, length);
+            }
+
+            /// @brief Runs the forward DFT and returns all getLength() complex bins.
+            /// This always computes CCS directly into full, so no extra buffer is needed.
+            void fwdComplex(const T* src, complex_type* full)
+            {
+                plan().fwd(src, reinterpret_cast<T*>(full), RealDFTFormat::CCS, m_pDFTBuf.data());
+                mirror(full, getLength());
+            }
+
+            /// @brief Number of reals written by fwd() (and read by bwd()).
+            size_t getSpectrumLength() const
+            {
+                return F == RealDFTFormat::CCS ? 2 * (getLength() / 2 + 1) : getLength();
+            }
+
+            // Some getters
+            size_t getLength() const { return m_plan ? m_plan->getLength() : 0; }
+            int getFlag() const { return m_plan ? m_plan->getFlag() : IPP_FFT_DIV_INV_BY_N; }
+            const vector<Ipp8u>& getDFTBuf() const { return m_pDFTBuf; }
+            /// @brief The (possibly shared) plan, to construct other executors from.
+            const std::shared_ptr<const plan_type>& getPlan() const { return m_plan; }
+
+        private:
+            std::shared_ptr<const plan_type> m_plan;
+            vector<Ipp8u> m_pDFTBuf;
+
+            const plan_type& plan() const
+            {
+                if (!m_plan)
+                    throw std::runtime_error("DFTRToC: no plan, construct with a length first");
+                return *m_plan;
+            }
+
+            // Fills bins N/2+1 .. N-1 from the conjugates of bins N/2-1 .. 1
+            static void mirror(complex_type* full, size_t length)
+            {
+                size_t upper = length - length / 2 - 1;
+                if (upper > 0)
+                    convert::ConjFlip(full + 1, full + length / 2 + 1, (int)upper);
+            }
+    };
+
+    template <typename T>
+    using DFTRToCCS = DFTRToC<T, RealDFTFormat::CCS>;
+
+    template <typename T>
+    using DFTRToPack = DFTRToC<T, RealDFTFormat::Pack>;
+
+    template <typename T>
+    using DFTRToPerm = DFTRToC<T, RealDFTFormat::Perm>;
+
+    /*
+    ==================== SPECIALIZATIONS FOR PREPARE ====================================
+    */
+    template <typename T>
+    inline void DFTRToCPlan<T>::prepare_dft()
+    {
+        throw std::domain_error("No constructor for this type. DFTRToC currently only supports 32f and 64f.");
+    }
+
+    // specialization for Ipp32f
+    template <>
+    inline void DFTRToCPlan<Ipp32f>::prepare_dft()
+    {
+        IPP_NO_ERROR(
+            ippsDFTGetSize_R_32f((int)m_length, m_flag, ippAlgHintNone, &m_SizeSpec, &m_SizeInit, &m_SizeBuf),
+            "ippsDFTGetSize_R_32f"
+        );
+
+        m_pDFTSpec.resize(m_SizeSpec);
+        // Only needed during the init
+        vector<Ipp8u> memInit(m_SizeInit);
+
+        IPP_NO_ERROR(
+            ippsDFTInit_R_32f((int)m_length, m_flag, ippAlgHintNone,
+                (IppsDFTSpec_R_32f*) m_pDFTSpec.data(), memInit.data()),
+            "ippsDFTInit_R_32f"
+        );
+    }
+
+    // specialization for Ipp64f
+    template <>
+    inline void DFTRToCPlan<Ipp64f>::prepare_dft()
+    {
+        IPP_NO_ERROR(
+            ippsDFTGetSize_R_64f((int)m_length, m_flag, ippAlgHintNone, &m_SizeSpec, &m_SizeInit, &m_SizeBuf),
+            "ippsDFTGetSize_R_64f"
+        );
+
+        m_pDFTSpec.resize(m_SizeSpec);
+        // Only needed during the init
+        vector<Ipp8u> memInit(m_SizeInit);
+
+        IPP_NO_ERROR(
+            ippsDFTInit_R_64f((int)m_length, m_flag, ippAlgHintNone,
+                (IppsDFTSpec_R_64f*) m_pDFTSpec.data(), memInit.data()),
+            "ippsDFTInit_R_64f"
+        );
+    }
+
+    /*
+    ======================= SPECIALIZATIONS FOR FORWARD ====================================
+    */
+    template <typename T>
+    inline void DFTRToCPlan<T>::fwd(const T* /*src*/, T* /*dst*/, RealDFTFormat /*format*/, Ipp8u* /*pBuffer*/) const
+    {
+        throw std::domain_error("We should never hit this error. DFTRToC currently only supports 32f and 64f.");
+    }
+
+    // specialization for Ipp32f
+    template <>
+    inline void DFTRToCPlan<Ipp32f>::fwd(const Ipp32f* src, Ipp32f* dst, RealDFTFormat format, Ipp8u* pBuffer) const
+    {
+        const IppsDFTSpec_R_32f* spec = (const IppsDFTSpec_R_32f*) m_pDFTSpec.data();
+        switch (format)
+        {
+            case RealDFTFormat::CCS:
+                IPP_NO_ERROR(ippsDFTFwd_RToCCS_32f(src, dst, spec, pBuffer), "ippsDFTFwd_RToCCS_32f");
+                break;
+            case RealDFTFormat::Pack:
+                IPP_NO_ERROR(ippsDFTFwd_RToPack_32f(src, dst, spec, pBuffer), "ippsDFTFwd_RToPack_32f");
+                break;
+            case RealDFTFormat::Perm:
+                IPP_NO_ERROR(ippsDFTFwd_RToPerm_32f(src, dst, spec, pBuffer), "ippsDFTFwd_RToPerm_32f");
+                break;
+        }
+    }
+
+    // specialization for Ipp64f
+    template <>
+    inline void DFTRToCPlan<Ipp64f>::fwd(const Ipp64f* src, Ipp64f* dst, RealDFTFormat format, Ipp8u* pBuffer) const
+    {
+        const IppsDFTSpec_R_64f* spec = (const IppsDFTSpec_R_64f*) m_pDFTSpec.data();
+        switch (format)
+        {
+            case RealDFTFormat::CCS:
+                IPP_NO_ERROR(ippsDFTFwd_RToCCS_64f(src, dst, spec, pBuffer), "ippsDFTFwd_RToCCS_64f");
+                break;
+            case RealDFTFormat::Pack:
+                IPP_NO_ERROR(ippsDFTFwd_RToPack_64f(src, dst, spec, pBuffer), "ippsDFTFwd_RToPack_64f");
+                break;
+            case RealDFTFormat::Perm:
+                IPP_NO_ERROR(ippsDFTFwd_RToPerm_64f(src, dst, spec, pBuffer), "ippsDFTFwd_RToPerm_64f");
+                break;
+        }
+    }
+
+    /*
+    ======================= SPECIALIZATIONS FOR INVERSE ====================================
+    */
+    template <typename T>
+    inline void DFTRToCPlan<T>::inv(const T* /*src*/, T* /*dst*/, RealDFTFormat /*format*/, Ipp8u* /*pBuffer*/) const
+    {
+        throw std::domain_error("We should never hit this error. DFTRToC currently only supports 32f and 64f.");
+    }
+
+    // specialization for Ipp32f
+    template <>
+    inline void DFTRToCPlan<Ipp32f>::inv(const Ipp32f* src, Ipp32f* dst, RealDFTFormat format, Ipp8u* pBuffer) const
+    {
+        const IppsDFTSpec_R_32f* spec = (const IppsDFTSpec_R_32f*) m_pDFTSpec.data();
+        switch (format)
+        {
+            case RealDFTFormat::CCS:
+                IPP_NO_ERROR(ippsDFTInv_CCSToR_32f(src, dst, spec, pBuffer), "ippsDFTInv_CCSToR_32f");
+                break;
+            case RealDFTFormat::Pack:
+                IPP_NO_ERROR(ippsDFTInv_PackToR_32f(src, dst, spec, pBuffer), "ippsDFTInv_PackToR_32f");
+                break;
+            case RealDFTFormat::Perm:
+                IPP_NO_ERROR(ippsDFTInv_PermToR_32f(src, dst, spec, pBuffer), "ippsDFTInv_PermToR_32f");
+                break;
+        }
+    }
+
+    // specialization for Ipp64f
+    template <>
+    inline void DFTRToCPlan<Ipp64f>::inv(const Ipp64f* src, Ipp64f* dst, RealDFTFormat format, Ipp8u* pBuffer) const
+    {
+        const IppsDFTSpec_R_64f* spec = (const IppsDFTSpec_R_64f*) m_pDFTSpec.data();
+        switch (format)
+        {
+            case RealDFTFormat::CCS:
+                IPP_NO_ERROR(ippsDFTInv_CCSToR_64f(src, dst, spec, pBuffer), "ippsDFTInv_CCSToR_64f");
+                break;
+            case RealDFTFormat::Pack:
+                IPP_NO_ERROR(ippsDFTInv_PackToR_64f(src, dst, spec, pBuffer), "ippsDFTInv_PackToR_64f");
+                break;
+            case RealDFTFormat::Perm:
+                IPP_NO_ERROR(ippsDFTInv_PermToR_64f(src, dst, spec, pBuffer), "ippsDFTInv_PermToR_64f");
+                break;
+        }
+    }
+}
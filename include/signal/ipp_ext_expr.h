@@ -0,0 +1,449 @@
+/*
+Lazy elementwise expressions on ipps::vector.
+
+Arithmetic on vectors builds a small expression tree instead of computing anything.
+The tree is only evaluated when it is assigned to a vector (or matrix), and then in tiles
+of EXPR_TILE_BYTES, so that intermediate results stay in L1/L2 instead of being written out
+as full-length temporaries. Each tile is computed with the usual math:: kernels, and a sum
+with a product on either side becomes an AddProduct into the output tile.
+
+Example:
+    ipps::vector<Ipp32f> a(n), b(n), c(n), d(n);
+    ipps::vector<Ipp32f> z = a * b + c * d; // per tile: Mul(a, b) -> z, AddProduct(c, d) -> z
+    z = z * 0.5f - a;                       // the destination may appear in the expression
+
+Matrices don't take part implicitly (their operator* is a matrix product), but can be used
+elementwise by wrapping them with ipps::lazy():
+    m3 = ipps::lazy(m1) * ipps::lazy(m2); // elementwise, m3 keeps its dimensions
+
+Note that, as with any expression template, the tree refers to its operands;
+don't store it (e.g. with auto) beyond the lifetime of the vectors it uses.
+*/
+
+#pragma once
+
+#include "ipp.h"
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "ipp_ext_vec.h"
+#include "ipp_ext_view.h"
+#include "ipp_ext_math.h"
+#include "ipp_ext_copy.h"
+
+namespace ipps
+{
+    // Tile size used when evaluating expressions
+    const size_t EXPR_TILE_BYTES = 8192;
+
+    /// @brief CRTP base of all expression nodes.
+    template <typename E>
+    struct expression
+    {
+        const E& derived() const { return static_cast<const E&>(*this); }
+        size_t size() const { return derived().size(); }
+    };
+
+    namespace expr
+    {
+        template <typename T>
+        struct tile
+        {
+            enum { value = EXPR_TILE_BYTES / sizeof(T) > 0 ? EXPR_TILE_BYTES / sizeof(T) : 1 };
+        };
+
+        // Number of scratch tiles needed to get a pointer to node N's values for a tile
+        template <typename N>
+        struct operand_temps
+        {
+            enum { value = N::is_leaf ? 0 : 1 + N::temps };
+        };
+
+        // AddProduct only exists for these, so the fused sum of products is restricted to them
+        template <typename T> struct has_add_product : std::false_type {};
+        template <> struct has_add_product<Ipp32f> : std::true_type {};
+        template <> struct has_add_product<Ipp64f> : std::true_type {};
+        template <> struct has_add_product<Ipp32fc> : std::true_type {};
+        template <> struct has_add_product<Ipp64fc> : std::true_type {};
+
+        // Base for the non-leaf nodes; evaluates the whole tree into a destination, tile by tile
+        template <typename E, typename T>
+        struct node : expression<E>
+        {
+            typedef T value_type;
+            enum { is_leaf = 0 };
+
+            /// @brief Returns a pointer to this node's values for a tile, evaluating into scratch.
+            const T* operand(size_t offset, int len, T* scratch) const
+            {
+                this->derived().evalInto(offset, len, scratch, scratch + tile<T>::value);
+                return scratch;
+            }
+
+            void evaluate(T* dst, size_t length) const
+            {
+                const E& e = this->derived();
+                if (e.size() != length)
+                    throw std::invalid_argument("expression: size " + std::to_string(e.size()) +
+                        " does not match destination size " + std::to_string(length));
+
+                const size_t tileLen = tile<T>::value;
+                // If the destination is also an operand, a tile could be overwritten before it is read,
+                // so each tile is then computed in scratch first
+                const bool alias = e.aliases(dst, dst + length);
+
+                alignas(64) T scratch[(E::temps + 1) * tile<T>::value];
+                T* aliasTile = scratch + E::temps * tileLen;
+
+                for (size_t offset = 0; offset < length; offset += tileLen)
+                {
+                    int len = (int)(length - offset < tileLen ? length - offset : tileLen);
+                    if (alias)
+                    {
+                        e.evalInto(offset, len, aliasTile, scratch);
+                        Copy(aliasTile, dst + offset, len);
+                    }
+                    else
+                    {
+                        e.evalInto(offset, len, dst + offset, scratch);
+                    }
+                }
+            }
+        };
+
+        /// @brief Leaf node, referring to existing contiguous memory.
+        template <typename T>
+        struct leaf : expression<leaf<T> >
+        {
+            typedef T value_type;
+            enum { is_leaf = 1, temps = 0 };
+
+            leaf(const T* data, size_t size) : m_data(data), m_size(size) {}
+
+            size_t size() const { return m_size; }
+
+            const T* operand(size_t offset, int /*len*/, T* /*scratch*/) const { return m_data + offset; }
+
+            void evalInto(size_t offset, int len, T* out, T* /*scratch*/) const
+            {
+                Copy(m_data + offset, out, len);
+            }
+
+            bool aliases(const T* begin, const T* end) const
+            {
+                return m_data < end && begin < m_data + m_size;
+            }
+
+            void evaluate(T* dst, size_t length) const
+            {
+                if (length != m_size)
+                    throw std::invalid_argument("expression: size " + std::to_string(m_size) +
+                        " does not match destination size " + std::to_string(length));
+                if (dst != m_data && length > 0)
+                    Copy(m_data, dst, length);
+            }
+
+        private:
+            const T* m_data;
+            size_t m_size;
+        };
+
+        // Kernels. Note the reversed operand order of the IPP Sub and Div.
+        struct add_op
+        {
+            template <typename T>
+            static void apply(const T* a, const T* b, T* out, int len) { math::Add(a, b, out, len); }
+        };
+        struct sub_op
+        {
+            template <typename T>
+            static void apply(const T* a, const T* b, T* out, int len) { math::Sub(b, a, out, len); }
+        };
+        struct mul_op
+        {
+            template <typename T>
+            static void apply(const T* a, const T* b, T* out, int len) { math::Mul(a, b, out, len); }
+        };
+        struct div_op
+        {
+            template <typename T>
+            static void apply(const T* a, const T* b, T* out, int len) { math::Div(b, a, out, len); }
+        };
+
+        template <typename Op, typename L, typename R>
+        struct binary;
+
+        template <typename N>
+        struct is_product : std::false_type {};
+        template <typename L, typename R>
+        struct is_product<binary<mul_op, L, R> > : std::true_type {};
+
+        // How a sum is evaluated: 0 plainly, 1 as lhs + product on the right, 2 as product on the left + rhs
+        template <typename Op, typename L, typename R>
+        struct fusion
+        {
+            enum {
+                value = !std::is_same<Op, add_op>::value || !has_add_product<typename L::value_type>::value ? 0 :
+                        is_product<R>::value ? 1 :
+                        is_product<L>::value ? 2 : 0
+            };
+        };
+
+        template <int A, int B>
+        struct max_of { enum { value = A > B ? A : B }; };
+
+        template <typename Op, typename L, typename R, int F = fusion<Op, L, R>::value>
+        struct binary_temps
+        {
+            enum { value = operand_temps<L>::value + operand_temps<R>::value };
+        };
+        template <typename Op, typename L, typename R>
+        struct binary_temps<Op, L, R, 1>
+        {
+            enum { value = max_of<L::temps, operand_temps<typename R::lhs_type>::value + operand_temps<typename R::rhs_type>::value>::value };
+        };
+        template <typename Op, typename L, typename R>
+        struct binary_temps<Op, L, R, 2>
+        {
+            enum { value = max_of<R::temps, operand_temps<typename L::lhs_type>::value + operand_temps<typename L::rhs_type>::value>::value };
+        };
+
+        /// @brief Elementwise operation on two nodes of the same size.
+        template <typename Op, typename L, typename R>
+        struct binary : node<binary<Op, L, R>, typename L::value_type>
+        {
+            typedef typename L::value_type T;
+            typedef L lhs_type;
+            typedef R rhs_type;
+            enum { temps = binary_temps<Op, L, R>::value };
+
+            static_assert(std::is_same<T, typename R::value_type>::value, "Expression operands must have the same type");
+
+            binary(const L& lhs, const R& rhs) : m_lhs(lhs), m_rhs(rhs)
+            {
+                if (lhs.size() != rhs.size())
+                    throw std::invalid_argument("expression: operand sizes do not match (" +
+                        std::to_string(lhs.size()) + " vs " + std::to_string(rhs.size()) + ")");
+            }
+
+            size_t size() const { return m_lhs.size(); }
+            const L& lhs() const { return m_lhs; }
+            const R& rhs() const { return m_rhs; }
+
+            bool aliases(const T* begin, const T* end) const
+            {
+                return m_lhs.aliases(begin, end) || m_rhs.aliases(begin, end);
+            }
+
+            void evalInto(size_t offset, int len, T* out, T* scratch) const
+            {
+                evalInto(offset, len, out, scratch, std::integral_constant<int, fusion<Op, L, R>::value>());
+            }
+
+        private:
+            L m_lhs;
+            R m_rhs;
+
+            void evalInto(size_t offset, int len, T* out, T* scratch, std::integral_constant<int, 0>) const
+            {
+                const T* a = m_lhs.operand(offset, len, scratch);
+                const T* b = m_rhs.operand(offset, len, scratch + operand_temps<L>::value * tile<T>::value);
+                Op::apply(a, b, out, len);
+            }
+
+            // lhs + (c * d): evaluate lhs straight into the output, then accumulate the product
+            void evalInto(size_t offset, int len, T* out, T* scratch, std::integral_constant<int, 1>) const
+            {
+                m_lhs.evalInto(offset, len, out, scratch);
+                accumulateProduct(m_rhs, offset, len, out, scratch);
+            }
+
+            // (c * d) + rhs
+            void evalInto(size_t offset, int len, T* out, T* scratch, std::integral_constant<int, 2>) const
+            {
+                m_rhs.evalInto(offset, len, out, scratch);
+                accumulateProduct(m_lhs, offset, len, out, scratch);
+            }
+
+            template <typename P>
+            static void accumulateProduct(const P& product, size_t offset, int len, T* out, T* scratch)
+            {
+                const T* c = product.lhs().operand(offset, len, scratch);
+                const T* d = product.rhs().operand(offset, len,
+                    scratch + operand_temps<typename P::lhs_type>::value * tile<T>::value);
+                math::AddProduct(c, d, out, len);
+            }
+        };
+
+        struct addc_op
+        {
+            template <typename T>
+            static void apply(const T* a, const T val, T* out, int len) { math::AddC(a, val, out, len); }
+        };
+        struct subc_op
+        {
+            template <typename T>
+            static void apply(const T* a, const T val, T* out, int len) { math::SubC(a, val, out, len); }
+        };
+        struct mulc_op
+        {
+            template <typename T>
+            static void apply(const T* a, const T val, T* out, int len) { math::MulC(a, val, out, len); }
+        };
+
+        /// @brief Elementwise operation between a node and a constant.
+        template <typename Op, typename L>
+        struct scalar : node<scalar<Op, L>, typename L::value_type>
+        {
+            typedef typename L::value_type T;
+            enum { temps = operand_temps<L>::value };
+
+            scalar(const L& lhs, const T& val) : m_lhs(lhs), m_val(val) {}
+
+            size_t size() const { return m_lhs.size(); }
+
+            bool aliases(const T* begin, const T* end) const { return m_lhs.aliases(begin, end); }
+
+            void evalInto(size_t offset, int len, T* out, T* scratch) const
+            {
+                Op::apply(m_lhs.operand(offset, len, scratch), m_val, out, len);
+            }
+
+        private:
+            L m_lhs;
+            T m_val;
+        };
+
+        // Maps the things that may appear in an expression to their nodes.
+        // Only ipps::vector itself is picked up implicitly; see lazy() for anything else.
+        template <typename A, typename Enable = void>
+        struct operand_traits
+        {
+            enum { valid = 0 };
+        };
+
+        template <typename T>
+        struct operand_traits<vector<T>, void>
+        {
+            enum { valid = 1 };
+            typedef leaf<T> type;
+            static type wrap(const vector<T>& v) { return type(v.data(), v.size()); }
+        };
+
+        template <typename E>
+        struct operand_traits<E, typename std::enable_if<std::is_base_of<expression<E>, E>::value>::type>
+        {
+            enum { valid = 1 };
+            typedef E type;
+            static const E& wrap(const E& e) { return e; }
+        };
+
+        template <typename Op, typename A, typename B, bool Valid = operand_traits<A>::valid && operand_traits<B>::valid>
+        struct binary_result {};
+
+        template <typename Op, typename A, typename B>
+        struct binary_result<Op, A, B, true>
+        {
+            typedef binary<Op, typename operand_traits<A>::type, typename operand_traits<B>::type> type;
+        };
+
+        template <typename Op, typename A, bool Valid = operand_traits<A>::valid>
+        struct scalar_result {};
+
+        template <typename Op, typename A>
+        struct scalar_result<Op, A, true>
+        {
+            typedef typename operand_traits<A>::type node_type;
+            typedef typename node_type::value_type value_type;
+            typedef scalar<Op, node_type> type;
+        };
+    }
+
+    /// @brief Uses any contiguous container (e.g. a matrix) as an elementwise expression operand.
+    template <typename C>
+    inline expr::leaf<typename std::remove_const<typename std::remove_pointer<decltype(std::declval<const C&>().data())>::type>::type>
+    lazy(const C& container)
+    {
+        typedef typename std::remove_const<typename std::remove_pointer<decltype(std::declval<const C&>().data())>::type>::type T;
+        return expr::leaf<T>(container.data(), container.size());
+    }
+
+    /// @brief Views can be used too, as long as they are contiguous.
+    template <typename T>
+    inline expr::leaf<typename vector_view<T>::value_type> lazy(const vector_view<T>& view)
+    {
+        if (!view.contiguous())
+            throw std::invalid_argument("lazy: expressions only support contiguous views");
+        return expr::leaf<typename vector_view<T>::value_type>(view.data(), view.size());
+    }
+
+    // ============================
+    // ============================
+    //  Operators
+    // ============================
+    // ============================
+
+    template <typename A, typename B>
+    inline typename expr::binary_result<expr::add_op, A, B>::type operator+(const A& a, const B& b)
+    {
+        return typename expr::binary_result<expr::add_op, A, B>::type(
+            expr::operand_traits<A>::wrap(a), expr::operand_traits<B>::wrap(b));
+    }
+
+    template <typename A, typename B>
+    inline typename expr::binary_result<expr::sub_op, A, B>::type operator-(const A& a, const B& b)
+    {
+        return typename expr::binary_result<expr::sub_op, A, B>::type(
+            expr::operand_traits<A>::wrap(a), expr::operand_traits<B>::wrap(b));
+    }
+
+    template <typename A, typename B>
+    inline typename expr::binary_result<expr::mul_op, A, B>::type operator*(const A& a, const B& b)
+    {
+        return typename expr::binary_result<expr::mul_op, A, B>::type(
+            expr::operand_traits<A>::wrap(a), expr::operand_traits<B>::wrap(b));
+    }
+
+    template <typename A, typename B>
+    inline typename expr::binary_result<expr::div_op, A, B>::type operator/(const A& a, const B& b)
+    {
+        return typename expr::binary_result<expr::div_op, A, B>::type(
+            expr::operand_traits<A>::wrap(a), expr::operand_traits<B>::wrap(b));
+    }
+
+    template <typename A>
+    inline typename expr::scalar_result<expr::addc_op, A>::type operator+(
+        const A& a, const typename expr::scalar_result<expr::addc_op, A>::value_type& val)
+    {
+        return typename expr::scalar_result<expr::addc_op, A>::type(expr::operand_traits<A>::wrap(a), val);
+    }
+
+    template <typename A>
+    inline typename expr::scalar_result<expr::addc_op, A>::type operator+(
+        const typename expr::scalar_result<expr::addc_op, A>::value_type& val, const A& a)
+    {
+        return typename expr::scalar_result<expr::addc_op, A>::type(expr::operand_traits<A>::wrap(a), val);
+    }
+
+    template <typename A>
+    inline typename expr::scalar_result<expr::subc_op, A>::type operator-(
+        const A& a, const typename expr::scalar_result<expr::subc_op, A>::value_type& val)
+    {
+        return typename expr::scalar_result<expr::subc_op, A>::type(expr::operand_traits<A>::wrap(a), val);
+    }
+
+    template <typename A>
+    inline typename expr::scalar_result<expr::mulc_op, A>::type operator*(
+        const A& a, const typename expr::scalar_result<expr::mulc_op, A>::value_type& val)
+    {
+        return typename expr::scalar_result<expr::mulc_op, A>::type(expr::operand_traits<A>::wrap(a), val);
+    }
+
+    template <typename A>
+    inline typename expr::scalar_result<expr::mulc_op, A>::type operator*(
+        const typename expr::scalar_result<expr::mulc_op, A>::value_type& val, const A& a)
+    {
+        return typename expr::scalar_result<expr::mulc_op, A>::type(expr::operand_traits<A>::wrap(a), val);
+    }
+}
@@ -3,3 +3,9 @@
 #include "filter/FIRSR.h"
 #include "filter/FIRGen.h"
 #include "filter/FIRMR.h"
+#include "filter/OverlapSave.h"
+#include "filter/PartitionedConvolution.h"
+#include "filter/Channelizer.h"
+#include "filter/Synthesizer.h"
+#include "filter/Resampler.h"
+#include "filter/Farrow.h"
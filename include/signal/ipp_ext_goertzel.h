@@ -0,0 +1,282 @@
+/*
+Goertzel bank: a set of K DFT bins, at any frequencies, for many channels of 32fc/64fc input.
+
+For an input x of length N and each frequency f_k (in cycles per sample) the output is
+
+    X[k] = sum_n x[n] * exp(-2 pi i f_k n)
+
+which is what transform::Goertz gives for one frequency per call. The bank instead makes a single
+pass over the input for all K bins: the input is walked in blocks small enough to stay in L1, and
+each block is run through the Goertzel recursion of every bin, four bins interleaved at a time so
+that their recursions overlap. The recursions are kept in double precision for both input types.
+
+When every frequency falls on a bin of a length-N DFT, a full DFTCToC followed by a gather of the K
+bins is also possible, and is faster once K is more than a handful. GoertzelMethod::Auto picks
+between the two from K and N (see preferDFT()). Channels are spread over the thread pool.
+
+Example:
+    std::vector<double> tones = {0.01, 0.0173, 0.25};
+    ipps::GoertzelBank<Ipp32fc> bank(tones, 4096);
+    bank.computeBatch(channels.data(), 4096, numChannels, bins.data(), tones.size());
+*/
+
+#pragma once
+
+#include "ipp.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ipp_ext_vec.h"
+#include "ipp_ext_dft.h"
+#include "ipp_ext_dft_real.h"
+#include "ipp_ext_parallel.h"
+#include "../ipp_ext_errors.h"
+
+namespace ipps
+{
+    /// @brief How a GoertzelBank computes its bins.
+    enum class GoertzelMethod
+    {
+        Auto,     // DFT when every frequency is on a DFT bin and preferDFT() says so, else Goertzel
+        Goertzel, // the blocked Goertzel recursion, for any frequencies
+        DFT       // a full DFTCToC and a gather; every frequency must be a multiple of 1/N
+    };
+
+    /// @brief K DFT bins at arbitrary frequencies over a fixed input length, for 32fc/64fc.
+    template <typename T>
+    class GoertzelBank
+    {
+    public:
+        typedef typename detail::complex_real<T>::type real_type;
+
+        GoertzelBank()
+        {}
+
+        /// @param frequencies The bin frequencies, in cycles per sample.
+        /// @param length N, the number of input samples per channel.
+        /// @param method How to compute the bins; Auto chooses.
+        GoertzelBank(const std::vector<double>& frequencies, size_t length,
+                     GoertzelMethod method = GoertzelMethod::Auto)
+            : m_frequencies{frequencies}, m_length{length}
+        {
+            if (frequencies.size() == 0)
+                throw std::invalid_argument("GoertzelBank: at least one frequency is required");
+            if (length == 0)
+                throw std::invalid_argument("GoertzelBank: length cannot be 0");
+
+            // Bin indices, in case the DFT is used
+            bool onBins = true;
+            m_bins.resize(frequencies.size());
+            for (size_t k = 0; k < frequencies.size(); k++)
+            {
+                double bin = frequencies[k] * (double)length;
+                double whole = std::round(bin);
+                if (std::abs(bin - whole) > 1e-9)
+                {
+                    onBins = false;
+                    break;
+                }
+                long long b = (long long)whole % (long long)length;
+                m_bins[k] = (size_t)(b < 0 ? b + (long long)length : b);
+            }
+
+            if (method == GoertzelMethod::DFT && !onBins)
+                throw std::invalid_argument("GoertzelBank: the DFT method needs every frequency on a multiple of 1/" +
+                    std::to_string(length));
+            if (method == GoertzelMethod::Auto)
+                method = onBins && preferDFT(frequencies.size(), length) ? GoertzelMethod::DFT : GoertzelMethod::Goertzel;
+            m_method = method;
+
+            if (m_method == GoertzelMethod::DFT)
+            {
+                m_plan = DFTCToCPlan<T>::cached(length);
+                return;
+            }
+            m_bins.clear();
+
+            // Padded to whole groups with idle bins, whose outputs are dropped
+            size_t padded = (frequencies.size() + group - 1) / group * group;
+            m_coefs.assign(padded, 0.0);
+            m_endRe.assign(padded, 0.0);
+            m_endIm.assign(padded, 0.0);
+            m_lastRe.assign(padded, 0.0);
+            m_lastIm.assign(padded, 0.0);
+            for (size_t k = 0; k < frequencies.size(); k++)
+            {
+                double w = 2.0 * IPP_PI * frequencies[k];
+                m_coefs[k] = 2.0 * std::cos(w);
+                // X = exp(-i w (N-1)) s[N-1] - exp(-i w N) s[N-2]
+                m_endRe[k] = std::cos(w * (double)(length - 1));
+                m_endIm[k] = -std::sin(w * (double)(length - 1));
+                m_lastRe[k] = std::cos(w * (double)length);
+                m_lastIm[k] = -std::sin(w * (double)length);
+            }
+        }
+
+        /// @brief Computes the getNumBins() bins of one channel of getLength() samples.
+        void compute(const T* src, T* out)
+        {
+            check();
+            prepare_tasks(1);
+            compute_with(m_tasks[0], src, out);
+        }
+
+        /// @brief compute() on count channels, spread over the pool.
+        /// Channel i starts at src + i * srcStride, and its bins at out + i * outStride.
+        void computeBatch(const T* src, size_t srcStride, size_t count, T* out, size_t outStride,
+                          parallel::ThreadPool& pool = parallel::defaultPool())
+        {
+            check();
+            if (count == 0)
+                return;
+            if (count > 1 && srcStride < m_length)
+                throw std::invalid_argument("GoertzelBank: input stride must be at least the length");
+            if (count > 1 && outStride < getNumBins())
+                throw std::invalid_argument("GoertzelBank: output stride must be at least the number of bins");
+
+            const parallel::Partition blocks = parallel::partition(count, pool);
+            prepare_tasks(blocks.parts);
+
+            pool.run(blocks.parts, [&](size_t part){
+                for (size_t i = blocks.begin(part); i < blocks.end(part); i++)
+                    compute_with(m_tasks[part], src + i * srcStride, out + i * outStride);
+            });
+        }
+
+        /// @brief Whether a full DFT and gather is expected to beat the Goertzel bank for numBins bins of length N.
+        /// The Goertzel recursion costs about 6 flops per sample per bin, and the DFT about 5 log2(N) per
+        /// sample in all; the DFT is given a factor of 2 for being vectorised, which the recursion is not.
+        static bool preferDFT(size_t numBins, size_t length)
+        {
+            return 6.0 * (double)numBins > 2.5 * std::log2((double)std::max(length, (size_t)2));
+        }
+
+        size_t getLength() const { return m_length; }
+        size_t getNumBins() const { return m_frequencies.size(); }
+        const std::vector<double>& getFrequencies() const { return m_frequencies; }
+        /// @brief The method in use, never Auto once constructed.
+        GoertzelMethod getMethod() const { return m_method; }
+
+    private:
+        // Bins whose recursions are interleaved in the inner loop
+        static const size_t group = 4;
+        // Samples per block; 2048 32fc or 1024 64fc samples take half of a 32 KB L1
+        static const size_t blockBytes = 16384;
+
+        std::vector<double> m_frequencies;
+        size_t m_length = 0;
+        GoertzelMethod m_method = GoertzelMethod::Auto;
+
+        // DFT method
+        std::shared_ptr<const DFTCToCPlan<T>> m_plan;
+        std::vector<size_t> m_bins;
+
+        // Goertzel method, one entry per (padded) bin
+        std::vector<double> m_coefs; // 2 cos(w)
+        std::vector<double> m_endRe, m_endIm;   // exp(-i w (N-1))
+        std::vector<double> m_lastRe, m_lastIm; // exp(-i w N)
+
+        // Per-task scratch, see parallel::prepareTasks
+        struct Workspace
+        {
+            std::vector<double> state; // per group: s1 re, s1 im, s2 re, s2 im, each group wide
+            vector<T> spectrum;
+            vector<Ipp8u> dftBuf;
+        };
+        std::vector<Workspace> m_tasks;
+
+        void check() const
+        {
+            if (m_length == 0)
+                throw std::runtime_error("GoertzelBank: not configured, construct with frequencies first");
+        }
+
+        void prepare_tasks(size_t numTasks)
+        {
+            parallel::prepareTasks(m_tasks, numTasks, [&](Workspace& w){
+                if (m_method == GoertzelMethod::DFT)
+                {
+                    if (w.spectrum.size() != m_length)
+                        w.spectrum.resize(m_length);
+                    if (w.dftBuf.size() < m_plan->getBufferSize())
+                        w.dftBuf.resize(m_plan->getBufferSize());
+                }
+                else if (w.state.size() != 4 * m_coefs.size())
+                {
+                    w.state.resize(4 * m_coefs.size());
+                }
+            });
+        }
+
+        void compute_with(Workspace& w, const T* src, T* out) const
+        {
+            if (m_method == GoertzelMethod::DFT)
+            {
+                m_plan->fwd(src, w.spectrum.data(), w.dftBuf.data());
+                for (size_t k = 0; k < m_bins.size(); k++)
+                    out[k] = w.spectrum[m_bins[k]];
+                return;
+            }
+
+            std::fill(w.state.begin(), w.state.end(), 0.0);
+            const size_t numGroups = m_coefs.size() / group;
+            const size_t block = blockBytes / sizeof(T);
+
+            // Each block is read once from memory, then from cache for every group after the first
+            for (size_t start = 0; start < m_length; start += block)
+            {
+                size_t end = std::min(m_length, start + block);
+                for (size_t g = 0; g < numGroups; g++)
+                    run_group(src, start, end, m_coefs.data() + g * group, w.state.data() + g * 4 * group);
+            }
+
+            for (size_t k = 0; k < m_frequencies.size(); k++)
+            {
+                const double* s = w.state.data() + (k / group) * 4 * group;
+                size_t j = k % group;
+                double s1r = s[j], s1i = s[group + j], s2r = s[2 * group + j], s2i = s[3 * group + j];
+                out[k].re = (real_type)(m_endRe[k] * s1r - m_endIm[k] * s1i - (m_lastRe[k] * s2r - m_lastIm[k] * s2i));
+                out[k].im = (real_type)(m_endRe[k] * s1i + m_endIm[k] * s1r - (m_lastRe[k] * s2i + m_lastIm[k] * s2r));
+            }
+        }
+
+        // s[n] = x[n] + 2 cos(w) s[n-1] - s[n-2] over [start, end), for one group of bins
+        static void run_group(const T* src, size_t start, size_t end, const double* coefs, double* state)
+        {
+            double s1r[group], s1i[group], s2r[group], s2i[group], c[group];
+            for (size_t j = 0; j < group; j++)
+            {
+                s1r[j] = state[j];
+                s1i[j] = state[group + j];
+                s2r[j] = state[2 * group + j];
+                s2i[j] = state[3 * group + j];
+                c[j] = coefs[j];
+            }
+
+            for (size_t n = start; n < end; n++)
+            {
+                double xr = (double)src[n].re, xi = (double)src[n].im;
+                for (size_t j = 0; j < group; j++)
+                {
+                    double r = xr + c[j] * s1r[j] - s2r[j];
+                    double i = xi + c[j] * s1i[j] - s2i[j];
+                    s2r[j] = s1r[j];
+                    s2i[j] = s1i[j];
+                    s1r[j] = r;
+                    s1i[j] = i;
+                }
+            }
+
+            for (size_t j = 0; j < group; j++)
+            {
+                state[j] = s1r[j];
+                state[group + j] = s1i[j];
+                state[2 * group + j] = s2r[j];
+                state[3 * group + j] = s2i[j];
+            }
+        }
+    };
+}
@@ -1,3 +1,4 @@
 #pragma once
 
 #include "logical/Xor.h"
+#include "logical/Chunked.h"
@@ -17,3 +17,6 @@
 #include "math/Exp.h"
 
 #include "math/Ln.h"
+
+#include "math/Chunked.h"
+#include "math/Views.h"
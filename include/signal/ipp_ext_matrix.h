@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ipp_ext_vec.h"
+#include "ipp_ext_view.h"
 // We include math functions experimentally
 #include "ipp_ext_math.h"
 #include "ipp_ext_sampling.h"
@@ -100,12 +101,12 @@ namespace ipps
             }
 
             // Extra accessors
-            size_t rows()
+            size_t rows() const
             {
                 return m_rows;
             }
 
-            size_t columns()
+            size_t columns() const
             {
                 return m_columns;
             }
@@ -123,6 +124,20 @@ namespace ipps
                 // see https://isocpp.org/wiki/faq/templates#nondependent-name-lookup-members
             }
 
+            /// @brief View of a row; the same memory as row(), but carries its length.
+            vector_view<T> rowView(size_t rowIdx)
+            {
+                return vector_view<T>(row(rowIdx), m_columns);
+            }
+
+            /// @brief Strided view of a column, without copying it out.
+            vector_view<T> columnView(size_t columnIdx)
+            {
+                if (columnIdx >= m_columns)
+                    throw std::out_of_range("Column index out of range");
+                return vector_view<T>(&this->m_data[columnIdx], m_rows, (ptrdiff_t)m_columns);
+            }
+
             // Access a row and column
             T& index(size_t rowIdx, size_t columnIdx)
             {
@@ -285,6 +300,18 @@ namespace ipps
                 return result;
             }
 
+            /// @brief Evaluates a lazy elementwise expression (see ipp_ext_expr.h) into this matrix.
+            /// The dimensions are kept, so the expression must have the same number of elements.
+            template <typename E>
+            matrix& operator=(const expression<E>& expr)
+            {
+                if (expr.size() != this->size())
+                    throw std::out_of_range("Dimension mismatch for expression assignment");
+
+                expr.derived().evaluate(this->data(), this->size());
+                return *this;
+            }
+
             // Remove size adjustment methods (for now?)
             void push_back(T value) = delete;
 
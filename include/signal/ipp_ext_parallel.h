@@ -0,0 +1,400 @@
+/*
+Multi-threaded execution of the elementwise ipps::math wrappers.
+
+A ThreadPool keeps its worker threads alive between calls, so dispatching work only costs
+a wake-up rather than a thread creation. Work is split into contiguous ranges whose boundaries
+fall on cache lines (relative to the start of the buffers, which ippsMalloc aligns to 64 bytes),
+so no two threads ever write to the same line. Anything shorter than minChunk() elements per
+thread is simply run on the calling thread, since the wake-up would cost more than it saves.
+
+Example:
+    ipps::vector<Ipp32f> x(50000000), y(50000000), z(50000000);
+    ipps::parallel::Add(x.data(), y.data(), z.data(), x.size()); // uses the default pool
+
+    // Any elementwise wrapper can be run through forEachRange
+    ipps::parallel::forEachRange<Ipp32f>(x.size(), [&](size_t offset, size_t count){
+        ipps::math::AddC(x.data() + offset, 1.0f, z.data() + offset, count);
+    });
+*/
+
+#pragma once
+
+#include "ipp.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ipp_ext_math.h"
+
+namespace ipps
+{
+namespace parallel
+{
+    const size_t CACHE_LINE_BYTES = 64;
+
+    /// @brief Persistent pool of worker threads. The thread calling run() also does work,
+    /// so a pool of size N has N-1 workers.
+    class ThreadPool
+    {
+    public:
+        /// @param numThreads Total number of threads to use, including the calling thread.
+        /// 0 uses std::thread::hardware_concurrency().
+        explicit ThreadPool(size_t numThreads = 0)
+        {
+            if (numThreads == 0)
+                numThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+
+            m_workers.reserve(numThreads - 1);
+            for (size_t i = 0; i + 1 < numThreads; i++)
+                m_workers.emplace_back(&ThreadPool::worker_loop, this);
+        }
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_wake.notify_all();
+            for (std::thread& t : m_workers)
+                t.join();
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /// @brief Total number of threads that run() spreads work over, including the caller.
+        size_t size() const { return m_workers.size() + 1; }
+
+        /// @brief Calls f(taskIdx) for every taskIdx in [0, numTasks), blocking until all are done.
+        /// The first exception thrown by a task is rethrown here, after the remaining tasks finish.
+        /// Calls from inside a task (or concurrent calls from other threads) are safe; nested ones
+        /// run serially on the calling thread.
+        template <typename F>
+        void run(size_t numTasks, F f)
+        {
+            if (numTasks == 0)
+                return;
+
+            if (numTasks == 1 || m_workers.empty() || current_pool() == this)
+            {
+                for (size_t i = 0; i < numTasks; i++)
+                    f(i);
+                return;
+            }
+
+            std::lock_guard<std::mutex> runLock(m_runMutex);
+
+            Job job;
+            job.func = [&f](size_t i){ f(i); };
+            job.numTasks = numTasks;
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_job = &job;
+                m_generation++;
+            }
+            m_wake.notify_all();
+
+            // Join in ourselves, marking this thread so that nested calls don't deadlock
+            const ThreadPool* previous = current_pool();
+            current_pool() = this;
+            execute(job);
+            current_pool() = previous;
+
+            // Every task has been claimed by now; wait for the workers still running one
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_done.wait(lock, [&job]{ return job.active == 0; });
+                m_job = nullptr;
+            }
+
+            if (job.error)
+                std::rethrow_exception(job.error);
+        }
+
+    private:
+        struct Job
+        {
+            std::function<void(size_t)> func;
+            size_t numTasks = 0;
+            std::atomic<size_t> next{0};
+            size_t active = 0; // workers inside execute(), guarded by m_mutex
+            std::mutex errorMutex;
+            std::exception_ptr error;
+        };
+
+        std::vector<std::thread> m_workers;
+        std::mutex m_runMutex; // one run() at a time
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_done;
+        Job* m_job = nullptr;
+        size_t m_generation = 0;
+        bool m_stop = false;
+
+        static const ThreadPool*& current_pool()
+        {
+            static thread_local const ThreadPool* pool = nullptr;
+            return pool;
+        }
+
+        static void execute(Job& job)
+        {
+            size_t i;
+            while ((i = job.next++) < job.numTasks)
+            {
+                try
+                {
+                    job.func(i);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(job.errorMutex);
+                    if (!job.error)
+                        job.error = std::current_exception();
+                }
+            }
+        }
+
+        void worker_loop()
+        {
+            current_pool() = this;
+            size_t seen = 0;
+            while (true)
+            {
+                Job* job;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_wake.wait(lock, [&]{ return m_stop || m_generation != seen; });
+                    if (m_stop)
+                        return;
+                    seen = m_generation;
+                    job = m_job;
+                    if (job == nullptr) // woke up after the job was already finished
+                        continue;
+                    job->active++;
+                }
+
+                execute(*job);
+
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    job->active--;
+                }
+                m_done.notify_all();
+            }
+        }
+    };
+
+    namespace detail
+    {
+        inline std::mutex& defaultPoolMutex()
+        {
+            static std::mutex m;
+            return m;
+        }
+
+        inline std::unique_ptr<ThreadPool>& defaultPoolPtr()
+        {
+            static std::unique_ptr<ThreadPool> pool;
+            return pool;
+        }
+
+        inline std::atomic<size_t>& minChunkValue()
+        {
+            static std::atomic<size_t> value{(size_t)1 << 16};
+            return value;
+        }
+    }
+
+    /// @brief The pool used when none is specified; created on first use with one thread per core.
+    inline ThreadPool& defaultPool()
+    {
+        std::lock_guard<std::mutex> lock(detail::defaultPoolMutex());
+        std::unique_ptr<ThreadPool>& pool = detail::defaultPoolPtr();
+        if (!pool)
+            pool.reset(new ThreadPool());
+        return *pool;
+    }
+
+    /// @brief Recreates the default pool with the given number of threads (0 for one per core).
+    /// Must not be called while the default pool is in use.
+    inline void setDefaultThreads(size_t numThreads)
+    {
+        std::lock_guard<std::mutex> lock(detail::defaultPoolMutex());
+        detail::defaultPoolPtr().reset(new ThreadPool(numThreads));
+    }
+
+    /// @brief Sets the minimum number of elements given to each thread. Shorter inputs use fewer threads,
+    /// down to running entirely on the caller.
+    inline void setMinChunk(size_t elements){ detail::minChunkValue() = std::max<size_t>(1, elements); }
+
+    inline size_t minChunk(){ return detail::minChunkValue(); }
+
+    /// @brief Splits [0, length) into at most pool.size() contiguous ranges and calls f(size_t offset, size_t count)
+    /// for each, in parallel. Range boundaries are multiples of a cache line of T.
+    /// @tparam T Element type used for the alignment, usually the output type.
+    template <typename T, typename F>
+    inline void forEachRange(size_t length, F f, ThreadPool& pool = defaultPool())
+    {
+        if (length == 0)
+            return;
+
+        const size_t lineElements = sizeof(T) >= CACHE_LINE_BYTES ? 1 : CACHE_LINE_BYTES / sizeof(T);
+
+        size_t parts = std::min(pool.size(), length / minChunk());
+        if (parts <= 1)
+        {
+            f((size_t)0, length);
+            return;
+        }
+
+        size_t per = (length + parts - 1) / parts;
+        per = (per + lineElements - 1) / lineElements * lineElements;
+        parts = (length + per - 1) / per;
+
+        pool.run(parts, [&](size_t p){
+            size_t offset = p * per;
+            f(offset, std::min(per, length - offset));
+        });
+    }
+
+    /// @brief Contiguous blocks of [0, count), at most one per thread, for batched work where each task
+    /// owns some scratch. Block p covers [begin(p), end(p)).
+    struct Partition
+    {
+        size_t count = 0;
+        size_t parts = 0; // number of blocks, none when count is 0
+        size_t per = 0;   // items in each block but perhaps the last
+
+        size_t begin(size_t part) const { return part * per; }
+        size_t end(size_t part) const { return std::min(count, (part + 1) * per); }
+    };
+
+    /// @brief Splits count items into as few equal blocks as keep every thread of the pool busy.
+    inline Partition partition(size_t count, const ThreadPool& pool)
+    {
+        Partition p;
+        p.count = count;
+        if (count == 0)
+            return p;
+        p.parts = std::min(pool.size(), count);
+        p.per = (count + p.parts - 1) / p.parts;
+        p.parts = (count + p.per - 1) / p.per;
+        return p;
+    }
+
+    /// @brief Grows tasks to at least numTasks workspaces and calls prepare(workspace) on each of the first numTasks.
+    /// Call it before ThreadPool::run(), since the tasks must not resize the vector they index into.
+    template <typename W, typename F>
+    inline void prepareTasks(std::vector<W>& tasks, size_t numTasks, F prepare)
+    {
+        if (tasks.size() < numTasks)
+            tasks.resize(numTasks);
+        for (size_t i = 0; i < numTasks; i++)
+            prepare(tasks[i]);
+    }
+
+    // ============================
+    // ============================
+    //  Elementwise math
+    // ============================
+    // ============================
+    // Same arguments as the ipps::math versions, plus an optional pool.
+
+    template <typename T, typename U>
+    inline void Add(const T* x, const T* y, U* result, size_t length, ThreadPool& pool = defaultPool())
+    {
+        forEachRange<U>(length, [&](size_t offset, size_t count){
+            math::Add(x + offset, y + offset, result + offset, count);
+        }, pool);
+    }
+
+    template <typename T, typename U>
+    inline void Sub(const T* x, const T* y, U* result, size_t length, ThreadPool& pool = defaultPool())
+    {
+        forEachRange<U>(length, [&](size_t offset, size_t count){
+            math::Sub(x + offset, y + offset, result + offset, count);
+        }, pool);
+    }
+
+    template <typename T, typename U, typename V>
+    inline void Mul(const T* x, const U* y, V* result, size_t length, ThreadPool& pool = defaultPool())
+    {
+        forEachRange<V>(length, [&](size_t offset, size_t count){
+            math::Mul(x + offset, y + offset, result + offset, count);
+        }, pool);
+    }
+
+    template <typename T>
+    inline void Div(const T* src1, const T* src2, T* dst, size_t length, ThreadPool& pool = defaultPool())
+    {
+        forEachRange<T>(length, [&](size_t offset, size_t count){
+            math::Div(src1 + offset, src2 + offset, dst + offset, count);
+        }, pool);
+    }
+
+    template <typename T>
+    inline void AddC(const T* src, T val, T* dst, size_t length, ThreadPool& pool = defaultPool())
+    {
+        forEachRange<T>(length, [&](size_t offset, size_t count){
+            math::AddC(src + offset, val, dst + offset, count);
+        }, pool);
+    }
+
+    template <typename T>
+    inline void SubC(const T* src, T val, T* dst, size_t length, ThreadPool& pool = defaultPool())
+    {
+        forEachRange<T>(length, [&](size_t offset, size_t count){
+            math::SubC(src + offset, val, dst + offset, count);
+        }, pool);
+    }
+
+    template <typename T>
+    inline void MulC(const T* src, const T val, T* dst, size_t length, ThreadPool& pool = defaultPool())
+    {
+        forEachRange<T>(length, [&](size_t offset, size_t count){
+            math::MulC(src + offset, val, dst + offset, count);
+        }, pool);
+    }
+
+    template <typename T>
+    inline void AddProduct(const T* src1, const T* src2, T* dst, size_t length, ThreadPool& pool = defaultPool())
+    {
+        forEachRange<T>(length, [&](size_t offset, size_t count){
+            math::AddProduct(src1 + offset, src2 + offset, dst + offset, count);
+        }, pool);
+    }
+
+    template <typename T>
+    inline void AddProductC(const T* src, const T val, T* srcDst, size_t length, ThreadPool& pool = defaultPool())
+    {
+        forEachRange<T>(length, [&](size_t offset, size_t count){
+            math::AddProductC(src + offset, val, srcDst + offset, count);
+        }, pool);
+    }
+
+    template <typename T>
+    inline void Exp(const T* src, T* dst, size_t length, ThreadPool& pool = defaultPool())
+    {
+        forEachRange<T>(length, [&](size_t offset, size_t count){
+            math::Exp(src + offset, dst + offset, count);
+        }, pool);
+    }
+
+    template <typename T>
+    inline void Ln(const T* src, T* dst, size_t length, ThreadPool& pool = defaultPool())
+    {
+        forEachRange<T>(length, [&](size_t offset, size_t count){
+            math::Ln(src + offset, dst + offset, count);
+        }, pool);
+    }
+}
+}
@@ -0,0 +1,227 @@
+/*
+Sliding DFT: a set of K bins of a length-N DFT over the most recent N samples, updated on every
+sample, for 32fc/64fc streams.
+
+With the window ending at sample n and held oldest first, bin k is
+
+    X_n[k] = sum_m x[n - N + 1 + m] * exp(-2 pi i k m / N)
+
+and moving the window on by one sample only needs
+
+    X_n[k] = exp(2 pi i k / N) * (X_{n-1}[k] + x[n] - x[n - N])
+
+so each sample costs O(K), rather than the O(N) per bin of recomputing. The differences
+x[n] - x[n - N] are taken for a whole block of input at once with a single Sub, against a circular
+copy of the window, and the bins are updated in a loop over contiguous arrays of bins that the
+compiler can vectorise.
+
+The state is kept in double precision, but the rotations still accumulate rounding, so every
+getResyncInterval() samples the bins are recomputed exactly from the window with a GoertzelBank.
+
+Before the first N samples, the window is padded at its start with zeros.
+
+Example:
+    std::vector<int> bins = {3, 17, 40};
+    ipps::SlidingDFT<Ipp32fc> sdft(1024, bins, 16); // outputs every 16 samples
+    ipps::matrix<Ipp32fc> out(sdft.outputsFor(x.size()), bins.size());
+    sdft.process(x.data(), x.size(), out.data(), bins.size());
+*/
+
+#pragma once
+
+#include "ipp.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ipp_ext_vec.h"
+#include "ipp_ext_copy.h"
+#include "ipp_ext_math.h"
+#include "ipp_ext_dft_real.h"
+#include "ipp_ext_goertzel.h"
+#include "../ipp_ext_errors.h"
+
+namespace ipps
+{
+    /// @brief K bins of a sliding length-N DFT, updated per sample, for 32fc/64fc.
+    template <typename T>
+    class SlidingDFT
+    {
+    public:
+        typedef typename detail::complex_real<T>::type real_type;
+
+        SlidingDFT()
+        {}
+
+        /// @param length N, the window length.
+        /// @param bins Bin indices of the length-N DFT; negative indices count down from N.
+        /// @param hop Samples between outputs of process().
+        /// @param resyncInterval Samples between exact recomputations of the bins. 0 uses max(N, 65536).
+        SlidingDFT(size_t length, const std::vector<int>& bins, size_t hop = 1, size_t resyncInterval = 0)
+            : m_length{length}, m_binIndices{bins}, m_hop{hop}
+        {
+            if (length == 0)
+                throw std::invalid_argument("SlidingDFT: length cannot be 0");
+            if (bins.size() == 0)
+                throw std::invalid_argument("SlidingDFT: at least one bin is required");
+            if (hop == 0)
+                throw std::invalid_argument("SlidingDFT: hop cannot be 0");
+            m_resyncInterval = resyncInterval > 0 ? resyncInterval : std::max(length, (size_t)65536);
+
+            std::vector<double> frequencies(bins.size());
+            m_rotRe.resize(bins.size());
+            m_rotIm.resize(bins.size());
+            for (size_t k = 0; k < bins.size(); k++)
+            {
+                long long b = (long long)bins[k] % (long long)length;
+                if (b < 0)
+                    b += (long long)length;
+                frequencies[k] = (double)b / (double)length;
+                m_rotRe[k] = std::cos(2.0 * IPP_PI * frequencies[k]);
+                m_rotIm[k] = std::sin(2.0 * IPP_PI * frequencies[k]);
+            }
+            m_exact = GoertzelBank<T>(frequencies, length);
+
+            m_window.resize(length);
+            m_diff.resize(length);
+            m_ordered.resize(length);
+            m_exactBins.resize(bins.size());
+            m_re.resize(bins.size());
+            m_im.resize(bins.size());
+            reset();
+        }
+
+        /// @brief Pushes len samples, updating the bins after each one.
+        /// @param out If not null, receives the bins after every hop-th sample, one row of getNumBins() per output.
+        /// @param outStride Elements between the starts of consecutive output rows.
+        /// @return The number of rows written (see outputsFor()).
+        size_t process(const T* in, size_t len, T* out = nullptr, size_t outStride = 0)
+        {
+            if (m_length == 0)
+                throw std::runtime_error("SlidingDFT: not configured, construct with a length first");
+            if (out != nullptr && outputsFor(len) > 1 && outStride < getNumBins())
+                throw std::invalid_argument("SlidingDFT: output row stride must be at least the number of bins");
+
+            size_t rows = 0;
+            while (len > 0)
+            {
+                // A block must not wrap around the window, nor pass an output or a resync
+                size_t block = std::min(len, m_length - m_pos);
+                block = std::min(block, m_hop - m_sinceOutput);
+                block = std::min(block, m_resyncInterval - m_sinceResync);
+
+                // x[n] - x[n - N] for the whole block, then the block replaces the oldest samples
+                math::Sub(m_window.data() + m_pos, in, m_diff.data(), (int)block);
+                Copy(in, m_window.data() + m_pos, (int)block);
+                update(block);
+
+                m_pos = (m_pos + block) % m_length;
+                m_samples += block;
+                m_sinceOutput += block;
+                m_sinceResync += block;
+                in += block;
+                len -= block;
+
+                if (m_sinceResync == m_resyncInterval)
+                    resync();
+                if (m_sinceOutput == m_hop)
+                {
+                    m_sinceOutput = 0;
+                    if (out != nullptr)
+                        getBins(out + rows * outStride);
+                    rows++;
+                }
+            }
+            return rows;
+        }
+
+        /// @brief Number of output rows that process() will produce for the next len samples.
+        size_t outputsFor(size_t len) const { return (m_sinceOutput + len) / m_hop; }
+
+        /// @brief Writes the current getNumBins() bins to out.
+        void getBins(T* out) const
+        {
+            for (size_t k = 0; k < m_re.size(); k++)
+            {
+                out[k].re = (real_type)m_re[k];
+                out[k].im = (real_type)m_im[k];
+            }
+        }
+
+        /// @brief Recomputes the bins exactly from the window, discarding any accumulated drift.
+        void resync()
+        {
+            // The window in order, oldest first
+            Copy(m_window.data() + m_pos, m_ordered.data(), (int)(m_length - m_pos));
+            if (m_pos > 0)
+                Copy(m_window.data(), m_ordered.data() + (m_length - m_pos), (int)m_pos);
+            m_exact.compute(m_ordered.data(), m_exactBins.data());
+            for (size_t k = 0; k < m_re.size(); k++)
+            {
+                m_re[k] = (double)m_exactBins[k].re;
+                m_im[k] = (double)m_exactBins[k].im;
+            }
+            m_sinceResync = 0;
+        }
+
+        /// @brief Clears the window to zeros and restarts the output and resync counts.
+        void reset()
+        {
+            m_window.zero();
+            std::fill(m_re.begin(), m_re.end(), 0.0);
+            std::fill(m_im.begin(), m_im.end(), 0.0);
+            m_pos = 0;
+            m_samples = 0;
+            m_sinceOutput = 0;
+            m_sinceResync = 0;
+        }
+
+        size_t getLength() const { return m_length; }
+        size_t getNumBins() const { return m_binIndices.size(); }
+        const std::vector<int>& getBinIndices() const { return m_binIndices; }
+        size_t getHop() const { return m_hop; }
+        size_t getResyncInterval() const { return m_resyncInterval; }
+        /// @brief Total samples pushed since construction or the last reset().
+        size_t getSampleCount() const { return m_samples; }
+
+    private:
+        size_t m_length = 0;
+        std::vector<int> m_binIndices;
+        size_t m_hop = 1;
+        size_t m_resyncInterval = 0;
+
+        std::vector<double> m_rotRe, m_rotIm; // exp(2 pi i k / N)
+        std::vector<double> m_re, m_im;       // the bins
+        GoertzelBank<T> m_exact;              // for resyncing
+
+        vector<T> m_window; // circular, m_pos is the oldest sample
+        vector<T> m_diff;
+        vector<T> m_ordered;
+        vector<T> m_exactBins;
+        size_t m_pos = 0;
+        size_t m_samples = 0;
+        size_t m_sinceOutput = 0;
+        size_t m_sinceResync = 0;
+
+        void update(size_t block)
+        {
+            const size_t numBins = m_re.size();
+            double* re = m_re.data();
+            double* im = m_im.data();
+            const double* rotRe = m_rotRe.data();
+            const double* rotIm = m_rotIm.data();
+            for (size_t n = 0; n < block; n++)
+            {
+                const double dr = (double)m_diff[n].re, di = (double)m_diff[n].im;
+                // Independent across bins, so this loop vectorises
+                for (size_t k = 0; k < numBins; k++)
+                {
+                    double a = re[k] + dr, b = im[k] + di;
+                    re[k] = a * rotRe[k] - b * rotIm[k];
+                    im[k] = a * rotIm[k] + b * rotRe[k];
+                }
+            }
+        }
+    };
+}
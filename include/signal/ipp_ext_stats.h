@@ -7,3 +7,5 @@
 #include "stats/Min.h"
 #include "stats/MinIndx.h"
 #include "stats/DotProd.h"
+#include "stats/Chunked.h"
+#include "stats/Views.h"
@@ -0,0 +1,295 @@
+/*
+Streaming short-time Fourier transform (spectrogram), for 32fc/64fc input.
+
+Each frame is windowed, transformed and converted to magnitude, power or power in dB in one pass over
+per-thread work buffers, and written straight into a row of the caller's output. The output rows are
+used as a ring: frame n goes to row n % rows, so a fixed-size matrix (or an ippi::image for 32f) can
+hold a scrolling spectrogram without reallocating.
+
+Input may be pushed in chunks of any size; samples belonging to frames that are not yet complete are
+kept until the next call. When a call completes several frames, they are spread over the thread pool.
+
+Example:
+    ipps::STFT<Ipp32fc> stft(1024, 256, ippWinHann, ipps::STFTScale::PowerDB);
+    ipps::matrix<Ipp32f> spectrogram(100, stft.getFFTLength());
+    size_t written = stft.process(x.data(), x.size(), spectrogram);
+*/
+
+#pragma once
+
+#include "ipp.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ipp_ext_vec.h"
+#include "ipp_ext_copy.h"
+#include "ipp_ext_matrix.h"
+#include "ipp_ext_math.h"
+#include "ipp_ext_convert.h"
+#include "ipp_ext_transform.h"
+#include "ipp_ext_dft.h"
+#include "ipp_ext_dft_real.h"
+#include "ipp_ext_parallel.h"
+#include "../image/image.h"
+#include "../ipp_ext_errors.h"
+
+namespace ipps
+{
+    /// @brief What each STFT output bin holds.
+    enum class STFTScale
+    {
+        Magnitude, // |X|
+        Power,     // |X|^2
+        PowerDB    // 10 log10(|X|^2)
+    };
+
+    namespace detail
+    {
+        /// @brief Converts len complex values to the given scale, e.g. one spectrum or correlation row.
+        template <typename T, typename R>
+        inline void scale_spectrum(STFTScale scale, const T* src, R* dst, int len)
+        {
+            switch (scale)
+            {
+                case STFTScale::Magnitude:
+                    convert::Magnitude(src, dst, len);
+                    break;
+                case STFTScale::Power:
+                    convert::PowerSpectr(src, dst, len);
+                    break;
+                case STFTScale::PowerDB:
+                    convert::PowerSpectr(src, dst, len);
+                    // Keeps empty bins finite, since Ln fails on zero
+                    math::AddC_I(std::numeric_limits<R>::min(), dst, len);
+                    math::Ln_I(dst, len);
+                    math::MulC_I((R)(10.0 / std::log(10.0)), dst, len);
+                    break;
+            }
+        }
+    }
+
+    /// @brief Streaming STFT with a fixed window, frame length and hop, for 32fc/64fc.
+    /// @tparam T Input type; the outputs are the matching real type.
+    template <typename T>
+    class STFT
+    {
+    public:
+        typedef typename detail::complex_real<T>::type real_type;
+
+        STFT()
+        {}
+
+        /// @param frameLength Samples per frame, i.e. the window length.
+        /// @param hop Samples between the starts of consecutive frames. May exceed frameLength, in which case samples are skipped.
+        /// @param winType Window applied to each frame (see transform::Win_I).
+        /// @param scale What to output per bin.
+        /// @param fftLength DFT length, at least frameLength; frames are zero-padded up to it. 0 uses frameLength.
+        STFT(size_t frameLength, size_t hop, IppWinType winType = ippWinHann,
+             STFTScale scale = STFTScale::Power, size_t fftLength = 0)
+            : m_frameLength{frameLength}, m_hop{hop}, m_scale{scale}
+        {
+            if (frameLength == 0)
+                throw std::invalid_argument("STFT: frame length cannot be 0");
+            if (hop == 0)
+                throw std::invalid_argument("STFT: hop cannot be 0");
+            if (fftLength == 0)
+                fftLength = frameLength;
+            if (fftLength < frameLength)
+                throw std::invalid_argument("STFT: FFT length " + std::to_string(fftLength) +
+                    " must be at least the frame length " + std::to_string(frameLength));
+
+            m_plan = DFTCToCPlan<T>::cached(fftLength);
+
+            // Complex so that windowing is a single Mul for both 32fc and 64fc
+            m_window.resize(frameLength);
+            for (size_t i = 0; i < frameLength; i++)
+            {
+                m_window[i].re = 1;
+                m_window[i].im = 0;
+            }
+            // IPP's windows need at least 3 samples; shorter frames are left rectangular
+            if (frameLength >= 3)
+                transform::Win_I(winType, m_window.data(), (int)frameLength);
+
+            m_history.resize(frameLength);
+            reset();
+        }
+
+        /// @brief Pushes len input samples and writes every frame they complete into the output ring.
+        /// @param out First output row; each row must hold getFFTLength() values.
+        /// @param outStride Elements between the starts of consecutive output rows.
+        /// @param rows Number of rows in the ring.
+        /// @return The number of frames written. If this exceeds rows, only the last rows frames remain.
+        size_t process(const T* in, size_t len, real_type* out, size_t outStride, size_t rows,
+                       parallel::ThreadPool& pool = parallel::defaultPool())
+        {
+            if (!m_plan)
+                throw std::runtime_error("STFT: no plan, construct with a frame length first");
+            if (rows == 0)
+                throw std::invalid_argument("STFT: output must have at least one row");
+            if (rows > 1 && outStride < getFFTLength())
+                throw std::invalid_argument("STFT: output row stride must be at least the FFT length");
+
+            // Samples that fall in the gap between frames when the hop exceeds the frame length
+            size_t skipped = std::min(m_skip, len);
+            in += skipped;
+            len -= skipped;
+            m_skip -= skipped;
+            if (m_skip > 0) // the whole input was in the gap
+                return 0;
+
+            // Frames are numbered from the start of the history, which is the start of the next frame
+            const size_t available = m_historyLength + len;
+            size_t count = available < m_frameLength ? 0 : (available - m_frameLength) / m_hop + 1;
+
+            if (count > 0)
+                run_frames(in, count, out, outStride, rows, pool);
+
+            keep_tail(in, len, count);
+            m_frames += count;
+            return count;
+        }
+
+        /// @brief process() into the rows of a matrix, which must have getFFTLength() columns.
+        size_t process(const T* in, size_t len, matrix<real_type>& out,
+                       parallel::ThreadPool& pool = parallel::defaultPool())
+        {
+            if (out.columns() != getFFTLength())
+                throw std::invalid_argument("STFT: matrix has " + std::to_string(out.columns()) +
+                    " columns, expected the FFT length " + std::to_string(getFFTLength()));
+            return process(in, len, out.data(), out.columns(), out.rows(), pool);
+        }
+
+        /// @brief process() into the rows of an image, which must be getFFTLength() pixels wide.
+        size_t process(const T* in, size_t len, ippi::image<real_type, ippi::channels::C1>& out,
+                       parallel::ThreadPool& pool = parallel::defaultPool())
+        {
+            if (out.width() != getFFTLength())
+                throw std::invalid_argument("STFT: image is " + std::to_string(out.width()) +
+                    " pixels wide, expected the FFT length " + std::to_string(getFFTLength()));
+            if (out.stepBytes() % sizeof(real_type) != 0)
+                throw std::invalid_argument("STFT: image step must be a whole number of pixels");
+            return process(in, len, out.data(), (size_t)out.stepBytes() / sizeof(real_type), out.height(), pool);
+        }
+
+        /// @brief Drops any buffered input and restarts the frame count, as if no samples had been pushed.
+        void reset()
+        {
+            m_historyLength = 0;
+            m_skip = 0;
+            m_frames = 0;
+        }
+
+        size_t getFrameLength() const { return m_frameLength; }
+        size_t getHop() const { return m_hop; }
+        size_t getFFTLength() const { return m_plan ? m_plan->getLength() : 0; }
+        STFTScale getScale() const { return m_scale; }
+        const vector<T>& getWindow() const { return m_window; }
+        /// @brief Total frames produced since construction or the last reset().
+        size_t getFrameCount() const { return m_frames; }
+        /// @brief Output row the next frame will be written to, for a ring of the given number of rows.
+        size_t getNextRow(size_t rows) const { return rows == 0 ? 0 : m_frames % rows; }
+
+    private:
+        size_t m_frameLength = 0;
+        size_t m_hop = 0;
+        STFTScale m_scale = STFTScale::Power;
+        std::shared_ptr<const DFTCToCPlan<T>> m_plan;
+        vector<T> m_window;
+
+        vector<T> m_history;        // unconsumed samples, starting at the next frame
+        size_t m_historyLength = 0;
+        size_t m_skip = 0;          // input samples to drop before the next frame starts
+        size_t m_frames = 0;
+
+        // Per-task scratch, see parallel::prepareTasks
+        struct Workspace
+        {
+            vector<T> frame;        // windowed frame, zero-padded to the FFT length
+            vector<T> spectrum;
+            vector<Ipp8u> dftBuf;
+        };
+        std::vector<Workspace> m_work;
+
+        void run_frames(const T* in, size_t count, real_type* out, size_t outStride, size_t rows,
+                        parallel::ThreadPool& pool)
+        {
+            const DFTCToCPlan<T>& p = *m_plan;
+            const size_t fftLength = p.getLength();
+
+            // Frames that a later frame in this call would overwrite in the ring are skipped, so that
+            // every row is written by exactly one task and ends up holding the newest frame
+            const size_t first = count > rows ? count - rows : 0;
+            const size_t todo = count - first;
+
+            const parallel::Partition blocks = parallel::partition(todo, pool);
+            parallel::prepareTasks(m_work, blocks.parts, [&](Workspace& w){
+                if (w.frame.size() != fftLength)
+                {
+                    w.frame.resize(fftLength);
+                    w.frame.zero(); // the padding is never written afterwards
+                    w.spectrum.resize(fftLength);
+                }
+                if (w.dftBuf.size() < p.getBufferSize())
+                    w.dftBuf.resize(p.getBufferSize());
+            });
+
+            const size_t firstRow = m_frames % rows;
+            pool.run(blocks.parts, [&](size_t part){
+                Workspace& w = m_work[part];
+                for (size_t f = first + blocks.begin(part); f < first + blocks.end(part); f++)
+                {
+                    window_frame(in, f * m_hop, w.frame.data());
+                    p.fwd(w.frame.data(), w.spectrum.data(), w.dftBuf.data());
+                    detail::scale_spectrum(m_scale, w.spectrum.data(), out + ((firstRow + f) % rows) * outStride, (int)fftLength);
+                }
+            });
+        }
+
+        // Windows the frame starting start samples into [history, in], which may straddle the two
+        void window_frame(const T* in, size_t start, T* frame) const
+        {
+            size_t fromHistory = start < m_historyLength ? std::min(m_historyLength - start, m_frameLength) : 0;
+            if (fromHistory > 0)
+                math::Mul(m_window.data(), m_history.data() + start, frame, (int)fromHistory);
+            if (fromHistory < m_frameLength)
+            {
+                const T* src = in + (start + fromHistory - m_historyLength);
+                math::Mul(m_window.data() + fromHistory, src, frame + fromHistory, (int)(m_frameLength - fromHistory));
+            }
+        }
+
+        // Keeps the samples from the start of the next frame onwards, or records how many to skip to reach it
+        void keep_tail(const T* in, size_t len, size_t count)
+        {
+            const size_t available = m_historyLength + len;
+            const size_t next = count * m_hop;
+            if (next >= available)
+            {
+                m_skip = next - available;
+                m_historyLength = 0;
+                return;
+            }
+
+            size_t keep = available - next; // always less than the frame length
+            if (next < m_historyLength)
+            {
+                // Part of the old history survives; slide it down, then append all the input
+                size_t oldKept = m_historyLength - next;
+                if (next > 0)
+                    std::copy(m_history.data() + next, m_history.data() + m_historyLength, m_history.data());
+                if (len > 0)
+                    Copy(in, m_history.data() + oldKept, (int)len);
+            }
+            else
+            {
+                Copy(in + (next - m_historyLength), m_history.data(), (int)keep);
+            }
+            m_historyLength = keep;
+        }
+    };
+}
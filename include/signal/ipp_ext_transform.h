@@ -1,3 +1,4 @@
 #pragma once
 
-#include "transform/Goertz.h"
\ No newline at end of file
+#include "transform/Goertz.h"
+#include "transform/Window.h"
\ No newline at end of file
@@ -8,7 +8,10 @@ multiply defined symbols errors do not occur.
 #include "ipp.h"
 #include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include "../ipp_ext_errors.h"
+#include "../ipp_ext_pool.h"
 #include "ipp_ext_copy.h"
 
 #ifndef NDEBUG
@@ -23,7 +26,12 @@ namespace ipps
 
 // TODO: there are some issues with using a size_t as numel and cap,
 // since all the IPP functions use ints for lengths, so we make a cast for those calls.
-// Inevitably, this will cause issues if the actual length is larger than INT_MAX.
+// Copies (and the size_t overloads of the math/convert/stats/logical wrappers) are split into
+// int-sized chunks, see ipp_ext_chunked.h; zero() and set() still cast, and break past INT_MAX.
+
+// Lazy elementwise expressions, see ipp_ext_expr.h
+template <typename E>
+struct expression;
 
 template <typename T>
 class vector
@@ -32,10 +40,20 @@ protected:
     size_t numel = 0;
     size_t cap = 0;
     T *m_data = nullptr; // initialise as nullptr to prevent segfaults on first reserve
+    bool m_pooled = ippe::pool::enabled(); // whether m_data comes from (and goes back to) ippe::pool
 
     // Helper functions
     bool isZero(const T &value); // see specializations below
 
+    // Frees m_data according to how it was allocated
+    void internal_free()
+    {
+        if (m_pooled)
+            ippe::pool::release(m_data, cap);
+        else
+            ippsFree(m_data);
+    }
+
 public:
     // Constructors
 
@@ -69,16 +87,15 @@ public:
 
     // Copy constructor
     vector(const vector &other)
-    : numel(other.numel)
+    : numel(other.numel), m_pooled(other.m_pooled)
     {
         DEBUG("vector(const vector &other)\n");
 
         // set cap (and frees existing memory)
         reserve(numel); // even if count is 0, reserve() will do nothing
         // copy data
-        // Copy<T>(other.m_data, m_data, (int)numel); // cannot do this as some types dont have a copy
-        for (size_t i = 0; i < numel; i++)
-            m_data[i] = other.m_data[i]; // TODO: write using ippsCopy? would require template specializations
+        if (numel > 0)
+            Copy<T>(other.m_data, m_data, numel);
     }
 
     // Copy Assignment operator
@@ -86,20 +103,24 @@ public:
     {
         DEBUG("vector& operator=(const vector &other)\n");
 
-        // set size
-        numel = other.numel;
-        // set cap
-        reserve(numel); // even if count is 0, reserve() will do nothing
-        // copy data
-        // Copy<T>(other.m_data, m_data, (int)numel);
-        for (size_t i = 0; i < numel; i++)
-            m_data[i] = other.m_data[i]; // TODO: write using ippsCopy? would require template specializations
+        if (this != &other)
+        {
+            // clear first so that reserve() doesn't copy data we are about to overwrite
+            numel = 0;
+            // set cap
+            reserve(other.numel); // even if count is 0, reserve() will do nothing
+            // set size
+            numel = other.numel;
+            // copy data
+            if (numel > 0)
+                Copy<T>(other.m_data, m_data, numel);
+        }
         return *this;
     }
 
     // Move constructor
     vector(vector &&other)
-    : numel(other.numel), cap(other.cap), m_data(other.m_data)
+    : numel(other.numel), cap(other.cap), m_data(other.m_data), m_pooled(other.m_pooled)
     {
         DEBUG("vector(vector &&other)\n");
 
@@ -116,11 +137,12 @@ public:
         {
             DEBUG("vector& operator=(vector &&other)\n");
             // Free existing resource
-            ippsFree(m_data);
+            internal_free();
             // move parameters
             numel = other.numel;
             cap = other.cap;
             m_data = other.m_data;
+            m_pooled = other.m_pooled;
             // nullify the other
             other.m_data = nullptr;
             other.cap = 0;
@@ -129,11 +151,95 @@ public:
         return *this;
     }
 
+    // Construct by evaluating a lazy expression (see ipp_ext_expr.h), e.g.
+    // ipps::vector<Ipp32f> z = a * b + c * d;
+    // The result is the only allocation made for the whole expression.
+    template <typename E>
+    vector(const expression<E> &expr)
+    {
+        DEBUG("vector(const expression<E> &expr)\n");
+        static_assert(std::is_same<typename E::value_type, T>::value, "Expression type must match the vector type");
+        numel = expr.size();
+        reserve(numel);
+        expr.derived().evaluate(m_data, numel);
+    }
+
+    // Evaluates a lazy expression into this vector, resizing it if required.
+    // The vector may also appear inside the expression, e.g. z = z * a + b;
+    template <typename E>
+    vector& operator=(const expression<E> &expr)
+    {
+        DEBUG("vector& operator=(const expression<E> &expr)\n");
+        static_assert(std::is_same<typename E::value_type, T>::value, "Expression type must match the vector type");
+        if (numel != expr.size())
+        {
+            // Resizing could move or shorten memory that the expression still reads from,
+            // so in that case evaluate into a new vector and take its memory instead
+            if (m_data != nullptr && expr.derived().aliases(m_data, m_data + cap))
+            {
+                vector result;
+                result.setPooled(m_pooled);
+                result.resize(expr.size());
+                expr.derived().evaluate(result.m_data, result.numel);
+                *this = std::move(result);
+                return *this;
+            }
+            resize(expr.size());
+        }
+        expr.derived().evaluate(m_data, numel);
+        return *this;
+    }
+
 
     ~vector()
     {
         DEBUG("~vector()\n");
-        ippsFree(m_data);
+        internal_free();
+    }
+
+    // Choose whether this instance allocates through ippe::pool (the default is ippe::pool::enabled()).
+    // Any existing data is moved over to the new allocation scheme.
+    void setPooled(bool pooled)
+    {
+        if (pooled == m_pooled)
+            return;
+
+        if (m_data == nullptr)
+        {
+            m_pooled = pooled;
+            return;
+        }
+
+        // Re-reserve the same capacity using the other scheme
+        T *old_data = m_data;
+        size_t old_cap = cap;
+        bool old_pooled = m_pooled;
+        m_data = nullptr;
+        cap = 0;
+        m_pooled = pooled;
+        try
+        {
+            reserve(old_cap); // nothing is copied since m_data is null
+        }
+        catch (...)
+        {
+            m_data = old_data;
+            cap = old_cap;
+            m_pooled = old_pooled;
+            throw;
+        }
+        if (numel > 0)
+            Copy<T>(old_data, m_data, numel);
+
+        if (old_pooled)
+            ippe::pool::release(old_data, old_cap);
+        else
+            ippsFree(old_data);
+    }
+
+    bool isPooled() const
+    {
+        return m_pooled;
     }
 
     void resize(size_t new_count)
@@ -332,21 +438,19 @@ inline void vector<Ipp8u>::reserve(size_t new_cap)
     if (new_cap > cap)
     {
         // allocate new memory
-        Ipp8u *newm_data = ippsMalloc_8u_L(new_cap);
+        Ipp8u *newm_data = m_pooled ? ippe::pool::allocate<Ipp8u>(new_cap) : ippsMalloc_8u_L(new_cap);
         // check that memory was allocated
         if (newm_data == NULL)
             throw std::bad_alloc();
 
-        // copy the existing data first
-        if (m_data != nullptr)
+        // copy the existing elements first
+        if (m_data != nullptr && numel > 0)
         {
-            Copy<Ipp8u>(m_data, newm_data, (int)cap);
-            // IppStatus sts = ippsCopy_8u(m_data, newm_data, (int)cap);
-            // IPP_NO_ERROR(sts, "ippsCopy_8u");
+            Copy<Ipp8u>(m_data, newm_data, numel);
         }
 
         // free the old memory
-        ippsFree(m_data);
+        internal_free();
         // set the new data
         m_data = newm_data;
         // set the new capacity
@@ -361,21 +465,19 @@ inline void vector<Ipp16u>::reserve(size_t new_cap)
     if (new_cap > cap)
     {
         // allocate new memory
-        Ipp16u *newm_data = ippsMalloc_16u_L(new_cap);
+        Ipp16u *newm_data = m_pooled ? ippe::pool::allocate<Ipp16u>(new_cap) : ippsMalloc_16u_L(new_cap);
         // check that memory was allocated
         if (newm_data == NULL)
             throw std::bad_alloc();
 
-        // copy the existing data first
-        if (m_data != nullptr)
+        // copy the existing elements first
+        if (m_data != nullptr && numel > 0)
         {
-            Copy<Ipp16u>(m_data, newm_data, (int)cap);
-            // IppStatus sts = ippsCopy_16s((Ipp16s*)m_data, (Ipp16s*)newm_data, (int)cap); // wrap as 16s
-            // IPP_NO_ERROR(sts, "ippsCopy_16s");
+            Copy<Ipp16u>(m_data, newm_data, numel);
         }
 
         // free the old memory
-        ippsFree(m_data);
+        internal_free();
         // set the new data
         m_data = newm_data;
         // set the new capacity
@@ -390,21 +492,19 @@ inline void vector<Ipp32u>::reserve(size_t new_cap)
     if (new_cap > cap)
     {
         // allocate new memory
-        Ipp32u *newm_data = ippsMalloc_32u_L(new_cap);
+        Ipp32u *newm_data = m_pooled ? ippe::pool::allocate<Ipp32u>(new_cap) : ippsMalloc_32u_L(new_cap);
         // check that memory was allocated
         if (newm_data == NULL)
             throw std::bad_alloc();
 
-        // copy the existing data first
-        if (m_data != nullptr)
+        // copy the existing elements first
+        if (m_data != nullptr && numel > 0)
         {
-            Copy<Ipp32s>((Ipp32s*)m_data, (Ipp32s*)newm_data, (int)cap);
-            // IppStatus sts = ippsCopy_32s((Ipp32s*)m_data, (Ipp32s*)newm_data, (int)cap); // wrap as 32s
-            // IPP_NO_ERROR(sts, "ippsCopy_32s");
+            Copy<Ipp32u>(m_data, newm_data, numel);
         }
 
         // free the old memory
-        ippsFree(m_data);
+        internal_free();
         // set the new data
         m_data = newm_data;
         // set the new capacity
@@ -419,21 +519,19 @@ inline void vector<Ipp64u>::reserve(size_t new_cap)
     if (new_cap > cap)
     {
         // allocate new memory
-        Ipp64u *newm_data = (Ipp64u*)ippsMalloc_64s_L(new_cap);
+        Ipp64u *newm_data = m_pooled ? ippe::pool::allocate<Ipp64u>(new_cap) : (Ipp64u*)ippsMalloc_64s_L(new_cap);
         // check that memory was allocated
         if (newm_data == NULL)
             throw std::bad_alloc();
 
-        // copy the existing data first
-        if (m_data != nullptr)
+        // copy the existing elements first
+        if (m_data != nullptr && numel > 0)
         {
-            Copy<Ipp64s>((Ipp64s*)m_data, (Ipp64s*)newm_data, (int)cap);
-            // IppStatus sts = ippsCopy_64s((Ipp64s*)m_data, (Ipp64s*)newm_data, (int)cap); // wrap as 64s
-            // IPP_NO_ERROR(sts, "ippsCopy_64s");
+            Copy<Ipp64u>(m_data, newm_data, numel);
         }
 
         // free the old memory
-        ippsFree(m_data);
+        internal_free();
         // set the new data
         m_data = newm_data;
         // set the new capacity
@@ -448,21 +546,19 @@ inline void vector<Ipp8s>::reserve(size_t new_cap)
     if (new_cap > cap)
     {
         // allocate new memory
-        Ipp8s *newm_data = ippsMalloc_8s_L(new_cap);
+        Ipp8s *newm_data = m_pooled ? ippe::pool::allocate<Ipp8s>(new_cap) : ippsMalloc_8s_L(new_cap);
         // check that memory was allocated
         if (newm_data == NULL)
             throw std::bad_alloc();
 
-        // copy the existing data first
-        if (m_data != nullptr)
+        // copy the existing elements first
+        if (m_data != nullptr && numel > 0)
         {
-            Copy<Ipp8u>((Ipp8u*)m_data, (Ipp8u*)newm_data, (int)cap);
-            // IppStatus sts = ippsCopy_8u((Ipp8u*)m_data, (Ipp8u*)newm_data, (int)cap); // wrap as 8u
-            // IPP_NO_ERROR(sts, "ippsCopy_8u");
+            Copy<Ipp8s>(m_data, newm_data, numel);
         }
 
         // free the old memory
-        ippsFree(m_data);
+        internal_free();
         // set the new data
         m_data = newm_data;
         // set the new capacity
@@ -477,21 +573,19 @@ inline void vector<Ipp16s>::reserve(size_t new_cap)
     if (new_cap > cap)
     {
         // allocate new memory
-        Ipp16s *newm_data = ippsMalloc_16s_L(new_cap);
+        Ipp16s *newm_data = m_pooled ? ippe::pool::allocate<Ipp16s>(new_cap) : ippsMalloc_16s_L(new_cap);
         // check that memory was allocated
         if (newm_data == NULL)
             throw std::bad_alloc();
 
-        // copy the existing data first
-        if (m_data != nullptr)
+        // copy the existing elements first
+        if (m_data != nullptr && numel > 0)
         {
-            Copy<Ipp16s>(m_data, newm_data, (int)cap);
-            // IppStatus sts = ippsCopy_16s((Ipp16s*)m_data, (Ipp16s*)newm_data, (int)cap);
-            // IPP_NO_ERROR(sts, "ippsCopy_16s");
+            Copy<Ipp16s>(m_data, newm_data, numel);
         }
 
         // free the old memory
-        ippsFree(m_data);
+        internal_free();
         // set the new data
         m_data = newm_data;
         // set the new capacity
@@ -506,21 +600,19 @@ inline void vector<Ipp32s>::reserve(size_t new_cap)
     if (new_cap > cap)
     {
         // allocate new memory
-        Ipp32s *newm_data = ippsMalloc_32s_L(new_cap);
+        Ipp32s *newm_data = m_pooled ? ippe::pool::allocate<Ipp32s>(new_cap) : ippsMalloc_32s_L(new_cap);
         // check that memory was allocated
         if (newm_data == NULL)
             throw std::bad_alloc();
 
-        // copy the existing data first
-        if (m_data != nullptr)
+        // copy the existing elements first
+        if (m_data != nullptr && numel > 0)
         {
-            Copy<Ipp32s>(m_data, newm_data, (int)cap);
-            // IppStatus sts = ippsCopy_32s((Ipp32s*)m_data, (Ipp32s*)newm_data, (int)cap);
-            // IPP_NO_ERROR(sts, "ippsCopy_32s");
+            Copy<Ipp32s>(m_data, newm_data, numel);
         }
 
         // free the old memory
-        ippsFree(m_data);
+        internal_free();
         // set the new data
         m_data = newm_data;
         // set the new capacity
@@ -535,21 +627,19 @@ inline void vector<Ipp64s>::reserve(size_t new_cap)
     if (new_cap > cap)
     {
         // allocate new memory
-        Ipp64s *newm_data = ippsMalloc_64s_L(new_cap);
+        Ipp64s *newm_data = m_pooled ? ippe::pool::allocate<Ipp64s>(new_cap) : ippsMalloc_64s_L(new_cap);
         // check that memory was allocated
         if (newm_data == NULL)
             throw std::bad_alloc();
 
-        // copy the existing data first
-        if (m_data != nullptr)
+        // copy the existing elements first
+        if (m_data != nullptr && numel > 0)
         {
-            Copy<Ipp64s>(m_data, newm_data, (int)cap);
-            // IppStatus sts = ippsCopy_64s((Ipp64s*)m_data, (Ipp64s*)newm_data, (int)cap);
-            // IPP_NO_ERROR(sts, "ippsCopy_64s");
+            Copy<Ipp64s>(m_data, newm_data, numel);
         }
 
         // free the old memory
-        ippsFree(m_data);
+        internal_free();
         // set the new data
         m_data = newm_data;
         // set the new capacity
@@ -564,21 +654,19 @@ inline void vector<Ipp32f>::reserve(size_t new_cap)
     if (new_cap > cap)
     {
         // allocate new memory
-        Ipp32f *newm_data = ippsMalloc_32f_L(new_cap);
+        Ipp32f *newm_data = m_pooled ? ippe::pool::allocate<Ipp32f>(new_cap) : ippsMalloc_32f_L(new_cap);
         // check that memory was allocated
         if (newm_data == NULL)
             throw std::bad_alloc();
 
-        // copy the existing data first
-        if (m_data != nullptr)
+        // copy the existing elements first
+        if (m_data != nullptr && numel > 0)
         {
-            Copy<Ipp32f>(m_data, newm_data, (int)cap);
-            // IppStatus sts = ippsCopy_32f((Ipp32f*)m_data, (Ipp32f*)newm_data, (int)cap);
-            // IPP_NO_ERROR(sts, "ippsCopy_32f");
+            Copy<Ipp32f>(m_data, newm_data, numel);
         }
 
         // free the old memory
-        ippsFree(m_data);
+        internal_free();
         // set the new data
         m_data = newm_data;
         // set the new capacity
@@ -593,21 +681,19 @@ inline void vector<Ipp64f>::reserve(size_t new_cap)
     if (new_cap > cap)
     {
         // allocate new memory
-        Ipp64f *newm_data = ippsMalloc_64f_L(new_cap);
+        Ipp64f *newm_data = m_pooled ? ippe::pool::allocate<Ipp64f>(new_cap) : ippsMalloc_64f_L(new_cap);
         // check that memory was allocated
         if (newm_data == NULL)
             throw std::bad_alloc();
 
-        // copy the existing data first
-        if (m_data != nullptr)
+        // copy the existing elements first
+        if (m_data != nullptr && numel > 0)
         {
-            Copy<Ipp64f>(m_data, newm_data, (int)cap);
-            // IppStatus sts = ippsCopy_64f((Ipp64f*)m_data, (Ipp64f*)newm_data, (int)cap);
-            // IPP_NO_ERROR(sts, "ippsCopy_64f");
+            Copy<Ipp64f>(m_data, newm_data, numel);
         }
 
         // free the old memory
-        ippsFree(m_data);
+        internal_free();
         // set the new data
         m_data = newm_data;
         // set the new capacity
@@ -622,21 +708,19 @@ inline void vector<Ipp8sc>::reserve(size_t new_cap)
     if (new_cap > cap)
     {
         // allocate new memory
-        Ipp8sc *newm_data = ippsMalloc_8sc_L(new_cap);
+        Ipp8sc *newm_data = m_pooled ? ippe::pool::allocate<Ipp8sc>(new_cap) : ippsMalloc_8sc_L(new_cap);
         // check that memory was allocated
         if (newm_data == NULL)
             throw std::bad_alloc();
 
-        // copy the existing data first
-        if (m_data != nullptr)
+        // copy the existing elements first
+        if (m_data != nullptr && numel > 0)
         {
-            Copy<Ipp16s>((Ipp16s*)m_data, (Ipp16s*)newm_data, (int)cap);
-            // IppStatus sts = ippsCopy_16s((Ipp16s*)m_data, (Ipp16s*)newm_data, (int)cap); // wrap as 16s
-            // IPP_NO_ERROR(sts, "ippsCopy_16s");
+            Copy<Ipp8sc>(m_data, newm_data, numel);
         }
 
         // free the old memory
-        ippsFree(m_data);
+        internal_free();
         // set the new data
         m_data = newm_data;
         // set the new capacity
@@ -651,21 +735,19 @@ inline void vector<Ipp16sc>::reserve(size_t new_cap)
     if (new_cap > cap)
     {
         // allocate new memory
-        Ipp16sc *newm_data = ippsMalloc_16sc_L(new_cap);
+        Ipp16sc *newm_data = m_pooled ? ippe::pool::allocate<Ipp16sc>(new_cap) : ippsMalloc_16sc_L(new_cap);
         // check that memory was allocated
         if (newm_data == NULL)
             throw std::bad_alloc();
 
-        // copy the existing data first
-        if (m_data != nullptr)
+        // copy the existing elements first
+        if (m_data != nullptr && numel > 0)
         {
-            Copy<Ipp16sc>(m_data, newm_data, (int)cap);
-            // IppStatus sts = ippsCopy_16sc((Ipp16sc*)m_data, (Ipp16sc*)newm_data, (int)cap);
-            // IPP_NO_ERROR(sts, "ippsCopy_16sc");
+            Copy<Ipp16sc>(m_data, newm_data, numel);
         }
 
         // free the old memory
-        ippsFree(m_data);
+        internal_free();
         // set the new data
         m_data = newm_data;
         // set the new capacity
@@ -680,21 +762,19 @@ inline void vector<Ipp32sc>::reserve(size_t new_cap)
     if (new_cap > cap)
     {
         // allocate new memory
-        Ipp32sc *newm_data = ippsMalloc_32sc_L(new_cap);
+        Ipp32sc *newm_data = m_pooled ? ippe::pool::allocate<Ipp32sc>(new_cap) : ippsMalloc_32sc_L(new_cap);
         // check that memory was allocated
         if (newm_data == NULL)
             throw std::bad_alloc();
 
-        // copy the existing data first
-        if (m_data != nullptr)
+        // copy the existing elements first
+        if (m_data != nullptr && numel > 0)
         {
-            Copy<Ipp32sc>(m_data, newm_data, (int)cap);
-            // IppStatus sts = ippsCopy_32sc((Ipp32sc*)m_data, (Ipp32sc*)newm_data, (int)cap);
-            // IPP_NO_ERROR(sts, "ippsCopy_32sc");
+            Copy<Ipp32sc>(m_data, newm_data, numel);
         }
 
         // free the old memory
-        ippsFree(m_data);
+        internal_free();
         // set the new data
         m_data = newm_data;
         // set the new capacity
@@ -709,21 +789,19 @@ inline void vector<Ipp64sc>::reserve(size_t new_cap)
     if (new_cap > cap)
     {
         // allocate new memory
-        Ipp64sc *newm_data = ippsMalloc_64sc_L(new_cap);
+        Ipp64sc *newm_data = m_pooled ? ippe::pool::allocate<Ipp64sc>(new_cap) : ippsMalloc_64sc_L(new_cap);
         // check that memory was allocated
         if (newm_data == NULL)
             throw std::bad_alloc();
 
-        // copy the existing data first
-        if (m_data != nullptr)
+        // copy the existing elements first
+        if (m_data != nullptr && numel > 0)
         {
-            Copy<Ipp64sc>(m_data, newm_data, (int)cap);
-            // IppStatus sts = ippsCopy_64sc((Ipp64sc*)m_data, (Ipp64sc*)newm_data, (int)cap);
-            // IPP_NO_ERROR(sts, "ippsCopy_64sc");
+            Copy<Ipp64sc>(m_data, newm_data, numel);
         }
 
         // free the old memory
-        ippsFree(m_data);
+        internal_free();
         // set the new data
         m_data = newm_data;
         // set the new capacity
@@ -738,21 +816,19 @@ inline void vector<Ipp32fc>::reserve(size_t new_cap)
     if (new_cap > cap)
     {
         // allocate new memory
-        Ipp32fc *newm_data = ippsMalloc_32fc_L(new_cap);
+        Ipp32fc *newm_data = m_pooled ? ippe::pool::allocate<Ipp32fc>(new_cap) : ippsMalloc_32fc_L(new_cap);
         // check that memory was allocated
         if (newm_data == NULL)
             throw std::bad_alloc();
 
-        // copy the existing data first
-        if (m_data != nullptr)
+        // copy the existing elements first
+        if (m_data != nullptr && numel > 0)
         {
-            Copy<Ipp32fc>(m_data, newm_data, (int)cap);
-            // IppStatus sts = ippsCopy_32fc((Ipp32fc*)m_data, (Ipp32fc*)newm_data, (int)cap);
-            // IPP_NO_ERROR(sts, "ippsCopy_32fc");
+            Copy<Ipp32fc>(m_data, newm_data, numel);
         }
 
         // free the old memory
-        ippsFree(m_data);
+        internal_free();
         // set the new data
         m_data = newm_data;
         // set the new capacity
@@ -767,21 +843,19 @@ inline void vector<Ipp64fc>::reserve(size_t new_cap)
     if (new_cap > cap)
     {
         // allocate new memory
-        Ipp64fc *newm_data = ippsMalloc_64fc_L(new_cap);
+        Ipp64fc *newm_data = m_pooled ? ippe::pool::allocate<Ipp64fc>(new_cap) : ippsMalloc_64fc_L(new_cap);
         // check that memory was allocated
         if (newm_data == NULL)
             throw std::bad_alloc();
 
-        // copy the existing data first, if it exists
-        if (m_data != nullptr)
+        // copy the existing elements first, if they exist
+        if (m_data != nullptr && numel > 0)
         {
-            Copy<Ipp64fc>(m_data, newm_data, (int)cap);
-            // IppStatus sts = ippsCopy_64fc((Ipp64fc*)m_data, (Ipp64fc*)newm_data, (int)cap);
-            // IPP_NO_ERROR(sts, "ippsCopy_64fc");
+            Copy<Ipp64fc>(m_data, newm_data, numel);
         }
 
         // free the old memory
-        ippsFree(m_data);
+        internal_free();
         // set the new data
         m_data = newm_data;
         // set the new capacity
@@ -0,0 +1,297 @@
+/*
+Non-owning views over IPP-typed memory.
+
+A vector_view<T> is just a pointer, a length and a stride (in elements).
+With a stride of 1 it is a plain contiguous span, and can be handed straight to the IPP functions;
+with any other stride (e.g. a matrix column) the view-accepting overloads in math::, stats::,
+convert:: and DFTCToC process it in small tiles that are gathered into (and scattered from)
+stack buffers, so no heap allocation takes place.
+
+Example:
+    ipps::vector<Ipp32fc> capture(1000000);
+    ipps::vector_view<Ipp32fc> frame(capture, 4096, 1024); // elements [4096, 5120)
+    ipps::vector_view<Ipp32fc> evens = frame.strided(2); // every other element of the frame
+*/
+
+#pragma once
+
+#include "ipp.h"
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "ipp_ext_vec.h"
+#include "ipp_ext_chunked.h"
+
+namespace ipps
+{
+    template <typename T>
+    class vector_view
+    {
+    public:
+        typedef typename std::remove_const<T>::type value_type;
+
+        vector_view() {}
+
+        /// @brief View over raw memory.
+        /// @param data Pointer to the first element.
+        /// @param size Number of elements in the view.
+        /// @param stride Distance between consecutive elements, in elements.
+        vector_view(T* data, size_t size, ptrdiff_t stride = 1)
+            : m_data(data), m_size(size), m_stride(stride)
+        {}
+
+        /// @brief View over an entire vector.
+        vector_view(vector<value_type>& v)
+            : m_data(v.data()), m_size(v.size())
+        {}
+
+        /// @brief Read-only view over an entire vector.
+        vector_view(const vector<value_type>& v)
+            : m_data(v.data()), m_size(v.size())
+        {}
+
+        /// @brief View over a sub-range of a vector.
+        vector_view(vector<value_type>& v, size_t offset, size_t count)
+            : m_data(v.data() + offset), m_size(count)
+        {
+            if (offset + count > v.size())
+                throw std::out_of_range("vector_view: range exceeds vector size " + std::to_string(v.size()));
+        }
+
+        /// @brief Read-only view over a sub-range of a vector.
+        vector_view(const vector<value_type>& v, size_t offset, size_t count)
+            : m_data(v.data() + offset), m_size(count)
+        {
+            if (offset + count > v.size())
+                throw std::out_of_range("vector_view: range exceeds vector size " + std::to_string(v.size()));
+        }
+
+        /// @brief Allows a mutable view to be passed where a read-only view is expected.
+        template <typename U, typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+        vector_view(const vector_view<U>& other)
+            : m_data(other.data()), m_size(other.size()), m_stride(other.stride())
+        {}
+
+        T* data() const { return m_data; }
+        size_t size() const { return m_size; }
+        ptrdiff_t stride() const { return m_stride; }
+        bool empty() const { return m_size == 0; }
+        bool contiguous() const { return m_stride == 1; }
+
+        // No bounds checking, like vector
+        T& operator[](size_t pos) const { return m_data[(ptrdiff_t)pos * m_stride]; }
+
+        T& at(size_t pos) const
+        {
+            if (pos >= m_size)
+                throw std::out_of_range("vector_view::at: Size is " + std::to_string(m_size));
+            return (*this)[pos];
+        }
+
+        /// @brief Sub-range of this view, in units of this view's elements.
+        vector_view subview(size_t offset, size_t count) const
+        {
+            if (offset + count > m_size)
+                throw std::out_of_range("vector_view::subview: range exceeds view size " + std::to_string(m_size));
+            return vector_view(m_data + (ptrdiff_t)offset * m_stride, count, m_stride);
+        }
+
+        /// @brief Every step'th element of this view.
+        vector_view strided(size_t step) const
+        {
+            if (step == 0)
+                throw std::invalid_argument("vector_view::strided: step cannot be 0");
+            return vector_view(m_data, (m_size + step - 1) / step, m_stride * (ptrdiff_t)step);
+        }
+
+    private:
+        T* m_data = nullptr;
+        size_t m_size = 0;
+        ptrdiff_t m_stride = 1;
+    };
+
+    namespace detail
+    {
+        // Number of elements processed per tile for strided views.
+        // Small enough that a handful of Ipp64fc tiles comfortably fit on the stack and in L1.
+        const size_t VIEW_TILE = 256;
+
+        inline void checkViewSizes(size_t a, size_t b, const char* funcName)
+        {
+            if (a != b)
+                throw std::invalid_argument(std::string(funcName) + ": view sizes do not match (" +
+                    std::to_string(a) + " vs " + std::to_string(b) + ")");
+        }
+
+        template <typename T>
+        inline void gather(const vector_view<T>& v, size_t offset, size_t len, typename vector_view<T>::value_type* out)
+        {
+            for (size_t i = 0; i < len; i++)
+                out[i] = v[offset + i];
+        }
+
+        template <typename T>
+        inline void scatter(const typename vector_view<T>::value_type* in, const vector_view<T>& v, size_t offset, size_t len)
+        {
+            for (size_t i = 0; i < len; i++)
+                v[offset + i] = in[i];
+        }
+
+        /// @brief Runs kernel(const A* a, C* c, int len) over two equally sized views.
+        /// @param loadOutput Set if the kernel reads the output as well (e.g. accumulations).
+        template <typename A, typename C, typename F>
+        inline void unaryTiles(const vector_view<A>& a, const vector_view<C>& c, F kernel, bool loadOutput = false)
+        {
+            typedef typename vector_view<A>::value_type An;
+            typedef typename vector_view<C>::value_type Cn;
+
+            if (a.contiguous() && c.contiguous())
+            {
+                if (a.size() > 0)
+                    kernel(a.data(), c.data(), (int)a.size());
+                return;
+            }
+
+            An abuf[VIEW_TILE];
+            Cn cbuf[VIEW_TILE];
+            for (size_t offset = 0; offset < a.size(); offset += VIEW_TILE)
+            {
+                size_t len = a.size() - offset < VIEW_TILE ? a.size() - offset : VIEW_TILE;
+
+                const An* ap = a.data() + offset;
+                if (!a.contiguous())
+                {
+                    gather(a, offset, len, abuf);
+                    ap = abuf;
+                }
+
+                Cn* cp = c.data() + offset;
+                if (!c.contiguous())
+                {
+                    if (loadOutput)
+                        gather(c, offset, len, cbuf);
+                    cp = cbuf;
+                }
+
+                kernel(ap, cp, (int)len);
+
+                if (!c.contiguous())
+                    scatter(cbuf, c, offset, len);
+            }
+        }
+
+        /// @brief Runs kernel(const A* a, const B* b, C* c, int len) over three equally sized views.
+        /// @param loadOutput Set if the kernel reads the output as well (e.g. accumulations).
+        template <typename A, typename B, typename C, typename F>
+        inline void binaryTiles(const vector_view<A>& a, const vector_view<B>& b, const vector_view<C>& c, F kernel, bool loadOutput = false)
+        {
+            typedef typename vector_view<A>::value_type An;
+            typedef typename vector_view<B>::value_type Bn;
+            typedef typename vector_view<C>::value_type Cn;
+
+            if (a.contiguous() && b.contiguous() && c.contiguous())
+            {
+                if (a.size() > 0)
+                    kernel(a.data(), b.data(), c.data(), (int)a.size());
+                return;
+            }
+
+            An abuf[VIEW_TILE];
+            Bn bbuf[VIEW_TILE];
+            Cn cbuf[VIEW_TILE];
+            for (size_t offset = 0; offset < a.size(); offset += VIEW_TILE)
+            {
+                size_t len = a.size() - offset < VIEW_TILE ? a.size() - offset : VIEW_TILE;
+
+                const An* ap = a.data() + offset;
+                if (!a.contiguous())
+                {
+                    gather(a, offset, len, abuf);
+                    ap = abuf;
+                }
+
+                const Bn* bp = b.data() + offset;
+                if (!b.contiguous())
+                {
+                    gather(b, offset, len, bbuf);
+                    bp = bbuf;
+                }
+
+                Cn* cp = c.data() + offset;
+                if (!c.contiguous())
+                {
+                    if (loadOutput)
+                        gather(c, offset, len, cbuf);
+                    cp = cbuf;
+                }
+
+                kernel(ap, bp, cp, (int)len);
+
+                if (!c.contiguous())
+                    scatter(cbuf, c, offset, len);
+            }
+        }
+
+        /// @brief Runs kernel(const A* a, int len, size_t offset) over a view, tile by tile.
+        /// Used for reductions, which combine the per-tile results themselves.
+        template <typename A, typename F>
+        inline void reduceTiles(const vector_view<A>& a, F kernel)
+        {
+            typedef typename vector_view<A>::value_type An;
+
+            if (a.contiguous())
+            {
+                if (a.size() > 0)
+                    kernel(a.data(), (int)a.size(), (size_t)0);
+                return;
+            }
+
+            An abuf[VIEW_TILE];
+            for (size_t offset = 0; offset < a.size(); offset += VIEW_TILE)
+            {
+                size_t len = a.size() - offset < VIEW_TILE ? a.size() - offset : VIEW_TILE;
+                gather(a, offset, len, abuf);
+                kernel((const An*)abuf, (int)len, offset);
+            }
+        }
+
+        /// @brief Two-input version of reduceTiles, kernel(const A* a, const B* b, int len, size_t offset).
+        template <typename A, typename B, typename F>
+        inline void reduceTiles(const vector_view<A>& a, const vector_view<B>& b, F kernel)
+        {
+            typedef typename vector_view<A>::value_type An;
+            typedef typename vector_view<B>::value_type Bn;
+
+            if (a.contiguous() && b.contiguous())
+            {
+                if (a.size() > 0)
+                    kernel(a.data(), b.data(), (int)a.size(), (size_t)0);
+                return;
+            }
+
+            An abuf[VIEW_TILE];
+            Bn bbuf[VIEW_TILE];
+            for (size_t offset = 0; offset < a.size(); offset += VIEW_TILE)
+            {
+                size_t len = a.size() - offset < VIEW_TILE ? a.size() - offset : VIEW_TILE;
+
+                const An* ap = a.data() + offset;
+                if (!a.contiguous())
+                {
+                    gather(a, offset, len, abuf);
+                    ap = abuf;
+                }
+
+                const Bn* bp = b.data() + offset;
+                if (!b.contiguous())
+                {
+                    gather(b, offset, len, bbuf);
+                    bp = bbuf;
+                }
+
+                kernel(ap, bp, (int)len, offset);
+            }
+        }
+    }
+}
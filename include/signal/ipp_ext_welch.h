@@ -0,0 +1,219 @@
+/*
+Welch power spectral density estimate (averaged periodogram), for 32fc/64fc input.
+
+The input is cut into overlapping segments, each windowed and transformed by an ipps::STFT, and the
+segment power spectra are averaged. Data can be pushed incrementally, in chunks of any size, and the
+estimate read back at any point with getPSD().
+
+Mean averaging keeps one running sum per thread, so memory stays constant however much data is pushed.
+Median averaging is more robust to bursts but has to keep every segment's spectrum until getPSD().
+
+The output is the two-sided density, |X|^2 / (sampleRate * sum(w^2)) per bin in the DFT's order, so
+that summing it over the bins and multiplying by sampleRate / fftLength gives the mean power.
+
+Example:
+    ipps::Welch<Ipp32fc> welch(4096, 2048);
+    welch.push(x.data(), x.size());
+    ipps::vector<Ipp32f> psd(welch.getFFTLength());
+    welch.getPSD(psd.data(), 1e6);
+*/
+
+#pragma once
+
+#include "ipp.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ipp_ext_vec.h"
+#include "ipp_ext_copy.h"
+#include "ipp_ext_matrix.h"
+#include "ipp_ext_math.h"
+#include "ipp_ext_parallel.h"
+#include "ipp_ext_stft.h"
+#include "../ipp_ext_errors.h"
+
+namespace ipps
+{
+    /// @brief How the segment spectra are combined.
+    enum class WelchAverage
+    {
+        Mean,
+        Median
+    };
+
+    /// @brief Incremental Welch PSD estimator, for 32fc/64fc.
+    /// @tparam T Input type; the PSD is the matching real type.
+    template <typename T>
+    class Welch
+    {
+    public:
+        typedef typename STFT<T>::real_type real_type;
+
+        Welch()
+        {}
+
+        /// @param segmentLength Samples per segment.
+        /// @param overlap Samples shared by consecutive segments, less than segmentLength (half is the usual choice).
+        /// @param winType Window applied to each segment.
+        /// @param average Mean or median of the segment spectra.
+        /// @param fftLength DFT length, at least segmentLength. 0 uses segmentLength.
+        Welch(size_t segmentLength, size_t overlap, IppWinType winType = ippWinHann,
+              WelchAverage average = WelchAverage::Mean, size_t fftLength = 0)
+            : m_average{average}
+        {
+            if (overlap >= segmentLength)
+                throw std::invalid_argument("Welch: overlap " + std::to_string(overlap) +
+                    " must be less than the segment length " + std::to_string(segmentLength));
+            m_stft = STFT<T>(segmentLength, segmentLength - overlap, winType, STFTScale::Power, fftLength);
+
+            // Window power, for the density scaling
+            const vector<T>& window = m_stft.getWindow();
+            m_windowPower = 0;
+            for (size_t i = 0; i < window.size(); i++)
+                m_windowPower += (double)window[i].re * window[i].re;
+        }
+
+        /// @brief Adds len samples to the estimate. Segments completed by this call are spread over the pool.
+        void push(const T* in, size_t len, parallel::ThreadPool& pool = parallel::defaultPool())
+        {
+            if (m_stft.getFrameLength() == 0)
+                throw std::runtime_error("Welch: not configured, construct with a segment length first");
+
+            const size_t fftLength = m_stft.getFFTLength();
+            const size_t hop = m_stft.getHop();
+
+            // Bound the scratch by feeding the STFT a limited number of segments at a time
+            const size_t maxSegments = segmentsPerThread * pool.size();
+            const size_t maxChunk = maxSegments * hop;
+            if (m_scratch.rows() != maxSegments + 1 || m_scratch.columns() != fftLength)
+                m_scratch = matrix<real_type>(maxSegments + 1, fftLength);
+
+            while (len > 0)
+            {
+                size_t chunk = std::min(len, maxChunk);
+                size_t firstRow = m_stft.getNextRow(m_scratch.rows());
+                size_t count = m_stft.process(in, chunk, m_scratch, pool);
+                if (count > 0)
+                    collect(firstRow, count, pool);
+                in += chunk;
+                len -= chunk;
+            }
+        }
+
+        /// @brief Writes the current estimate, getFFTLength() values, to psd.
+        /// @param sampleRate Sample rate of the input, to give the density per Hz. 1 gives it per cycle/sample.
+        void getPSD(real_type* psd, double sampleRate = 1.0, parallel::ThreadPool& pool = parallel::defaultPool()) const
+        {
+            if (m_segments == 0)
+                throw std::runtime_error("Welch: no complete segments yet");
+
+            const size_t fftLength = m_stft.getFFTLength();
+            double scale = 1.0 / (sampleRate * m_windowPower);
+            if (m_average == WelchAverage::Mean)
+            {
+                // Reduce the per-thread sums
+                Copy(m_sums[0].data(), psd, (int)fftLength);
+                for (size_t i = 1; i < m_sums.size(); i++)
+                    math::Add_I(m_sums[i].data(), psd, (int)fftLength);
+                scale /= (double)m_segments;
+            }
+            else
+            {
+                median(psd, pool);
+                scale /= median_bias(m_segments);
+            }
+            math::MulC_I((real_type)scale, psd, (int)fftLength);
+        }
+
+        /// @brief Discards all pushed data.
+        void reset()
+        {
+            m_stft.reset();
+            for (vector<real_type>& sum : m_sums)
+                sum.zero();
+            m_stored.clear();
+            m_segments = 0;
+        }
+
+        size_t getSegmentLength() const { return m_stft.getFrameLength(); }
+        size_t getOverlap() const { return m_stft.getFrameLength() - m_stft.getHop(); }
+        size_t getFFTLength() const { return m_stft.getFFTLength(); }
+        WelchAverage getAverage() const { return m_average; }
+        /// @brief Number of segments averaged so far.
+        size_t getSegmentCount() const { return m_segments; }
+
+    private:
+        // Segments handed to each thread per STFT call; enough to amortise the pool overhead
+        static const size_t segmentsPerThread = 16;
+
+        WelchAverage m_average = WelchAverage::Mean;
+        STFT<T> m_stft;
+        double m_windowPower = 0;
+        matrix<real_type> m_scratch; // ring of segment spectra from the STFT
+        std::vector<vector<real_type>> m_sums; // one running sum per task, for the mean
+        std::vector<real_type> m_stored; // every segment spectrum, back to back, for the median
+        size_t m_segments = 0;
+
+        void collect(size_t firstRow, size_t count, parallel::ThreadPool& pool)
+        {
+            const size_t fftLength = m_stft.getFFTLength();
+            const size_t rows = m_scratch.rows();
+            if (m_average == WelchAverage::Median)
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    const real_type* row = m_scratch.row((firstRow + i) % rows);
+                    m_stored.insert(m_stored.end(), row, row + fftLength);
+                }
+                m_segments += count;
+                return;
+            }
+
+            // Contiguous blocks of segments, each summed into its own accumulator
+            const parallel::Partition blocks = parallel::partition(count, pool);
+            parallel::prepareTasks(m_sums, blocks.parts, [&](vector<real_type>& sum){
+                if (sum.size() != fftLength)
+                {
+                    sum.resize(fftLength);
+                    sum.zero();
+                }
+            });
+
+            pool.run(blocks.parts, [&](size_t part){
+                real_type* sum = m_sums[part].data();
+                for (size_t s = blocks.begin(part); s < blocks.end(part); s++)
+                    math::Add_I(m_scratch.row((firstRow + s) % rows), sum, (int)fftLength);
+            });
+            m_segments += count;
+        }
+
+        void median(real_type* psd, parallel::ThreadPool& pool) const
+        {
+            const size_t fftLength = m_stft.getFFTLength();
+            const size_t n = m_segments;
+            parallel::forEachRange<real_type>(fftLength, [&](size_t start, size_t len){
+                std::vector<real_type> column(n);
+                for (size_t k = start; k < start + len; k++)
+                {
+                    for (size_t s = 0; s < n; s++)
+                        column[s] = m_stored[s * fftLength + k];
+                    std::nth_element(column.begin(), column.begin() + n / 2, column.end());
+                    real_type mid = column[n / 2];
+                    if (n % 2 == 0)
+                        mid = (mid + *std::max_element(column.begin(), column.begin() + n / 2)) / 2;
+                    psd[k] = mid;
+                }
+            }, pool);
+        }
+
+        // The median of n chi-squared (2 degrees of freedom) periodograms underestimates their mean by this factor
+        static double median_bias(size_t n)
+        {
+            double bias = 1.0;
+            for (size_t k = 1; 2 * k + 1 <= n; k++)
+                bias += 1.0 / (2 * k + 1) - 1.0 / (2 * k);
+            return bias;
+        }
+    };
+}
@@ -0,0 +1,207 @@
+/*
+FFT-based cross-correlation of received segments against a fixed reference, for time-delay estimation.
+
+For a reference r (length M) and a segment s (length L), the correlation at lag k is
+
+    c[k] = sum_n s[n + k] * conj(r[n]),   for k in [-(M-1), L-1]
+
+so a copy of the reference delayed by d samples inside the segment peaks at k = d. The conjugated
+reference spectrum is computed once, so each segment costs one forward DFT, one Mul and one backward
+DFT. The DFT is long enough (M + L - 1 or more) that no lags wrap around.
+
+Example:
+    ipps::CrossCorrelator<Ipp32fc> xc(reference, 4096);
+    ipps::CorrelationPeak<Ipp32fc> peak = xc.correlate(segment.data());
+    // peak.lag is the delay, peak.value the correlation there
+*/
+
+#pragma once
+
+#include "ipp.h"
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ipp_ext_vec.h"
+#include "ipp_ext_copy.h"
+#include "ipp_ext_math.h"
+#include "ipp_ext_convert.h"
+#include "ipp_ext_stats.h"
+#include "ipp_ext_dft.h"
+#include "ipp_ext_parallel.h"
+#include "ipp_ext_dft_real.h"
+#include "../ipp_ext_errors.h"
+
+namespace ipps
+{
+    /// @brief Location and value of the largest correlation magnitude.
+    template <typename T>
+    struct CorrelationPeak
+    {
+        long long lag = 0;  // delay of the segment relative to the reference, in samples
+        size_t index = 0;   // position of the peak in the full correlation output
+        T value{};          // complex correlation at the peak
+        typename detail::complex_real<T>::type power = 0; // |value|^2
+    };
+
+    /// @brief Correlates segments of a fixed length against a cached reference, for 32fc/64fc.
+    template <typename T>
+    class CrossCorrelator
+    {
+    public:
+        typedef typename detail::complex_real<T>::type real_type;
+
+        CrossCorrelator()
+        {}
+
+        /// @param reference The reference waveform.
+        /// @param segmentLength Length of every segment that will be correlated.
+        /// @param fftLength DFT length, at least reference.size() + segmentLength - 1.
+        /// 0 picks the smallest power of 2 that is long enough.
+        CrossCorrelator(const vector<T>& reference, size_t segmentLength, size_t fftLength = 0)
+            : m_referenceLength{reference.size()}, m_segmentLength{segmentLength}
+        {
+            if (reference.size() == 0)
+                throw std::invalid_argument("CrossCorrelator: reference cannot be empty");
+            if (segmentLength == 0)
+                throw std::invalid_argument("CrossCorrelator: segment length cannot be 0");
+
+            size_t minLength = reference.size() + segmentLength - 1;
+            if (fftLength == 0)
+            {
+                fftLength = 1;
+                while (fftLength < minLength)
+                    fftLength <<= 1;
+            }
+            if (fftLength < minLength)
+                throw std::invalid_argument("CrossCorrelator: FFT length " + std::to_string(fftLength) +
+                    " must be at least " + std::to_string(minLength) + " to avoid wrapping");
+
+            m_plan = DFTCToCPlan<T>::cached(fftLength);
+
+            // conj(DFT(reference)), so each segment only needs a Mul
+            m_referenceSpectrum.resize(fftLength);
+            prepare_tasks(1);
+            Workspace& w = m_tasks[0];
+            Copy(reference.data(), w.time.data(), (int)reference.size());
+            m_plan->fwd(w.time.data(), m_referenceSpectrum.data(), w.dftBuf.data());
+            convert::Conj_I(m_referenceSpectrum.data(), (int)fftLength);
+        }
+
+        /// @brief Correlates one segment of getSegmentLength() samples.
+        /// @param out If not null, receives all getFFTLength() correlation values (see lagAt()).
+        /// @return The peak of the correlation magnitude.
+        CorrelationPeak<T> correlate(const T* segment, T* out = nullptr)
+        {
+            check();
+            prepare_tasks(1);
+            return correlate_with(m_tasks[0], segment, out);
+        }
+
+        /// @brief Correlates count segments, spread over the pool.
+        /// @param segments First segment; segment i starts at segments + i * segmentStride.
+        /// @param peaks Receives count peaks.
+        /// @param out If not null, receives each segment's full correlation, at out + i * outStride.
+        void correlateBatch(const T* segments, size_t segmentStride, size_t count, CorrelationPeak<T>* peaks,
+                            T* out = nullptr, size_t outStride = 0,
+                            parallel::ThreadPool& pool = parallel::defaultPool())
+        {
+            check();
+            if (count == 0)
+                return;
+            if (count > 1 && segmentStride < m_segmentLength)
+                throw std::invalid_argument("CrossCorrelator: segment stride must be at least the segment length");
+            if (out != nullptr && count > 1 && outStride < getFFTLength())
+                throw std::invalid_argument("CrossCorrelator: output stride must be at least the FFT length");
+
+            const parallel::Partition blocks = parallel::partition(count, pool);
+            prepare_tasks(blocks.parts);
+
+            pool.run(blocks.parts, [&](size_t part){
+                for (size_t i = blocks.begin(part); i < blocks.end(part); i++)
+                {
+                    T* segmentOut = out != nullptr ? out + i * outStride : nullptr;
+                    peaks[i] = correlate_with(m_tasks[part], segments + i * segmentStride, segmentOut);
+                }
+            });
+        }
+
+        /// @brief The lag held at position index of the full correlation output.
+        long long lagAt(size_t index) const
+        {
+            // Negative lags wrap to the end of the output
+            if (index >= getFFTLength() - (m_referenceLength - 1))
+                return (long long)index - (long long)getFFTLength();
+            return (long long)index;
+        }
+
+        size_t getReferenceLength() const { return m_referenceLength; }
+        size_t getSegmentLength() const { return m_segmentLength; }
+        size_t getFFTLength() const { return m_plan ? m_plan->getLength() : 0; }
+        /// @brief conj(DFT(reference)), zero-padded to getFFTLength().
+        const vector<T>& getReferenceSpectrum() const { return m_referenceSpectrum; }
+
+    private:
+        size_t m_referenceLength = 0;
+        size_t m_segmentLength = 0;
+        std::shared_ptr<const DFTCToCPlan<T>> m_plan;
+        vector<T> m_referenceSpectrum;
+
+        // Per-task scratch, see parallel::prepareTasks
+        struct Workspace
+        {
+            vector<T> time;           // zero-padded segment, then the correlation
+            vector<T> spectrum;
+            vector<real_type> power;
+            vector<Ipp8u> dftBuf;
+        };
+        std::vector<Workspace> m_tasks;
+
+        void check() const
+        {
+            if (!m_plan)
+                throw std::runtime_error("CrossCorrelator: no reference, construct with one first");
+        }
+
+        void prepare_tasks(size_t numTasks)
+        {
+            const size_t fftLength = m_plan->getLength();
+            parallel::prepareTasks(m_tasks, numTasks, [&](Workspace& w){
+                if (w.time.size() != fftLength)
+                {
+                    w.time.resize(fftLength);
+                    w.time.zero();
+                    w.spectrum.resize(fftLength);
+                    w.power.resize(fftLength);
+                }
+                if (w.dftBuf.size() < m_plan->getBufferSize())
+                    w.dftBuf.resize(m_plan->getBufferSize());
+            });
+        }
+
+        CorrelationPeak<T> correlate_with(Workspace& w, const T* segment, T* out) const
+        {
+            const int fftLength = (int)m_plan->getLength();
+
+            // The padding past the segment is zeroed here, since the backward DFT overwrites it below
+            Copy(segment, w.time.data(), (int)m_segmentLength);
+            if (fftLength > (int)m_segmentLength)
+                w.time.zero((int)m_segmentLength, fftLength - (int)m_segmentLength);
+
+            m_plan->fwd(w.time.data(), w.spectrum.data(), w.dftBuf.data());
+            math::Mul_I(m_referenceSpectrum.data(), w.spectrum.data(), fftLength);
+            T* result = out != nullptr ? out : w.time.data();
+            m_plan->bwd(w.spectrum.data(), result, w.dftBuf.data());
+
+            CorrelationPeak<T> peak;
+            convert::PowerSpectr(result, w.power.data(), fftLength);
+            int index = 0;
+            stats::MaxIndx(w.power.data(), fftLength, &peak.power, &index);
+            peak.index = (size_t)index;
+            peak.lag = lagAt(peak.index);
+            peak.value = result[index];
+            return peak;
+        }
+    };
+}
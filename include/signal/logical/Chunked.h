@@ -0,0 +1,30 @@
+#pragma once
+
+#include "../ipp_ext_chunked.h"
+#include "Xor.h"
+
+/*
+size_t-length overloads of the logical functions, split into int-sized chunks.
+*/
+
+namespace ipps{
+    namespace logical{
+
+        template <typename T, typename L>
+        inline typename detail::enable_if_long<L>::type Xor(const T* src1, const T* src2, T* dst, L length)
+        {
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                Xor(src1 + offset, src2 + offset, dst + offset, len);
+            });
+        }
+
+        template <typename T, typename L>
+        inline typename detail::enable_if_long<L>::type Xor_I(const T* src, T* srcDst, L length)
+        {
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                Xor_I(src + offset, srcDst + offset, len);
+            });
+        }
+
+    }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "../ipp_ext_chunked.h"
+#include "Add.h"
+#include "AddC.h"
+#include "AddProduct.h"
+#include "AddProductC.h"
+#include "Mul.h"
+#include "MulC.h"
+#include "Sub.h"
+#include "SubC.h"
+#include "Div.h"
+#include "Exp.h"
+#include "Ln.h"
+
+/*
+size_t-length overloads of the math functions.
+These are picked for any integral length other than int, and split the call into int-sized chunks,
+so buffers longer than INT_MAX can be processed in one call.
+*/
+
+namespace ipps{
+    namespace math{
+
+        template <typename T, typename U, typename L>
+        inline typename detail::enable_if_long<L>::type Add(const T* x, const T* y, U* result, L length)
+        {
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                Add(x + offset, y + offset, result + offset, len);
+            });
+        }
+
+        template <typename T, typename U, typename L>
+        inline typename detail::enable_if_long<L>::type Sub(const T* x, const T* y, U* result, L length)
+        {
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                Sub(x + offset, y + offset, result + offset, len);
+            });
+        }
+
+        template <typename T, typename U, typename V, typename L>
+        inline typename detail::enable_if_long<L>::type Mul(const T* x, const U* y, V* result, L length)
+        {
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                Mul(x + offset, y + offset, result + offset, len);
+            });
+        }
+
+        template <typename T, typename L>
+        inline typename detail::enable_if_long<L>::type Div(const T* src1, const T* src2, T* dst, L length)
+        {
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                Div(src1 + offset, src2 + offset, dst + offset, len);
+            });
+        }
+
+        template <typename T, typename L>
+        inline typename detail::enable_if_long<L>::type AddC(const T* src, T val, T* dst, L length)
+        {
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                AddC(src + offset, val, dst + offset, len);
+            });
+        }
+
+        template <typename T, typename L>
+        inline typename detail::enable_if_long<L>::type SubC(const T* src, T val, T* dst, L length)
+        {
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                SubC(src + offset, val, dst + offset, len);
+            });
+        }
+
+        template <typename T, typename L>
+        inline typename detail::enable_if_long<L>::type MulC(const T* src, const T val, T* dst, L length)
+        {
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                MulC(src + offset, val, dst + offset, len);
+            });
+        }
+
+        template <typename T, typename L>
+        inline typename detail::enable_if_long<L>::type AddProduct(const T* src1, const T* src2, T* dst, L length)
+        {
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                AddProduct(src1 + offset, src2 + offset, dst + offset, len);
+            });
+        }
+
+        template <typename T, typename L>
+        inline typename detail::enable_if_long<L>::type AddProductC(const T* src, const T val, T* srcDst, L length)
+        {
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                AddProductC(src + offset, val, srcDst + offset, len);
+            });
+        }
+
+        template <typename T, typename L>
+        inline typename detail::enable_if_long<L>::type Exp(const T* src, T* dst, L length)
+        {
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                Exp(src + offset, dst + offset, len);
+            });
+        }
+
+        template <typename T, typename L>
+        inline typename detail::enable_if_long<L>::type Ln(const T* src, T* dst, L length)
+        {
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                Ln(src + offset, dst + offset, len);
+            });
+        }
+
+    }
+}
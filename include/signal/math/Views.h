@@ -0,0 +1,157 @@
+#pragma once
+
+#include "../ipp_ext_view.h"
+#include "Add.h"
+#include "AddC.h"
+#include "AddProduct.h"
+#include "AddProductC.h"
+#include "Mul.h"
+#include "MulC.h"
+#include "Sub.h"
+#include "SubC.h"
+#include "Div.h"
+#include "Exp.h"
+#include "Ln.h"
+
+/*
+vector_view overloads of the math functions.
+All views must be the same size; strided views are processed in tiles (see ipp_ext_view.h).
+For in-place operation simply pass the same view as an input and the output.
+*/
+
+namespace ipps{
+    namespace math{
+
+        /// @brief View overload of Add, result = x + y.
+        template <typename T, typename U, typename V>
+        inline void Add(const vector_view<T>& x, const vector_view<U>& y, const vector_view<V>& result)
+        {
+            typedef typename vector_view<T>::value_type Tn;
+            typedef typename vector_view<U>::value_type Un;
+            detail::checkViewSizes(x.size(), y.size(), "math::Add");
+            detail::checkViewSizes(x.size(), result.size(), "math::Add");
+            detail::binaryTiles(x, y, result, [](const Tn* a, const Un* b, V* c, int len){
+                Add(a, b, c, len);
+            });
+        }
+
+        /// @brief View overload of Sub, result = y - x (same ordering as ippsSub).
+        template <typename T, typename U, typename V>
+        inline void Sub(const vector_view<T>& x, const vector_view<U>& y, const vector_view<V>& result)
+        {
+            typedef typename vector_view<T>::value_type Tn;
+            typedef typename vector_view<U>::value_type Un;
+            detail::checkViewSizes(x.size(), y.size(), "math::Sub");
+            detail::checkViewSizes(x.size(), result.size(), "math::Sub");
+            detail::binaryTiles(x, y, result, [](const Tn* a, const Un* b, V* c, int len){
+                Sub(a, b, c, len);
+            });
+        }
+
+        /// @brief View overload of Mul, result = x * y.
+        template <typename T, typename U, typename V>
+        inline void Mul(const vector_view<T>& x, const vector_view<U>& y, const vector_view<V>& result)
+        {
+            typedef typename vector_view<T>::value_type Tn;
+            typedef typename vector_view<U>::value_type Un;
+            detail::checkViewSizes(x.size(), y.size(), "math::Mul");
+            detail::checkViewSizes(x.size(), result.size(), "math::Mul");
+            detail::binaryTiles(x, y, result, [](const Tn* a, const Un* b, V* c, int len){
+                Mul(a, b, c, len);
+            });
+        }
+
+        /// @brief View overload of Div, dst = src2 / src1 (same ordering as ippsDiv).
+        template <typename T, typename U, typename V>
+        inline void Div(const vector_view<T>& src1, const vector_view<U>& src2, const vector_view<V>& dst)
+        {
+            typedef typename vector_view<T>::value_type Tn;
+            typedef typename vector_view<U>::value_type Un;
+            detail::checkViewSizes(src1.size(), src2.size(), "math::Div");
+            detail::checkViewSizes(src1.size(), dst.size(), "math::Div");
+            detail::binaryTiles(src1, src2, dst, [](const Tn* a, const Un* b, V* c, int len){
+                Div(a, b, c, len);
+            });
+        }
+
+        /// @brief View overload of AddProduct, dst += src1 * src2.
+        template <typename T, typename U, typename V>
+        inline void AddProduct(const vector_view<T>& src1, const vector_view<U>& src2, const vector_view<V>& dst)
+        {
+            typedef typename vector_view<T>::value_type Tn;
+            typedef typename vector_view<U>::value_type Un;
+            detail::checkViewSizes(src1.size(), src2.size(), "math::AddProduct");
+            detail::checkViewSizes(src1.size(), dst.size(), "math::AddProduct");
+            detail::binaryTiles(src1, src2, dst, [](const Tn* a, const Un* b, V* c, int len){
+                AddProduct(a, b, c, len);
+            }, true);
+        }
+
+        /// @brief View overload of AddC, dst = src + val.
+        template <typename T, typename V>
+        inline void AddC(const vector_view<T>& src, const typename vector_view<V>::value_type val, const vector_view<V>& dst)
+        {
+            typedef typename vector_view<T>::value_type Tn;
+            detail::checkViewSizes(src.size(), dst.size(), "math::AddC");
+            detail::unaryTiles(src, dst, [val](const Tn* a, V* c, int len){
+                AddC(a, val, c, len);
+            });
+        }
+
+        /// @brief View overload of SubC, dst = src - val.
+        template <typename T, typename V>
+        inline void SubC(const vector_view<T>& src, const typename vector_view<V>::value_type val, const vector_view<V>& dst)
+        {
+            typedef typename vector_view<T>::value_type Tn;
+            detail::checkViewSizes(src.size(), dst.size(), "math::SubC");
+            detail::unaryTiles(src, dst, [val](const Tn* a, V* c, int len){
+                SubC(a, val, c, len);
+            });
+        }
+
+        /// @brief View overload of MulC, dst = src * val.
+        template <typename T, typename V>
+        inline void MulC(const vector_view<T>& src, const typename vector_view<V>::value_type val, const vector_view<V>& dst)
+        {
+            typedef typename vector_view<T>::value_type Tn;
+            detail::checkViewSizes(src.size(), dst.size(), "math::MulC");
+            detail::unaryTiles(src, dst, [val](const Tn* a, V* c, int len){
+                MulC(a, val, c, len);
+            });
+        }
+
+        /// @brief View overload of AddProductC, srcDst += src * val.
+        template <typename T, typename V>
+        inline void AddProductC(const vector_view<T>& src, const typename vector_view<V>::value_type val, const vector_view<V>& srcDst)
+        {
+            typedef typename vector_view<T>::value_type Tn;
+            detail::checkViewSizes(src.size(), srcDst.size(), "math::AddProductC");
+            detail::unaryTiles(src, srcDst, [val](const Tn* a, V* c, int len){
+                AddProductC(a, val, c, len);
+            }, true);
+        }
+
+        /// @brief View overload of Exp.
+        template <typename T, typename V>
+        inline void Exp(const vector_view<T>& src, const vector_view<V>& dst)
+        {
+            typedef typename vector_view<T>::value_type Tn;
+            detail::checkViewSizes(src.size(), dst.size(), "math::Exp");
+            detail::unaryTiles(src, dst, [](const Tn* a, V* c, int len){
+                Exp(a, c, len);
+            });
+        }
+
+        /// @brief View overload of Ln.
+        template <typename T, typename V>
+        inline void Ln(const vector_view<T>& src, const vector_view<V>& dst)
+        {
+            typedef typename vector_view<T>::value_type Tn;
+            detail::checkViewSizes(src.size(), dst.size(), "math::Ln");
+            detail::unaryTiles(src, dst, [](const Tn* a, V* c, int len){
+                Ln(a, c, len);
+            });
+        }
+
+    }
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cmath>
+#include "../ipp_ext_chunked.h"
+#include "Norm.h"
+#include "Sum.h"
+#include "Max.h"
+#include "MaxIndx.h"
+#include "Min.h"
+#include "MinIndx.h"
+#include "DotProd.h"
+
+/*
+size_t-length overloads of the stats functions.
+These are picked for any integral length other than int; the input is reduced in int-sized chunks
+and the partial results are then combined.
+*/
+
+namespace ipps{
+    namespace stats{
+
+        template <typename T, typename L>
+        inline typename detail::enable_if_long<L>::type Sum(const T* src, L length, T* sum, IppHintAlgorithm hint=IppHintAlgorithm::ippAlgHintNone)
+        {
+            T total = detail::zeroValue<T>();
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                T part;
+                Sum(src + offset, len, &part, hint);
+                detail::accumulate(total, part);
+            });
+            *sum = total;
+        }
+
+        template <typename T, typename L>
+        inline typename detail::enable_if_long<L>::type Max(const T* src, L length, T* max)
+        {
+            if (length == 0)
+                throw std::invalid_argument("stats::Max: length cannot be 0");
+            bool first = true;
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                T part;
+                Max(src + offset, len, &part);
+                if (first || part > *max)
+                    *max = part;
+                first = false;
+            });
+        }
+
+        template <typename T, typename L>
+        inline typename detail::enable_if_long<L>::type Min(const T* src, L length, T* min)
+        {
+            if (length == 0)
+                throw std::invalid_argument("stats::Min: length cannot be 0");
+            bool first = true;
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                T part;
+                Min(src + offset, len, &part);
+                if (first || part < *min)
+                    *min = part;
+                first = false;
+            });
+        }
+
+        /// @brief size_t version of MaxIndx; the index is also a size_t, and is the first occurrence of the maximum.
+        template <typename T, typename L>
+        inline typename detail::enable_if_long<L>::type MaxIndx(const T* src, L length, T* max, size_t* indx)
+        {
+            if (length == 0)
+                throw std::invalid_argument("stats::MaxIndx: length cannot be 0");
+            bool first = true;
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                T part;
+                int partIndx;
+                MaxIndx(src + offset, len, &part, &partIndx);
+                if (first || part > *max)
+                {
+                    *max = part;
+                    *indx = offset + (size_t)partIndx;
+                }
+                first = false;
+            });
+        }
+
+        /// @brief size_t version of MinIndx; the index is also a size_t, and is the first occurrence of the minimum.
+        template <typename T, typename L>
+        inline typename detail::enable_if_long<L>::type MinIndx(const T* src, L length, T* min, size_t* indx)
+        {
+            if (length == 0)
+                throw std::invalid_argument("stats::MinIndx: length cannot be 0");
+            bool first = true;
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                T part;
+                int partIndx;
+                MinIndx(src + offset, len, &part, &partIndx);
+                if (first || part < *min)
+                {
+                    *min = part;
+                    *indx = offset + (size_t)partIndx;
+                }
+                first = false;
+            });
+        }
+
+        template <typename T, typename U, typename V, typename L>
+        inline typename detail::enable_if_long<L>::type DotProd(const T* src1, const U* src2, L length, V* result)
+        {
+            V total = detail::zeroValue<V>();
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                V part;
+                DotProd(src1 + offset, src2 + offset, len, &part);
+                detail::accumulate(total, part);
+            });
+            *result = total;
+        }
+
+        /// @brief size_t version of Norm_L2; the partial norms are combined as sqrt(sum of squares).
+        template <typename T, typename U, typename L>
+        inline typename detail::enable_if_long<L>::type Norm_L2(const T* src, L length, U* norm)
+        {
+            double sumsq = 0;
+            detail::forEachChunk(length, [&](size_t offset, int len){
+                U part;
+                Norm_L2(src + offset, len, &part);
+                sumsq += (double)part * (double)part;
+            });
+            *norm = (U)std::sqrt(sumsq);
+        }
+
+    }
+}
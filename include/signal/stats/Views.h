@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cmath>
+#include "../ipp_ext_view.h"
+#include "Norm.h"
+#include "Sum.h"
+#include "Max.h"
+#include "MaxIndx.h"
+#include "Min.h"
+#include "MinIndx.h"
+#include "DotProd.h"
+
+/*
+vector_view overloads of the stats functions.
+Contiguous views go straight to IPP; strided views are reduced tile by tile
+(see ipp_ext_view.h) and the partial results are then combined.
+*/
+
+namespace ipps{
+    namespace stats{
+
+        /// @brief View overload of Sum.
+        template <typename T, typename U>
+        inline void Sum(const vector_view<T>& src, U* sum, IppHintAlgorithm hint=IppHintAlgorithm::ippAlgHintNone)
+        {
+            typedef typename vector_view<T>::value_type Tn;
+            U total = detail::zeroValue<U>();
+            detail::reduceTiles(src, [&](const Tn* a, int len, size_t /*offset*/){
+                U part;
+                Sum(a, len, &part, hint);
+                detail::accumulate(total, part);
+            });
+            *sum = total;
+        }
+
+        /// @brief View overload of Max.
+        template <typename T, typename U>
+        inline void Max(const vector_view<T>& src, U* max)
+        {
+            typedef typename vector_view<T>::value_type Tn;
+            if (src.empty())
+                throw std::invalid_argument("stats::Max: view is empty");
+            bool first = true;
+            detail::reduceTiles(src, [&](const Tn* a, int len, size_t /*offset*/){
+                U part;
+                Max(a, len, &part);
+                if (first || part > *max)
+                    *max = part;
+                first = false;
+            });
+        }
+
+        /// @brief View overload of Min.
+        template <typename T, typename U>
+        inline void Min(const vector_view<T>& src, U* min)
+        {
+            typedef typename vector_view<T>::value_type Tn;
+            if (src.empty())
+                throw std::invalid_argument("stats::Min: view is empty");
+            bool first = true;
+            detail::reduceTiles(src, [&](const Tn* a, int len, size_t /*offset*/){
+                U part;
+                Min(a, len, &part);
+                if (first || part < *min)
+                    *min = part;
+                first = false;
+            });
+        }
+
+        /// @brief View overload of MaxIndx. The index is relative to the start of the view,
+        /// and is the first occurrence of the maximum, like ippsMaxIndx.
+        template <typename T, typename U>
+        inline void MaxIndx(const vector_view<T>& src, U* max, size_t* indx)
+        {
+            typedef typename vector_view<T>::value_type Tn;
+            if (src.empty())
+                throw std::invalid_argument("stats::MaxIndx: view is empty");
+            bool first = true;
+            detail::reduceTiles(src, [&](const Tn* a, int len, size_t offset){
+                U part;
+                int partIndx;
+                MaxIndx(a, len, &part, &partIndx);
+                if (first || part > *max)
+                {
+                    *max = part;
+                    *indx = offset + (size_t)partIndx;
+                }
+                first = false;
+            });
+        }
+
+        /// @brief View overload of MinIndx. The index is relative to the start of the view,
+        /// and is the first occurrence of the minimum, like ippsMinIndx.
+        template <typename T, typename U>
+        inline void MinIndx(const vector_view<T>& src, U* min, size_t* indx)
+        {
+            typedef typename vector_view<T>::value_type Tn;
+            if (src.empty())
+                throw std::invalid_argument("stats::MinIndx: view is empty");
+            bool first = true;
+            detail::reduceTiles(src, [&](const Tn* a, int len, size_t offset){
+                U part;
+                int partIndx;
+                MinIndx(a, len, &part, &partIndx);
+                if (first || part < *min)
+                {
+                    *min = part;
+                    *indx = offset + (size_t)partIndx;
+                }
+                first = false;
+            });
+        }
+
+        /// @brief View overload of DotProd.
+        template <typename T, typename U, typename V>
+        inline void DotProd(const vector_view<T>& src1, const vector_view<U>& src2, V* result)
+        {
+            typedef typename vector_view<T>::value_type Tn;
+            typedef typename vector_view<U>::value_type Un;
+            detail::checkViewSizes(src1.size(), src2.size(), "stats::DotProd");
+            V total = detail::zeroValue<V>();
+            detail::reduceTiles(src1, src2, [&](const Tn* a, const Un* b, int len, size_t /*offset*/){
+                V part;
+                DotProd(a, b, len, &part);
+                detail::accumulate(total, part);
+            });
+            *result = total;
+        }
+
+        /// @brief View overload of Norm_L2. Partial norms are combined as sqrt(sum of squares).
+        template <typename T, typename U>
+        inline void Norm_L2(const vector_view<T>& src, U* norm)
+        {
+            typedef typename vector_view<T>::value_type Tn;
+            double sumsq = 0;
+            detail::reduceTiles(src, [&](const Tn* a, int len, size_t /*offset*/){
+                U part;
+                Norm_L2(a, len, &part);
+                sumsq += (double)part * (double)part;
+            });
+            *norm = (U)std::sqrt(sumsq);
+        }
+
+    }
+}
@@ -0,0 +1,206 @@
+#pragma once
+
+#include "ipp.h"
+#include "../../ipp_ext_errors.h"
+#include <stdexcept>
+#include <string>
+
+namespace ipps{
+    namespace transform{
+
+        template <typename T>
+        void WinBartlett_I(T* srcDst, int len);
+
+        /// @brief Blackman window with the standard alpha of 0.16.
+        template <typename T>
+        void WinBlackmanStd_I(T* srcDst, int len);
+
+        template <typename T>
+        void WinHamming_I(T* srcDst, int len);
+
+        template <typename T>
+        void WinHann_I(T* srcDst, int len);
+
+        /// @brief Multiplies srcDst in-place by the window of the given type, spanning len samples.
+        /// ippWinBlackman uses WinBlackmanStd_I; ippWinRect leaves the data untouched.
+        template <typename T>
+        inline void Win_I(IppWinType winType, T* srcDst, int len)
+        {
+            switch (winType)
+            {
+                case ippWinBartlett:
+                    WinBartlett_I(srcDst, len);
+                    break;
+                case ippWinBlackman:
+                    WinBlackmanStd_I(srcDst, len);
+                    break;
+                case ippWinHamming:
+                    WinHamming_I(srcDst, len);
+                    break;
+                case ippWinHann:
+                    WinHann_I(srcDst, len);
+                    break;
+                case ippWinRect:
+                    break;
+                default:
+                    throw std::invalid_argument("Win_I: unknown window type " + std::to_string((int)winType));
+            }
+        }
+
+        // ============================
+        // ============================ 
+        //  WinBartlett_I Specializations
+        // ============================
+        // ============================
+
+        template <typename T>
+        inline void WinBartlett_I(T* srcDst, int len){
+            throw std::runtime_error("ippsWinBartlett_I not implemented for generic types");
+        }
+
+        // 32f
+        template <>
+        inline void WinBartlett_I(Ipp32f* srcDst, int len){
+            IppStatus sts = ippsWinBartlett_32f_I(srcDst, len);
+            IPP_NO_ERROR(sts, "ippsWinBartlett_32f_I");
+        }
+
+        // 64f
+        template <>
+        inline void WinBartlett_I(Ipp64f* srcDst, int len){
+            IppStatus sts = ippsWinBartlett_64f_I(srcDst, len);
+            IPP_NO_ERROR(sts, "ippsWinBartlett_64f_I");
+        }
+
+        // 32fc
+        template <>
+        inline void WinBartlett_I(Ipp32fc* srcDst, int len){
+            IppStatus sts = ippsWinBartlett_32fc_I(srcDst, len);
+            IPP_NO_ERROR(sts, "ippsWinBartlett_32fc_I");
+        }
+
+        // 64fc
+        template <>
+        inline void WinBartlett_I(Ipp64fc* srcDst, int len){
+            IppStatus sts = ippsWinBartlett_64fc_I(srcDst, len);
+            IPP_NO_ERROR(sts, "ippsWinBartlett_64fc_I");
+        }
+
+        // ============================
+        // ============================ 
+        //  WinBlackmanStd_I Specializations
+        // ============================
+        // ============================
+
+        template <typename T>
+        inline void WinBlackmanStd_I(T* srcDst, int len){
+            throw std::runtime_error("ippsWinBlackmanStd_I not implemented for generic types");
+        }
+
+        // 32f
+        template <>
+        inline void WinBlackmanStd_I(Ipp32f* srcDst, int len){
+            IppStatus sts = ippsWinBlackmanStd_32f_I(srcDst, len);
+            IPP_NO_ERROR(sts, "ippsWinBlackmanStd_32f_I");
+        }
+
+        // 64f
+        template <>
+        inline void WinBlackmanStd_I(Ipp64f* srcDst, int len){
+            IppStatus sts = ippsWinBlackmanStd_64f_I(srcDst, len);
+            IPP_NO_ERROR(sts, "ippsWinBlackmanStd_64f_I");
+        }
+
+        // 32fc
+        template <>
+        inline void WinBlackmanStd_I(Ipp32fc* srcDst, int len){
+            IppStatus sts = ippsWinBlackmanStd_32fc_I(srcDst, len);
+            IPP_NO_ERROR(sts, "ippsWinBlackmanStd_32fc_I");
+        }
+
+        // 64fc
+        template <>
+        inline void WinBlackmanStd_I(Ipp64fc* srcDst, int len){
+            IppStatus sts = ippsWinBlackmanStd_64fc_I(srcDst, len);
+            IPP_NO_ERROR(sts, "ippsWinBlackmanStd_64fc_I");
+        }
+
+        // ============================
+        // ============================ 
+        //  WinHamming_I Specializations
+        // ============================
+        // ============================
+
+        template <typename T>
+        inline void WinHamming_I(T* srcDst, int len){
+            throw std::runtime_error("ippsWinHamming_I not implemented for generic types");
+        }
+
+        // 32f
+        template <>
+        inline void WinHamming_I(Ipp32f* srcDst, int len){
+            IppStatus sts = ippsWinHamming_32f_I(srcDst, len);
+            IPP_NO_ERROR(sts, "ippsWinHamming_32f_I");
+        }
+
+        // 64f
+        template <>
+        inline void WinHamming_I(Ipp64f* srcDst, int len){
+            IppStatus sts = ippsWinHamming_64f_I(srcDst, len);
+            IPP_NO_ERROR(sts, "ippsWinHamming_64f_I");
+        }
+
+        // 32fc
+        template <>
+        inline void WinHamming_I(Ipp32fc* srcDst, int len){
+            IppStatus sts = ippsWinHamming_32fc_I(srcDst, len);
+            IPP_NO_ERROR(sts, "ippsWinHamming_32fc_I");
+        }
+
+        // 64fc
+        template <>
+        inline void WinHamming_I(Ipp64fc* srcDst, int len){
+            IppStatus sts = ippsWinHamming_64fc_I(srcDst, len);
+            IPP_NO_ERROR(sts, "ippsWinHamming_64fc_I");
+        }
+
+        // ============================
+        // ============================ 
+        //  WinHann_I Specializations
+        // ============================
+        // ============================
+
+        template <typename T>
+        inline void WinHann_I(T* srcDst, int len){
+            throw std::runtime_error("ippsWinHann_I not implemented for generic types");
+        }
+
+        // 32f
+        template <>
+        inline void WinHann_I(Ipp32f* srcDst, int len){
+            IppStatus sts = ippsWinHann_32f_I(srcDst, len);
+            IPP_NO_ERROR(sts, "ippsWinHann_32f_I");
+        }
+
+        // 64f
+        template <>
+        inline void WinHann_I(Ipp64f* srcDst, int len){
+            IppStatus sts = ippsWinHann_64f_I(srcDst, len);
+            IPP_NO_ERROR(sts, "ippsWinHann_64f_I");
+        }
+
+        // 32fc
+        template <>
+        inline void WinHann_I(Ipp32fc* srcDst, int len){
+            IppStatus sts = ippsWinHann_32fc_I(srcDst, len);
+            IPP_NO_ERROR(sts, "ippsWinHann_32fc_I");
+        }
+
+        // 64fc
+        template <>
+        inline void WinHann_I(Ipp64fc* srcDst, int len){
+            IppStatus sts = ippsWinHann_64fc_I(srcDst, len);
+            IPP_NO_ERROR(sts, "ippsWinHann_64fc_I");
+        }
+    }
+}
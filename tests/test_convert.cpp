@@ -503,3 +503,33 @@ TEST_CASE("ipps convert PowerSpectr", "[convert], [PowerSpectr]"){
         test_PowerSpectr_complex<Ipp64fc, Ipp64f>();
     }
 }
+
+template <typename T, typename U>
+void test_Magnitude()
+{
+    ipps::vector<T> x(10);
+    ipps::vector<U> y(10);
+
+    using realType = decltype(std::declval<T>().re);
+    for (int i = 0; i < 10; ++i)
+    {
+        x[i].re = (realType)i;
+        x[i].im = (realType)(i + 1);
+    }
+
+    ipps::convert::Magnitude(x.data(), y.data(), (int)x.size());
+
+    for (int i = 0; i < 10; ++i)
+    {
+        REQUIRE(std::abs(y[i] - std::sqrt((U)(x[i].re * x[i].re + x[i].im * x[i].im))) < 1e-5);
+    }
+}
+
+TEST_CASE("ipps convert Magnitude", "[convert], [Magnitude]"){
+    SECTION("Ipp32fc to Ipp32f"){
+        test_Magnitude<Ipp32fc, Ipp32f>();
+    }
+    SECTION("Ipp64fc to Ipp64f"){
+        test_Magnitude<Ipp64fc, Ipp64f>();
+    }
+}
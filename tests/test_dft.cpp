@@ -1,4 +1,9 @@
 #include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
 #include "ipp_ext.h"
 
 #include <catch2/catch_test_macros.hpp>
@@ -222,3 +227,1242 @@ TEST_CASE("ipps dft execution", "[dft],[execution]")
             
 
 }
+
+// test executors sharing a single plan, including concurrently
+TEST_CASE("ipps dft shared plan", "[dft],[plan]")
+{
+    const size_t length = 1000;
+    const int numThreads = 4;
+    double tolerance = 1e-4;
+
+    auto plan = std::make_shared<const ipps::DFTCToCPlan<Ipp32fc>>(length);
+
+    SECTION("executors share the spec"){
+        ipps::DFTCToC<Ipp32fc> a(plan), b(plan);
+        REQUIRE(a.getPlan() == plan);
+        REQUIRE(a.getLength() == length);
+        REQUIRE(a.getDFTSpec().data() == b.getDFTSpec().data());
+        REQUIRE(a.getDFTBuf().data() != b.getDFTBuf().data());
+        REQUIRE(a.getDFTBuf().size() == plan->getBufferSize());
+
+        // Copies are still independent
+        ipps::DFTCToC<Ipp32fc> c(a);
+        REQUIRE(c.getDFTSpec().data() != a.getDFTSpec().data());
+    }
+
+    SECTION("null plan throws"){
+        REQUIRE_THROWS_AS(ipps::DFTCToC<Ipp32fc>(std::shared_ptr<const ipps::DFTCToCPlan<Ipp32fc>>()), std::invalid_argument);
+    }
+
+    SECTION("concurrent execution matches serial"){
+        std::vector<ipps::vector<Ipp32fc>> in(numThreads), out(numThreads), ref(numThreads);
+        for (int t = 0; t < numThreads; t++)
+        {
+            in[t].resize(length);
+            out[t].resize(length);
+            ref[t].resize(length);
+            for (size_t i = 0; i < length; i++)
+            {
+                in[t][i].re = (Ipp32f)(i * (t + 1));
+                in[t][i].im = (Ipp32f)t;
+            }
+        }
+
+        // Serial reference using an independent object
+        ipps::DFTCToC<Ipp32fc> serial(length);
+        for (int t = 0; t < numThreads; t++)
+            serial.fwd(in[t].data(), ref[t].data());
+
+        std::vector<ipps::DFTCToC<Ipp32fc>> dfts;
+        for (int t = 0; t < numThreads; t++)
+            dfts.emplace_back(plan);
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; t++)
+        {
+            threads.emplace_back([&, t](){
+                for (int rep = 0; rep < 10; rep++)
+                    dfts[t].fwd(in[t].data(), out[t].data());
+            });
+        }
+        for (std::thread& th : threads)
+            th.join();
+
+        for (int t = 0; t < numThreads; t++)
+        {
+            for (size_t i = 0; i < length; i++)
+            {
+                REQUIRE(abs(out[t][i].re - ref[t][i].re) < tolerance * length);
+                REQUIRE(abs(out[t][i].im - ref[t][i].im) < tolerance * length);
+            }
+        }
+    }
+}
+
+// test batched execution against the per-row loop
+TEST_CASE("ipps dft batch", "[dft],[batch]")
+{
+    const size_t length = 64;
+    const size_t rows = 37; // not a multiple of the thread count
+    double tolerance = 1e-3;
+    ipps::parallel::ThreadPool pool(4);
+
+    ipps::DFTCToC<Ipp32fc> dft(length);
+
+    ipps::matrix<Ipp32fc> in(rows, length);
+    for (size_t r = 0; r < rows; r++)
+    {
+        for (size_t i = 0; i < length; i++)
+        {
+            in.index(r, i).re = (Ipp32f)(r + i);
+            in.index(r, i).im = (Ipp32f)r - (Ipp32f)i;
+        }
+    }
+
+    // Reference
+    ipps::matrix<Ipp32fc> ref(rows, length);
+    for (size_t r = 0; r < rows; r++)
+        dft.fwd(in.row(r), ref.row(r));
+
+    auto requireMatch = [&](ipps::matrix<Ipp32fc>& out){
+        for (size_t r = 0; r < rows; r++)
+        {
+            for (size_t i = 0; i < length; i++)
+            {
+                REQUIRE(abs(out.index(r, i).re - ref.index(r, i).re) < tolerance);
+                REQUIRE(abs(out.index(r, i).im - ref.index(r, i).im) < tolerance);
+            }
+        }
+    };
+
+    SECTION("matrix"){
+        ipps::matrix<Ipp32fc> out(rows, length);
+        dft.fwdBatch(in, out, pool);
+        requireMatch(out);
+
+        // and back again
+        ipps::matrix<Ipp32fc> back(rows, length);
+        dft.bwdBatch(out, back, pool);
+        for (size_t k = 0; k < in.size(); k++)
+        {
+            REQUIRE(abs(back[k].re - in[k].re) < tolerance);
+            REQUIRE(abs(back[k].im - in[k].im) < tolerance);
+        }
+    }
+
+    SECTION("in-place"){
+        ipps::matrix<Ipp32fc> out(in);
+        dft.fwdBatch(out, out, pool);
+        requireMatch(out);
+    }
+
+    SECTION("strided rows"){
+        const size_t stride = length + 5;
+        ipps::vector<Ipp32fc> padded(rows * stride);
+        for (size_t r = 0; r < rows; r++)
+            for (size_t i = 0; i < length; i++)
+                padded[r * stride + i] = in.index(r, i);
+
+        ipps::matrix<Ipp32fc> out(rows, length);
+        dft.fwdBatch(padded.data(), stride, out.data(), length, rows, nullptr, nullptr, pool);
+        requireMatch(out);
+    }
+
+    SECTION("split complex"){
+        ipps::DFTCToC<Ipp32f> sdft(length);
+        ipps::vector<Ipp32f> re(rows * length), im(rows * length), outRe(rows * length), outIm(rows * length);
+        for (size_t k = 0; k < in.size(); k++)
+        {
+            re[k] = in[k].re;
+            im[k] = in[k].im;
+        }
+        sdft.fwdBatch(re.data(), length, outRe.data(), length, rows, im.data(), outIm.data(), pool);
+        for (size_t r = 0; r < rows; r++)
+        {
+            for (size_t i = 0; i < length; i++)
+            {
+                REQUIRE(abs(outRe[r * length + i] - ref.index(r, i).re) < tolerance);
+                REQUIRE(abs(outIm[r * length + i] - ref.index(r, i).im) < tolerance);
+            }
+        }
+    }
+
+    SECTION("mismatched sizes throw"){
+        ipps::matrix<Ipp32fc> wrongCols(rows, length + 1);
+        ipps::matrix<Ipp32fc> wrongRows(rows + 1, length);
+        ipps::matrix<Ipp32fc> out(rows, length);
+        REQUIRE_THROWS_AS(dft.fwdBatch(wrongCols, wrongCols, pool), std::invalid_argument);
+        REQUIRE_THROWS_AS(dft.fwdBatch(in, wrongRows, pool), std::invalid_argument);
+        REQUIRE_THROWS_AS(dft.fwdBatch(in.data(), length - 1, out.data(), length, rows, nullptr, nullptr, pool), std::invalid_argument);
+    }
+}
+
+// test the real-input DFT formats against the complex DFT of the promoted input
+template <typename T, ipps::RealDFTFormat F>
+void test_real_dft(size_t length)
+{
+    typedef typename ipps::DFTRToC<T, F>::complex_type C;
+    double tolerance = 1e-3;
+
+    ipps::vector<T> x(length);
+    ipps::vector<C> xc(length), ref(length);
+    for (size_t i = 0; i < length; i++)
+    {
+        x[i] = (T)(i % 7) - (T)(i % 3) * (T)0.5;
+        xc[i].re = x[i];
+        xc[i].im = 0;
+    }
+    ipps::DFTCToC<C> cdft(length);
+    cdft.fwd(xc.data(), ref.data());
+
+    ipps::DFTRToC<T, F> dft(length);
+    ipps::vector<T> spectrum(dft.getSpectrumLength());
+    dft.fwd(x.data(), spectrum.data());
+
+    // Expand, both from the spectrum and directly
+    ipps::vector<C> full(length), full2(length);
+    dft.toComplex(spectrum.data(), full.data());
+    dft.fwdComplex(x.data(), full2.data());
+    for (size_t k = 0; k < length; k++)
+    {
+        REQUIRE(abs(full[k].re - ref[k].re) < tolerance);
+        REQUIRE(abs(full[k].im - ref[k].im) < tolerance);
+        REQUIRE(abs(full2[k].re - ref[k].re) < tolerance);
+        REQUIRE(abs(full2[k].im - ref[k].im) < tolerance);
+    }
+
+    // Round trip
+    ipps::vector<T> back(length);
+    dft.bwd(spectrum.data(), back.data());
+    for (size_t i = 0; i < length; i++)
+        REQUIRE(abs(back[i] - x[i]) < tolerance);
+}
+
+TEST_CASE("ipps real dft", "[dft],[real]")
+{
+    SECTION("CCS"){
+        test_real_dft<Ipp32f, ipps::RealDFTFormat::CCS>(100);
+        test_real_dft<Ipp32f, ipps::RealDFTFormat::CCS>(101);
+        test_real_dft<Ipp64f, ipps::RealDFTFormat::CCS>(100);
+        test_real_dft<Ipp64f, ipps::RealDFTFormat::CCS>(101);
+    }
+
+    SECTION("Pack"){
+        test_real_dft<Ipp32f, ipps::RealDFTFormat::Pack>(100);
+        test_real_dft<Ipp32f, ipps::RealDFTFormat::Pack>(101);
+        test_real_dft<Ipp64f, ipps::RealDFTFormat::Pack>(100);
+        test_real_dft<Ipp64f, ipps::RealDFTFormat::Pack>(101);
+    }
+
+    SECTION("Perm"){
+        test_real_dft<Ipp32f, ipps::RealDFTFormat::Perm>(100);
+        test_real_dft<Ipp32f, ipps::RealDFTFormat::Perm>(101);
+        test_real_dft<Ipp64f, ipps::RealDFTFormat::Perm>(100);
+        test_real_dft<Ipp64f, ipps::RealDFTFormat::Perm>(101);
+    }
+
+    SECTION("spectrum lengths"){
+        REQUIRE(ipps::DFTRToCCS<Ipp32f>(100).getSpectrumLength() == 102);
+        REQUIRE(ipps::DFTRToCCS<Ipp32f>(101).getSpectrumLength() == 102);
+        REQUIRE(ipps::DFTRToPack<Ipp32f>(101).getSpectrumLength() == 101);
+        REQUIRE(ipps::DFTRToPerm<Ipp64f>(100).getSpectrumLength() == 100);
+    }
+
+    SECTION("shared plan"){
+        auto plan = ipps::DFTRToCPlan<Ipp32f>::cached(64);
+        ipps::DFTRToCCS<Ipp32f> a(plan);
+        ipps::DFTRToPerm<Ipp32f> b(plan);
+        REQUIRE(a.getPlan() == b.getPlan());
+        REQUIRE_THROWS_AS(ipps::DFTRToCCS<Ipp32f>(0), std::invalid_argument);
+    }
+}
+
+// test the FFT backend against the generic DFT
+template <typename T>
+void test_fft_backend_split(size_t length)
+{
+    double tolerance = 1e-3;
+    ipps::DFTCToC<T> fft(length);
+    ipps::DFTCToC<T> dft(length, IPP_FFT_DIV_INV_BY_N, ipps::DFTBackend::DFT);
+    REQUIRE(fft.isFFT());
+    REQUIRE(!dft.isFFT());
+
+    ipps::vector<T> re(length), im(length), fRe(length), fIm(length), dRe(length), dIm(length);
+    for (size_t i = 0; i < length; i++)
+    {
+        re[i] = (T)(i % 5);
+        im[i] = (T)(i % 3);
+    }
+    fft.fwd(re.data(), fRe.data(), im.data(), fIm.data());
+    dft.fwd(re.data(), dRe.data(), im.data(), dIm.data());
+    for (size_t i = 0; i < length; i++)
+    {
+        REQUIRE(abs(fRe[i] - dRe[i]) < tolerance);
+        REQUIRE(abs(fIm[i] - dIm[i]) < tolerance);
+    }
+
+    fft.bwd(fRe.data(), dRe.data(), fIm.data(), dIm.data());
+    for (size_t i = 0; i < length; i++)
+    {
+        REQUIRE(abs(dRe[i] - re[i]) < tolerance);
+        REQUIRE(abs(dIm[i] - im[i]) < tolerance);
+    }
+}
+
+template <typename T>
+void test_fft_backend_complex(size_t length)
+{
+    double tolerance = 1e-3;
+    ipps::DFTCToC<T> fft(length);
+    ipps::DFTCToC<T> dft(length, IPP_FFT_DIV_INV_BY_N, ipps::DFTBackend::DFT);
+    REQUIRE(fft.isFFT());
+    REQUIRE(!dft.isFFT());
+
+    ipps::vector<T> in(length), fOut(length), dOut(length);
+    for (size_t i = 0; i < length; i++)
+    {
+        in[i].re = (decltype(in[i].re))(i % 5);
+        in[i].im = (decltype(in[i].im))(i % 3);
+    }
+    fft.fwd(in.data(), fOut.data());
+    dft.fwd(in.data(), dOut.data());
+    for (size_t i = 0; i < length; i++)
+    {
+        REQUIRE(abs(fOut[i].re - dOut[i].re) < tolerance);
+        REQUIRE(abs(fOut[i].im - dOut[i].im) < tolerance);
+    }
+
+    fft.bwd(fOut.data(), dOut.data());
+    for (size_t i = 0; i < length; i++)
+    {
+        REQUIRE(abs(dOut[i].re - in[i].re) < tolerance);
+        REQUIRE(abs(dOut[i].im - in[i].im) < tolerance);
+    }
+}
+
+TEST_CASE("ipps dft fft backend", "[dft],[fft]")
+{
+    SECTION("Ipp32f"){
+        test_fft_backend_split<Ipp32f>(256);
+    }
+    SECTION("Ipp64f"){
+        test_fft_backend_split<Ipp64f>(256);
+    }
+    SECTION("Ipp32fc"){
+        test_fft_backend_complex<Ipp32fc>(1024);
+    }
+    SECTION("Ipp64fc"){
+        test_fft_backend_complex<Ipp64fc>(1024);
+    }
+
+    SECTION("selection"){
+        REQUIRE(!ipps::DFTCToC<Ipp32fc>(1000).isFFT());
+        REQUIRE(ipps::DFTCToC<Ipp32fc>(4096).isFFT());
+
+        ipps::DFTCToC<Ipp32fc> byOrder = ipps::DFTCToC<Ipp32fc>::fromOrder(10);
+        REQUIRE(byOrder.isFFT());
+        REQUIRE(byOrder.getLength() == 1024);
+        REQUIRE(byOrder.getPlan()->getOrder() == 10);
+
+        REQUIRE_THROWS_AS(ipps::DFTCToC<Ipp32fc>(1000, IPP_FFT_DIV_INV_BY_N, ipps::DFTBackend::FFT), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::DFTCToC<Ipp32fc>::fromOrder(-1), std::invalid_argument);
+    }
+
+    SECTION("copies outlive the original"){
+        const size_t length = 512;
+        ipps::vector<Ipp32fc> in(length), out(length), ref(length);
+        for (size_t i = 0; i < length; i++)
+        {
+            in[i].re = (Ipp32f)i;
+            in[i].im = 0;
+        }
+
+        ipps::DFTCToC<Ipp32fc>* original = new ipps::DFTCToC<Ipp32fc>(length);
+        original->fwd(in.data(), ref.data());
+        ipps::DFTCToC<Ipp32fc> copy(*original);
+        delete original;
+
+        REQUIRE(copy.isFFT());
+        copy.fwd(in.data(), out.data());
+        for (size_t i = 0; i < length; i++)
+        {
+            REQUIRE(out[i].re == ref[i].re);
+            REQUIRE(out[i].im == ref[i].im);
+        }
+    }
+}
+
+// Reference power spectrum of frame f of x, windowed and zero-padded to fftLength
+template <typename T>
+static std::vector<double> stft_reference(const ipps::vector<T>& x, const ipps::vector<T>& window,
+                                          size_t start, size_t fftLength)
+{
+    std::vector<double> power(fftLength);
+    for (size_t k = 0; k < fftLength; k++)
+    {
+        double re = 0, im = 0;
+        for (size_t n = 0; n < window.size(); n++)
+        {
+            double a = -IPP_2PI * (double)(k * n) / (double)fftLength;
+            double sre = x[start + n].re * window[n].re;
+            double sim = x[start + n].im * window[n].re;
+            re += sre * std::cos(a) - sim * std::sin(a);
+            im += sre * std::sin(a) + sim * std::cos(a);
+        }
+        power[k] = re * re + im * im;
+    }
+    return power;
+}
+
+template <typename T>
+static void test_stft(size_t frameLength, size_t hop, size_t fftLength, double tol)
+{
+    typedef typename ipps::STFT<T>::real_type R;
+    ipps::vector<T> x(1000);
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        x[i].re = (R)std::cos(0.3 * i);
+        x[i].im = (R)std::sin(0.07 * i * i / 100.0);
+    }
+
+    ipps::parallel::ThreadPool pool(3);
+    ipps::STFT<T> stft(frameLength, hop, ippWinHamming, ipps::STFTScale::Power, fftLength);
+    REQUIRE(stft.getFFTLength() == (fftLength == 0 ? frameLength : fftLength));
+    const size_t numFrames = (x.size() - frameLength) / hop + 1;
+    ipps::matrix<R> out(numFrames, stft.getFFTLength());
+
+    // Irregular chunks, so frames straddle calls
+    const size_t chunks[] = {7, 1, 130, 3, 64};
+    size_t offset = 0, c = 0, written = 0;
+    while (offset < x.size())
+    {
+        size_t count = std::min(chunks[c++ % 5], x.size() - offset);
+        written += stft.process(x.data() + offset, count, out, pool);
+        offset += count;
+    }
+    REQUIRE(written == numFrames);
+    REQUIRE(stft.getFrameCount() == numFrames);
+
+    for (size_t f = 0; f < numFrames; f++)
+    {
+        std::vector<double> expected = stft_reference(x, stft.getWindow(), f * hop, stft.getFFTLength());
+        for (size_t k = 0; k < expected.size(); k++)
+            REQUIRE(std::abs(out.index(f, k) - expected[k]) < tol * (1.0 + expected[k]));
+    }
+}
+
+TEST_CASE("ipps stft", "[dft],[stft]")
+{
+    SECTION("Ipp32fc, overlapping frames"){
+        test_stft<Ipp32fc>(64, 16, 0, 1e-3);
+    }
+    SECTION("Ipp64fc, overlapping frames"){
+        test_stft<Ipp64fc>(64, 16, 0, 1e-9);
+    }
+    SECTION("Ipp64fc, zero-padded, non power of 2"){
+        test_stft<Ipp64fc>(50, 20, 72, 1e-9);
+    }
+    SECTION("Ipp64fc, hop longer than the frame"){
+        test_stft<Ipp64fc>(32, 45, 0, 1e-9);
+    }
+    SECTION("ring of rows, scales and image output"){
+        ipps::vector<Ipp32fc> x(2000);
+        for (size_t i = 0; i < x.size(); i++)
+        {
+            x[i].re = (Ipp32f)std::cos(0.2 * i);
+            x[i].im = (Ipp32f)std::sin(0.2 * i);
+        }
+
+        // All frames into one big matrix, then the same frames into a 4-row ring
+        ipps::STFT<Ipp32fc> all(128, 64, ippWinHann, ipps::STFTScale::Magnitude);
+        ipps::STFT<Ipp32fc> ring(128, 64, ippWinHann, ipps::STFTScale::Magnitude);
+        size_t numFrames = (x.size() - 128) / 64 + 1;
+        ipps::matrix<Ipp32f> full(numFrames, 128), rows(4, 128);
+        REQUIRE(all.process(x.data(), x.size(), full) == numFrames);
+        REQUIRE(ring.process(x.data(), x.size(), rows) == numFrames);
+        REQUIRE(ring.getNextRow(4) == numFrames % 4);
+        for (size_t f = numFrames - 4; f < numFrames; f++)
+            for (size_t k = 0; k < 128; k++)
+                REQUIRE(rows.index(f % 4, k) == full.index(f, k));
+
+        // dB of the power is 20 log10 of the magnitude
+        ipps::STFT<Ipp32fc> db(128, 64, ippWinHann, ipps::STFTScale::PowerDB);
+        ippi::image<Ipp32f, ippi::channels::C1> img(128, numFrames);
+        REQUIRE(db.process(x.data(), x.size(), img) == numFrames);
+        for (size_t f = 0; f < numFrames; f++)
+            for (size_t k = 0; k < 128; k++)
+                if (full.index(f, k) > 1e-2)
+                    REQUIRE(std::abs(img.at(f, k) - 20.0 * std::log10(full.index(f, k))) < 1e-2);
+    }
+    SECTION("ring smaller than the frames of one call, on several threads"){
+        ipps::vector<Ipp32fc> x(3000);
+        for (size_t i = 0; i < x.size(); i++)
+        {
+            x[i].re = (Ipp32f)std::cos(0.013 * i * i);
+            x[i].im = (Ipp32f)std::sin(0.3 * i);
+        }
+
+        // Serial reference with a row per frame
+        ipps::parallel::ThreadPool single(1), pool(4);
+        ipps::STFT<Ipp32fc> all(64, 32, ippWinHann, ipps::STFTScale::Power);
+        ipps::STFT<Ipp32fc> ring(64, 32, ippWinHann, ipps::STFTScale::Power);
+        const size_t numFrames = (x.size() - 64) / 32 + 1;
+        ipps::matrix<Ipp32f> full(numFrames, 64), rows(3, 64);
+        REQUIRE(all.process(x.data(), x.size(), full, single) == numFrames);
+
+        // Two calls, each with many more frames than rows
+        size_t split = 1700;
+        size_t firstCall = ring.process(x.data(), split, rows, pool);
+        REQUIRE(ring.getFrameCount() == firstCall);
+        for (size_t f = firstCall - 3; f < firstCall; f++)
+            for (size_t k = 0; k < 64; k++)
+                REQUIRE(rows.index(f % 3, k) == full.index(f, k));
+
+        REQUIRE(ring.process(x.data() + split, x.size() - split, rows, pool) == numFrames - firstCall);
+        REQUIRE(ring.getFrameCount() == numFrames);
+        for (size_t f = numFrames - 3; f < numFrames; f++)
+            for (size_t k = 0; k < 64; k++)
+                REQUIRE(rows.index(f % 3, k) == full.index(f, k));
+    }
+    SECTION("invalid arguments"){
+        REQUIRE_THROWS_AS(ipps::STFT<Ipp32fc>(0, 1), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::STFT<Ipp32fc>(64, 0), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::STFT<Ipp32fc>(64, 16, ippWinHann, ipps::STFTScale::Power, 32), std::invalid_argument);
+
+        ipps::STFT<Ipp32fc> stft(64, 16);
+        ipps::vector<Ipp32fc> x(64);
+        ipps::matrix<Ipp32f> wrong(2, 32);
+        REQUIRE_THROWS_AS(stft.process(x.data(), x.size(), wrong), std::invalid_argument);
+    }
+}
+
+template <typename T>
+static void test_welch(ipps::WelchAverage average, size_t segmentLength, size_t overlap, double tol)
+{
+    typedef typename ipps::Welch<T>::real_type R;
+    ipps::vector<T> x(777);
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        // A tone plus a deterministic but irregular background
+        x[i].re = (R)(std::cos(0.9 * i) + 0.3 * std::sin(0.011 * i * i));
+        x[i].im = (R)(std::sin(0.9 * i) + 0.2 * std::cos(0.017 * i * i));
+    }
+
+    ipps::parallel::ThreadPool pool(3);
+    ipps::Welch<T> welch(segmentLength, overlap, ippWinHann, average);
+    const size_t chunks[] = {5, 100, 1, 33};
+    size_t offset = 0, c = 0;
+    while (offset < x.size())
+    {
+        size_t count = std::min(chunks[c++ % 4], x.size() - offset);
+        welch.push(x.data() + offset, count, pool);
+        offset += count;
+    }
+    const size_t hop = segmentLength - overlap;
+    const size_t numSegments = (x.size() - segmentLength) / hop + 1;
+    REQUIRE(welch.getSegmentCount() == numSegments);
+
+    const double sampleRate = 2.0;
+    ipps::vector<R> psd(segmentLength);
+    welch.getPSD(psd.data(), sampleRate, pool);
+
+    // Reference from the individual periodograms
+    ipps::STFT<T> stft(segmentLength, hop, ippWinHann);
+    double windowPower = 0;
+    for (size_t i = 0; i < segmentLength; i++)
+        windowPower += stft.getWindow()[i].re * stft.getWindow()[i].re;
+    std::vector<std::vector<double>> periodograms;
+    for (size_t s = 0; s < numSegments; s++)
+        periodograms.push_back(stft_reference(x, stft.getWindow(), s * hop, segmentLength));
+
+    for (size_t k = 0; k < segmentLength; k++)
+    {
+        std::vector<double> column;
+        for (size_t s = 0; s < numSegments; s++)
+            column.push_back(periodograms[s][k]);
+        double expected;
+        if (average == ipps::WelchAverage::Mean)
+        {
+            expected = 0;
+            for (double v : column)
+                expected += v;
+            expected /= numSegments;
+        }
+        else
+        {
+            std::sort(column.begin(), column.end());
+            expected = numSegments % 2 == 1 ? column[numSegments / 2]
+                : (column[numSegments / 2 - 1] + column[numSegments / 2]) / 2;
+            double bias = 1.0;
+            for (size_t i = 1; 2 * i + 1 <= numSegments; i++)
+                bias += 1.0 / (2 * i + 1) - 1.0 / (2 * i);
+            expected /= bias;
+        }
+        expected /= sampleRate * windowPower;
+        REQUIRE(std::abs(psd[k] - expected) < tol * (1.0 + expected));
+    }
+}
+
+TEST_CASE("ipps welch", "[dft],[welch]")
+{
+    SECTION("Ipp32fc, mean"){
+        test_welch<Ipp32fc>(ipps::WelchAverage::Mean, 64, 32, 1e-3);
+    }
+    SECTION("Ipp64fc, mean"){
+        test_welch<Ipp64fc>(ipps::WelchAverage::Mean, 64, 32, 1e-9);
+    }
+    SECTION("Ipp64fc, median, odd segment count"){
+        test_welch<Ipp64fc>(ipps::WelchAverage::Median, 48, 12, 1e-9);
+    }
+    SECTION("Ipp64fc, median, even segment count"){
+        test_welch<Ipp64fc>(ipps::WelchAverage::Median, 64, 32, 1e-9);
+    }
+    SECTION("rectangular window preserves the mean power"){
+        ipps::vector<Ipp64fc> x(1024);
+        double power = 0;
+        for (size_t i = 0; i < x.size(); i++)
+        {
+            x[i].re = std::cos(0.5 * i) + (double)(i % 3);
+            x[i].im = std::sin(0.25 * i);
+            power += x[i].re * x[i].re + x[i].im * x[i].im;
+        }
+        power /= x.size();
+
+        // Non-overlapping segments cover every sample exactly once
+        ipps::Welch<Ipp64fc> welch(128, 0, ippWinRect);
+        welch.push(x.data(), x.size());
+        ipps::vector<Ipp64f> psd(128);
+        welch.getPSD(psd.data(), 10.0);
+        double total = 0;
+        for (size_t k = 0; k < psd.size(); k++)
+            total += psd[k];
+        REQUIRE(std::abs(total * 10.0 / 128 - power) < 1e-9);
+
+        // Resetting discards everything
+        welch.reset();
+        REQUIRE(welch.getSegmentCount() == 0);
+        REQUIRE_THROWS_AS(welch.getPSD(psd.data()), std::runtime_error);
+    }
+    SECTION("invalid arguments"){
+        REQUIRE_THROWS_AS(ipps::Welch<Ipp32fc>(64, 64), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::Welch<Ipp32fc>(64, 16, ippWinHann, ipps::WelchAverage::Mean, 32), std::invalid_argument);
+    }
+}
+
+template <typename T>
+static void test_four_step(size_t length, size_t rows, int flag, double tol)
+{
+    typedef decltype(T().re) R;
+    ipps::vector<T> x(length), expected(length), result(length);
+    for (size_t i = 0; i < length; i++)
+    {
+        x[i].re = (R)std::cos(0.013 * i * i);
+        x[i].im = (R)((double)(i % 17) / 17.0 - 0.5);
+    }
+
+    ipps::parallel::ThreadPool pool(4);
+    ipps::DFTCToC<T> reference(length, flag);
+    ipps::DFTFourStep<T> dft(length, flag, rows);
+    REQUIRE(dft.getRows() * dft.getColumns() == length);
+
+    reference.fwd(x.data(), expected.data());
+    dft.fwd(x.data(), result.data(), pool);
+    for (size_t i = 0; i < length; i++)
+    {
+        REQUIRE(std::abs(result[i].re - expected[i].re) < tol);
+        REQUIRE(std::abs(result[i].im - expected[i].im) < tol);
+    }
+
+    // In-place backward returns to the input
+    dft.bwd(result.data(), result.data(), pool);
+    reference.bwd(expected.data(), expected.data());
+    for (size_t i = 0; i < length; i++)
+    {
+        REQUIRE(std::abs(result[i].re - expected[i].re) < tol);
+        REQUIRE(std::abs(result[i].im - expected[i].im) < tol);
+    }
+}
+
+TEST_CASE("ipps dft four-step", "[dft],[fourstep]")
+{
+    SECTION("Ipp64fc, square split"){
+        test_four_step<Ipp64fc>(4096, 0, IPP_FFT_DIV_INV_BY_N, 1e-8);
+    }
+    SECTION("Ipp64fc, uneven split"){
+        test_four_step<Ipp64fc>(1000, 0, IPP_FFT_DIV_INV_BY_N, 1e-8);
+    }
+    SECTION("Ipp64fc, given rows, other flags"){
+        test_four_step<Ipp64fc>(2016, 7, IPP_FFT_DIV_BY_SQRTN, 1e-9);
+        test_four_step<Ipp64fc>(2016, 96, IPP_FFT_DIV_FWD_BY_N, 1e-9);
+    }
+    SECTION("Ipp32fc"){
+        test_four_step<Ipp32fc>(3000, 0, IPP_FFT_DIV_INV_BY_N, 5e-2);
+    }
+    SECTION("Ipp64fc, prime length falls back"){
+        test_four_step<Ipp64fc>(997, 0, IPP_FFT_DIV_INV_BY_N, 1e-8);
+        REQUIRE(ipps::DFTFourStep<Ipp64fc>(997).getRows() == 1);
+    }
+    SECTION("split choice and invalid arguments"){
+        REQUIRE(ipps::DFTFourStep<Ipp32fc>::chooseRows(1 << 20) == 1024);
+        REQUIRE(ipps::DFTFourStep<Ipp32fc>::chooseRows(100000000) == 10000);
+        REQUIRE_THROWS_AS(ipps::DFTFourStep<Ipp32fc>(0), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::DFTFourStep<Ipp32fc>(100, IPP_FFT_DIV_INV_BY_N, 7), std::invalid_argument);
+    }
+}
+
+template <typename T>
+static void test_xcorr(double tol)
+{
+    typedef decltype(T().re) R;
+    const size_t refLength = 100, segLength = 500;
+    ipps::vector<T> reference(refLength);
+    for (size_t i = 0; i < refLength; i++)
+    {
+        reference[i].re = (R)std::cos(0.02 * i * i);
+        reference[i].im = (R)std::sin(0.02 * i * i);
+    }
+
+    // Segments hold the reference (partly, for negative lags) at known delays, over a weak background
+    const long long delays[] = {123, 0, 400, -30, 7};
+    const size_t count = 5;
+    ipps::vector<T> segments(count * segLength);
+    for (size_t s = 0; s < count; s++)
+    {
+        for (size_t i = 0; i < segLength; i++)
+        {
+            T& v = segments[s * segLength + i];
+            v.re = (R)(0.05 * std::cos(1.3 * i + s));
+            v.im = 0;
+            long long n = (long long)i - delays[s];
+            if (n >= 0 && n < (long long)refLength)
+            {
+                v.re += reference[n].re;
+                v.im += reference[n].im;
+            }
+        }
+    }
+
+    ipps::CrossCorrelator<T> xc(reference, segLength);
+    REQUIRE(xc.getFFTLength() == 1024);
+
+    // Single segment, with the full output checked against the definition
+    ipps::vector<T> full(xc.getFFTLength());
+    ipps::CorrelationPeak<T> peak = xc.correlate(segments.data(), full.data());
+    REQUIRE(peak.lag == 123);
+    for (long long k = -(long long)refLength + 1; k < (long long)segLength; k += 37)
+    {
+        double re = 0, im = 0;
+        for (size_t n = 0; n < refLength; n++)
+        {
+            long long i = (long long)n + k;
+            if (i < 0 || i >= (long long)segLength)
+                continue;
+            const T& s = segments[i];
+            re += s.re * reference[n].re + s.im * reference[n].im;
+            im += s.im * reference[n].re - s.re * reference[n].im;
+        }
+        size_t index = k < 0 ? (size_t)(k + (long long)xc.getFFTLength()) : (size_t)k;
+        REQUIRE(xc.lagAt(index) == k);
+        REQUIRE(std::abs(full[index].re - re) < tol);
+        REQUIRE(std::abs(full[index].im - im) < tol);
+    }
+
+    // Batch over a pool gives every delay, matching the single calls
+    ipps::parallel::ThreadPool pool(3);
+    std::vector<ipps::CorrelationPeak<T>> peaks(count);
+    xc.correlateBatch(segments.data(), segLength, count, peaks.data(), nullptr, 0, pool);
+    for (size_t s = 0; s < count; s++)
+    {
+        REQUIRE(peaks[s].lag == delays[s]);
+        ipps::CorrelationPeak<T> single = xc.correlate(segments.data() + s * segLength);
+        REQUIRE(single.index == peaks[s].index);
+        REQUIRE(std::abs(single.power - peaks[s].power) < tol * (1.0 + single.power));
+    }
+}
+
+TEST_CASE("ipps cross correlator", "[dft],[xcorr]")
+{
+    SECTION("Ipp32fc"){
+        test_xcorr<Ipp32fc>(1e-2);
+    }
+    SECTION("Ipp64fc"){
+        test_xcorr<Ipp64fc>(1e-9);
+    }
+    SECTION("invalid arguments"){
+        ipps::vector<Ipp32fc> reference(64);
+        REQUIRE_THROWS_AS(ipps::CrossCorrelator<Ipp32fc>(ipps::vector<Ipp32fc>(), 10), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::CrossCorrelator<Ipp32fc>(reference, 0), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::CrossCorrelator<Ipp32fc>(reference, 100, 128), std::invalid_argument);
+
+        ipps::CrossCorrelator<Ipp32fc> empty;
+        Ipp32fc sample{};
+        REQUIRE_THROWS_AS(empty.correlate(&sample), std::runtime_error);
+    }
+}
+
+template <typename T>
+static void test_caf(double tol)
+{
+    typedef decltype(T().re) R;
+    const size_t refLength = 64, segLength = 300, fftLength = 512;
+    ipps::vector<T> reference(refLength);
+    for (size_t i = 0; i < refLength; i++)
+    {
+        reference[i].re = (R)std::cos(0.05 * i * i);
+        reference[i].im = (R)std::sin(0.05 * i * i);
+    }
+
+    // Whole bins are rotations, the half bin needs a tone; the segment holds the reference at the half bin
+    const double shift = 10.5 / fftLength;
+    const long long delay = 77;
+    std::vector<double> dopplers = {-3.0 / fftLength, 0.0, 10.0 / fftLength, shift, 11.0 / fftLength};
+    ipps::vector<T> segment(segLength);
+    for (size_t i = 0; i < segLength; i++)
+    {
+        double re = 0.05 * std::cos(0.7 * i), im = 0;
+        long long n = (long long)i - delay;
+        if (n >= 0 && n < (long long)refLength)
+        {
+            double c = std::cos(2 * IPP_PI * shift * i), s = std::sin(2 * IPP_PI * shift * i);
+            re += reference[n].re * c - reference[n].im * s;
+            im += reference[n].re * s + reference[n].im * c;
+        }
+        segment[i].re = (R)re;
+        segment[i].im = (R)im;
+    }
+
+    ipps::CAF<T> caf(reference, segLength, dopplers, fftLength);
+    REQUIRE(caf.getNumLags() == refLength + segLength - 1);
+    REQUIRE(caf.getNumDopplers() == dopplers.size());
+    REQUIRE(caf.isRotation(0));
+    REQUIRE(caf.isRotation(1));
+    REQUIRE(caf.isRotation(2));
+    REQUIRE(!caf.isRotation(3));
+    REQUIRE(caf.isRotation(4));
+
+    // Every row checked against the definition, at a spread of lags
+    ipps::parallel::ThreadPool pool(2);
+    ipps::matrix<R> surface(dopplers.size(), caf.getNumLags());
+    caf.compute(segment.data(), surface.data(), surface.columns(), pool);
+    for (size_t d = 0; d < dopplers.size(); d++)
+    {
+        for (size_t c = 0; c < caf.getNumLags(); c += 29)
+        {
+            long long k = caf.lagAt(c);
+            double re = 0, im = 0;
+            for (size_t n = 0; n < refLength; n++)
+            {
+                long long i = (long long)n + k;
+                if (i < 0 || i >= (long long)segLength)
+                    continue;
+                double c0 = std::cos(2 * IPP_PI * dopplers[d] * i), s0 = -std::sin(2 * IPP_PI * dopplers[d] * i);
+                double sre = segment[i].re * c0 - segment[i].im * s0;
+                double sim = segment[i].re * s0 + segment[i].im * c0;
+                re += sre * reference[n].re + sim * reference[n].im;
+                im += sim * reference[n].re - sre * reference[n].im;
+            }
+            REQUIRE(std::abs(surface.row(d)[c] - std::sqrt(re * re + im * im)) < tol);
+        }
+    }
+
+    // Peaks per row, on one thread, match the surface; the strongest is at the true delay and Doppler
+    ipps::parallel::ThreadPool single(1);
+    std::vector<ipps::CorrelationPeak<T>> peaks(dopplers.size());
+    caf.computePeaks(segment.data(), peaks.data(), single);
+    size_t best = 0;
+    for (size_t d = 0; d < dopplers.size(); d++)
+    {
+        const R* row = surface.row(d);
+        REQUIRE(peaks[d].index == (size_t)(std::max_element(row, row + caf.getNumLags()) - row));
+        REQUIRE(peaks[d].lag == caf.lagAt(peaks[d].index));
+        REQUIRE(std::abs(std::sqrt(peaks[d].power) - row[peaks[d].index]) < tol);
+        if (peaks[d].power > peaks[best].power)
+            best = d;
+    }
+    REQUIRE(best == 3);
+    REQUIRE(peaks[best].lag == delay);
+    REQUIRE(std::abs(std::sqrt(peaks[best].power) - (double)refLength) < 1.0);
+}
+
+TEST_CASE("ipps caf", "[dft],[caf]")
+{
+    SECTION("Ipp32fc"){
+        test_caf<Ipp32fc>(1e-2);
+    }
+    SECTION("Ipp64fc"){
+        test_caf<Ipp64fc>(1e-9);
+    }
+    SECTION("image output and scales"){
+        ipps::vector<Ipp32fc> reference(16);
+        for (size_t i = 0; i < reference.size(); i++)
+        {
+            reference[i].re = (Ipp32f)std::cos(0.3 * i * i);
+            reference[i].im = (Ipp32f)std::sin(0.3 * i * i);
+        }
+        ipps::vector<Ipp32fc> segment(50);
+        for (size_t i = 0; i < segment.size(); i++)
+        {
+            segment[i].re = (Ipp32f)std::cos(0.11 * i);
+            segment[i].im = (Ipp32f)std::sin(0.07 * i);
+        }
+        std::vector<double> dopplers = {0.0, 1.0 / 64, 0.1};
+
+        ipps::CAF<Ipp32fc> magnitude(reference, segment.size(), dopplers);
+        REQUIRE(magnitude.getFFTLength() == 128);
+        ipps::matrix<Ipp32f> expected(dopplers.size(), magnitude.getNumLags());
+        magnitude.compute(segment.data(), expected.data(), expected.columns());
+
+        ipps::CAF<Ipp32fc> power(reference, segment.size(), dopplers, 0, ipps::STFTScale::Power);
+        ipps::CAF<Ipp32fc> db(reference, segment.size(), dopplers, 0, ipps::STFTScale::PowerDB);
+        ippi::image<Ipp32f, ippi::channels::C1> surface(power.getNumLags(), dopplers.size());
+        ippi::image<Ipp32f, ippi::channels::C1> surfaceDB(db.getNumLags(), dopplers.size());
+        power.compute(segment.data(), surface);
+        db.compute(segment.data(), surfaceDB);
+        for (size_t d = 0; d < dopplers.size(); d++)
+        {
+            for (size_t c = 0; c < power.getNumLags(); c++)
+            {
+                Ipp32f mag = expected.row(d)[c];
+                Ipp32f p = surface.data()[d * surface.stepBytes() / sizeof(Ipp32f) + c];
+                Ipp32f pdb = surfaceDB.data()[d * surfaceDB.stepBytes() / sizeof(Ipp32f) + c];
+                REQUIRE(std::abs(p - mag * mag) < 1e-3 * (1 + p));
+                if (p > 1e-3)
+                    REQUIRE(std::abs(pdb - 10 * std::log10(p)) < 1e-2);
+            }
+        }
+
+        ippi::image<Ipp32f, ippi::channels::C1> wrong(power.getNumLags() + 1, dopplers.size());
+        REQUIRE_THROWS_AS(power.compute(segment.data(), wrong), std::invalid_argument);
+    }
+    SECTION("invalid arguments"){
+        ipps::vector<Ipp32fc> reference(64);
+        std::vector<double> dopplers = {0.0};
+        REQUIRE_THROWS_AS(ipps::CAF<Ipp32fc>(reference, 100, std::vector<double>()), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::CAF<Ipp32fc>(reference, 100, dopplers, 128), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::CAF<Ipp32fc>(ipps::vector<Ipp32fc>(), 100, dopplers), std::invalid_argument);
+
+        ipps::CAF<Ipp32fc> two(reference, 100, {0.0, 0.25});
+        ipps::vector<Ipp32f> out(2 * two.getNumLags());
+        REQUIRE_THROWS_AS(two.compute(reference.data(), out.data(), two.getNumLags() - 1), std::invalid_argument);
+
+        ipps::CAF<Ipp32fc> empty;
+        Ipp32fc sample{};
+        REQUIRE_THROWS_AS(empty.computePeaks(&sample, nullptr), std::runtime_error);
+    }
+}
+
+template <typename T>
+static void test_chirpz(double tol)
+{
+    typedef decltype(T().re) R;
+    const size_t length = 300;
+    ipps::vector<T> x(length);
+    for (size_t i = 0; i < length; i++)
+    {
+        x[i].re = (R)(std::cos(0.31 * i) + 0.5 * std::sin(0.017 * i * i));
+        x[i].im = (R)(std::sin(0.23 * i) - 0.2 * std::cos(1.1 * i));
+    }
+
+    // With f0 = 0 and df = 1/N, it is the ordinary DFT
+    ipps::ChirpZ<T> full(length, length, 0.0, 1.0 / length);
+    REQUIRE(full.getFFTLength() == 1024);
+    ipps::vector<T> expected(length), out(length);
+    ipps::DFTCToC<T> dft(length);
+    dft.fwd(x.data(), expected.data());
+    full.transform(x.data(), out.data());
+    for (size_t k = 0; k < length; k++)
+    {
+        REQUIRE(std::abs(out[k].re - expected[k].re) < tol * length);
+        REQUIRE(std::abs(out[k].im - expected[k].im) < tol * length);
+    }
+
+    // A narrow, descending span between DFT bins, checked against the definition
+    const size_t bins = 77;
+    const double f0 = 0.052, df = -0.0013 / bins;
+    ipps::ChirpZ<T> zoom(length, bins, f0, df, 512);
+    REQUIRE(zoom.getFFTLength() == 512);
+    ipps::vector<T> zoomed(bins);
+    zoom.transform(x.data(), zoomed.data());
+    for (size_t k = 0; k < bins; k++)
+    {
+        double f = zoom.frequencyAt(k);
+        REQUIRE(std::abs(f - (f0 + k * df)) < 1e-15);
+        double re = 0, im = 0;
+        for (size_t n = 0; n < length; n++)
+        {
+            double c = std::cos(2 * IPP_PI * f * n), s = -std::sin(2 * IPP_PI * f * n);
+            re += x[n].re * c - x[n].im * s;
+            im += x[n].re * s + x[n].im * c;
+        }
+        REQUIRE(std::abs(zoomed[k].re - re) < tol * length);
+        REQUIRE(std::abs(zoomed[k].im - im) < tol * length);
+    }
+
+    // Batches over a pool match single calls
+    const size_t count = 5;
+    ipps::vector<T> inputs(count * length), outputs(count * bins);
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        inputs[i].re = (R)std::cos(0.07 * i);
+        inputs[i].im = (R)std::sin(0.13 * i * (i % 7));
+    }
+    ipps::parallel::ThreadPool pool(3);
+    zoom.transformBatch(inputs.data(), length, outputs.data(), bins, count, pool);
+    for (size_t s = 0; s < count; s++)
+    {
+        zoom.transform(inputs.data() + s * length, zoomed.data());
+        for (size_t k = 0; k < bins; k++)
+        {
+            REQUIRE(outputs[s * bins + k].re == zoomed[k].re);
+            REQUIRE(outputs[s * bins + k].im == zoomed[k].im);
+        }
+    }
+}
+
+TEST_CASE("ipps chirp-z", "[dft],[chirpz]")
+{
+    SECTION("Ipp32fc"){
+        test_chirpz<Ipp32fc>(1e-4);
+    }
+    SECTION("Ipp64fc"){
+        test_chirpz<Ipp64fc>(1e-11);
+    }
+    SECTION("invalid arguments"){
+        REQUIRE_THROWS_AS(ipps::ChirpZ<Ipp32fc>(0, 10, 0.0, 0.01), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::ChirpZ<Ipp32fc>(10, 0, 0.0, 0.01), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::ChirpZ<Ipp32fc>(100, 100, 0.0, 0.01, 128), std::invalid_argument);
+
+        ipps::ChirpZ<Ipp32fc> czt(100, 20, 0.0, 0.01);
+        ipps::vector<Ipp32fc> in(200), out(40);
+        REQUIRE_THROWS_AS(czt.transformBatch(in.data(), 99, out.data(), 20, 2), std::invalid_argument);
+        REQUIRE_THROWS_AS(czt.transformBatch(in.data(), 100, out.data(), 19, 2), std::invalid_argument);
+
+        ipps::ChirpZ<Ipp32fc> empty;
+        Ipp32fc sample{};
+        REQUIRE_THROWS_AS(empty.transform(&sample, &sample), std::runtime_error);
+    }
+}
+
+template <typename T>
+static void test_goertzel_bank(double tol)
+{
+    typedef decltype(T().re) R;
+    // Longer than one block, so the state carries across blocks
+    const size_t length = 5000;
+    const size_t count = 4;
+    ipps::vector<T> channels(count * length);
+    for (size_t i = 0; i < channels.size(); i++)
+    {
+        channels[i].re = (R)(std::cos(0.0731 * i) + 0.3 * std::sin(0.9 * i));
+        channels[i].im = (R)(std::sin(0.0417 * i * (1 + i % 3)));
+    }
+
+    // Arbitrary frequencies, including negative and above 0.5, in a count that is not a whole group
+    std::vector<double> frequencies = {0.0731 / (2 * IPP_PI), -0.0123, 0.25, 0.5, 0.777, 0.0002, 0.31415};
+    ipps::GoertzelBank<T> bank(frequencies, length);
+    REQUIRE(bank.getMethod() == ipps::GoertzelMethod::Goertzel);
+    REQUIRE(bank.getNumBins() == frequencies.size());
+
+    ipps::vector<T> bins(count * frequencies.size());
+    ipps::parallel::ThreadPool pool(3);
+    bank.computeBatch(channels.data(), length, count, bins.data(), frequencies.size(), pool);
+    for (size_t c = 0; c < count; c++)
+    {
+        const T* x = channels.data() + c * length;
+        for (size_t k = 0; k < frequencies.size(); k++)
+        {
+            double re = 0, im = 0;
+            for (size_t n = 0; n < length; n++)
+            {
+                double cs = std::cos(2 * IPP_PI * frequencies[k] * n), sn = -std::sin(2 * IPP_PI * frequencies[k] * n);
+                re += x[n].re * cs - x[n].im * sn;
+                im += x[n].re * sn + x[n].im * cs;
+            }
+            REQUIRE(std::abs(bins[c * frequencies.size() + k].re - re) < tol * length);
+            REQUIRE(std::abs(bins[c * frequencies.size() + k].im - im) < tol * length);
+        }
+
+        ipps::vector<T> single(frequencies.size());
+        bank.compute(x, single.data());
+        for (size_t k = 0; k < frequencies.size(); k++)
+        {
+            REQUIRE(single[k].re == bins[c * frequencies.size() + k].re);
+            REQUIRE(single[k].im == bins[c * frequencies.size() + k].im);
+        }
+    }
+
+    // On-bin frequencies give the same bins either way, and Auto takes the DFT for many of them
+    std::vector<double> onBins;
+    for (int b = -20; b < 20; b += 3)
+        onBins.push_back((double)b / length);
+    ipps::GoertzelBank<T> goertzel(onBins, length, ipps::GoertzelMethod::Goertzel);
+    ipps::GoertzelBank<T> dft(onBins, length, ipps::GoertzelMethod::DFT);
+    ipps::GoertzelBank<T> automatic(onBins, length);
+    REQUIRE(automatic.getMethod() == ipps::GoertzelMethod::DFT);
+    ipps::vector<T> a(onBins.size()), b(onBins.size());
+    goertzel.compute(channels.data(), a.data());
+    dft.compute(channels.data(), b.data());
+    for (size_t k = 0; k < onBins.size(); k++)
+    {
+        REQUIRE(std::abs(a[k].re - b[k].re) < tol * length);
+        REQUIRE(std::abs(a[k].im - b[k].im) < tol * length);
+    }
+}
+
+TEST_CASE("ipps goertzel bank", "[dft],[goertzel]")
+{
+    SECTION("Ipp32fc"){
+        test_goertzel_bank<Ipp32fc>(1e-4);
+    }
+    SECTION("Ipp64fc"){
+        test_goertzel_bank<Ipp64fc>(1e-11);
+    }
+    SECTION("method selection"){
+        REQUIRE(!ipps::GoertzelBank<Ipp32fc>::preferDFT(1, 4096));
+        REQUIRE(ipps::GoertzelBank<Ipp32fc>::preferDFT(200, 4096));
+
+        std::vector<double> few = {1.0 / 64, 3.0 / 64};
+        REQUIRE(ipps::GoertzelBank<Ipp32fc>(few, 4096).getMethod() == ipps::GoertzelMethod::Goertzel);
+        std::vector<double> offBin(50, 0.001);
+        REQUIRE(ipps::GoertzelBank<Ipp32fc>(offBin, 4096).getMethod() == ipps::GoertzelMethod::Goertzel);
+    }
+    SECTION("invalid arguments"){
+        std::vector<double> frequencies = {0.1, 0.2};
+        REQUIRE_THROWS_AS(ipps::GoertzelBank<Ipp32fc>(std::vector<double>(), 100), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::GoertzelBank<Ipp32fc>(frequencies, 0), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::GoertzelBank<Ipp32fc>(frequencies, 99, ipps::GoertzelMethod::DFT), std::invalid_argument);
+
+        ipps::GoertzelBank<Ipp32fc> bank(frequencies, 100);
+        ipps::vector<Ipp32fc> in(200), out(4);
+        REQUIRE_THROWS_AS(bank.computeBatch(in.data(), 99, 2, out.data(), 2), std::invalid_argument);
+        REQUIRE_THROWS_AS(bank.computeBatch(in.data(), 100, 2, out.data(), 1), std::invalid_argument);
+
+        ipps::GoertzelBank<Ipp32fc> empty;
+        Ipp32fc sample{};
+        REQUIRE_THROWS_AS(empty.compute(&sample, &sample), std::runtime_error);
+    }
+}
+
+// Bin k of the length-N DFT of the window ending at sample end - 1, oldest first, zero-padded before the start
+template <typename T>
+static void sliding_dft_reference(const T* x, size_t end, size_t length, int bin, double& re, double& im)
+{
+    re = 0;
+    im = 0;
+    for (size_t m = 0; m < length; m++)
+    {
+        long long i = (long long)end - (long long)length + (long long)m;
+        if (i < 0)
+            continue;
+        double phase = -2 * IPP_PI * bin * (double)m / length;
+        re += x[i].re * std::cos(phase) - x[i].im * std::sin(phase);
+        im += x[i].re * std::sin(phase) + x[i].im * std::cos(phase);
+    }
+}
+
+template <typename T>
+static void test_sliding_dft(double tol)
+{
+    typedef decltype(T().re) R;
+    const size_t length = 64, hop = 5, total = 700;
+    ipps::vector<T> x(total);
+    for (size_t i = 0; i < total; i++)
+    {
+        x[i].re = (R)(std::cos(0.29 * i) + 0.1 * (double)(i % 11));
+        x[i].im = (R)std::sin(0.013 * i * i);
+    }
+    std::vector<int> bins = {0, 3, 17, -5, 63, 32};
+
+    // Pushed in uneven chunks, with a resync partway through a hop, against the definition at every output
+    ipps::SlidingDFT<T> sdft(length, bins, hop, 97);
+    REQUIRE(sdft.outputsFor(total) == total / hop);
+    ipps::vector<T> out((total / hop) * bins.size());
+    const size_t chunks[] = {1, 2, 60, 3, 200, 64, 370};
+    size_t pushed = 0, rows = 0;
+    for (size_t chunk : chunks)
+    {
+        size_t expected = sdft.outputsFor(chunk);
+        size_t written = sdft.process(x.data() + pushed, chunk, out.data() + rows * bins.size(), bins.size());
+        REQUIRE(written == expected);
+        pushed += chunk;
+        rows += written;
+    }
+    REQUIRE(pushed == total);
+    REQUIRE(rows == total / hop);
+    REQUIRE(sdft.getSampleCount() == total);
+
+    for (size_t r = 0; r < rows; r++)
+    {
+        for (size_t k = 0; k < bins.size(); k++)
+        {
+            double re, im;
+            sliding_dft_reference(x.data(), (r + 1) * hop, length, bins[k], re, im);
+            REQUIRE(std::abs(out[r * bins.size() + k].re - re) < tol);
+            REQUIRE(std::abs(out[r * bins.size() + k].im - im) < tol);
+        }
+    }
+
+    // An explicit resync changes nothing but the rounding, and reset() starts from zeros again
+    ipps::vector<T> before(bins.size()), after(bins.size());
+    sdft.getBins(before.data());
+    sdft.resync();
+    sdft.getBins(after.data());
+    for (size_t k = 0; k < bins.size(); k++)
+    {
+        REQUIRE(std::abs(before[k].re - after[k].re) < tol);
+        REQUIRE(std::abs(before[k].im - after[k].im) < tol);
+    }
+    sdft.reset();
+    REQUIRE(sdft.getSampleCount() == 0);
+    sdft.process(x.data(), 10);
+    sdft.getBins(after.data());
+    double re, im;
+    sliding_dft_reference(x.data(), 10, length, bins[2], re, im);
+    REQUIRE(std::abs(after[2].re - re) < tol);
+    REQUIRE(std::abs(after[2].im - im) < tol);
+}
+
+TEST_CASE("ipps sliding dft", "[dft],[slidingdft]")
+{
+    SECTION("Ipp32fc"){
+        test_sliding_dft<Ipp32fc>(1e-3);
+    }
+    SECTION("Ipp64fc"){
+        test_sliding_dft<Ipp64fc>(1e-9);
+    }
+    SECTION("drift stays bounded over a long stream"){
+        const size_t length = 256, total = 200000;
+        std::vector<int> bins = {1, 50, 127};
+        ipps::SlidingDFT<Ipp32fc> sdft(length, bins, total, 4096);
+        REQUIRE(sdft.getResyncInterval() == 4096);
+        ipps::vector<Ipp32fc> x(total);
+        for (size_t i = 0; i < total; i++)
+        {
+            x[i].re = (Ipp32f)std::cos(0.77 * i);
+            x[i].im = (Ipp32f)std::sin(0.031 * i);
+        }
+        ipps::vector<Ipp32fc> out(bins.size());
+        REQUIRE(sdft.process(x.data(), total, out.data(), bins.size()) == 1);
+        for (size_t k = 0; k < bins.size(); k++)
+        {
+            double re, im;
+            sliding_dft_reference(x.data(), total, length, bins[k], re, im);
+            REQUIRE(std::abs(out[k].re - re) < 1e-2);
+            REQUIRE(std::abs(out[k].im - im) < 1e-2);
+        }
+    }
+    SECTION("invalid arguments"){
+        std::vector<int> bins = {1};
+        REQUIRE_THROWS_AS(ipps::SlidingDFT<Ipp32fc>(0, bins), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::SlidingDFT<Ipp32fc>(16, std::vector<int>()), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::SlidingDFT<Ipp32fc>(16, bins, 0), std::invalid_argument);
+
+        ipps::SlidingDFT<Ipp32fc> sdft(16, {1, 2}, 1);
+        ipps::vector<Ipp32fc> in(4), out(8);
+        REQUIRE_THROWS_AS(sdft.process(in.data(), 4, out.data(), 1), std::invalid_argument);
+
+        ipps::SlidingDFT<Ipp32fc> empty;
+        Ipp32fc sample{};
+        REQUIRE_THROWS_AS(empty.process(&sample, 1), std::runtime_error);
+    }
+}
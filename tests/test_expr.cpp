@@ -0,0 +1,120 @@
+#include <iostream>
+#include "ipp_ext.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+template <typename T>
+void fill_expr_inputs(ipps::vector<T>& a, ipps::vector<T>& b, ipps::vector<T>& c, ipps::vector<T>& d)
+{
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        a[i] = (T)(i % 17);
+        b[i] = (T)(i % 5 + 1);
+        c[i] = (T)(i % 7);
+        d[i] = (T)2;
+    }
+}
+
+TEST_CASE("ipps lazy expressions", "[expr]")
+{
+    // Spans several tiles, with a partial one at the end
+    const size_t length = 10000;
+    ipps::vector<Ipp32f> a(length), b(length), c(length), d(length);
+    fill_expr_inputs(a, b, c, d);
+
+    SECTION("sum of products")
+    {
+        ipps::vector<Ipp32f> z = a * b + c * d;
+        REQUIRE(z.size() == length);
+        for (size_t i = 0; i < length; i++)
+            REQUIRE(z[i] == a[i] * b[i] + c[i] * d[i]);
+    }
+
+    SECTION("plain sums, differences and quotients")
+    {
+        ipps::vector<Ipp32f> z = (a + b) - c / b;
+        for (size_t i = 0; i < length; i++)
+            REQUIRE(z[i] == (a[i] + b[i]) - c[i] / b[i]);
+    }
+
+    SECTION("constants")
+    {
+        ipps::vector<Ipp32f> z = 2.0f * a + 1.0f;
+        for (size_t i = 0; i < length; i++)
+            REQUIRE(z[i] == 2.0f * a[i] + 1.0f);
+
+        z = a * b - 3.0f;
+        for (size_t i = 0; i < length; i++)
+            REQUIRE(z[i] == a[i] * b[i] - 3.0f);
+    }
+
+    SECTION("destination inside the expression")
+    {
+        ipps::vector<Ipp32f> z(a);
+        z = b * c + z * d;
+        for (size_t i = 0; i < length; i++)
+            REQUIRE(z[i] == b[i] * c[i] + a[i] * d[i]);
+    }
+
+    SECTION("assignment resizes")
+    {
+        ipps::vector<Ipp32f> z(10);
+        z = a * b;
+        REQUIRE(z.size() == length);
+        REQUIRE(z[length - 1] == a[length - 1] * b[length - 1]);
+    }
+
+    SECTION("assignment resizes with the destination inside the expression")
+    {
+        ipps::vector<Ipp32f> z(a);
+        z = ipps::lazy(ipps::vector_view<Ipp32f>(z, length / 2, length / 2)) *
+            ipps::lazy(ipps::vector_view<Ipp32f>(b, 0, length / 2)) + 1.0f;
+        REQUIRE(z.size() == length / 2);
+        for (size_t i = 0; i < length / 2; i++)
+            REQUIRE(z[i] == a[length / 2 + i] * b[i] + 1.0f);
+    }
+
+    SECTION("size mismatch")
+    {
+        ipps::vector<Ipp32f> shortVec(10);
+        REQUIRE_THROWS_AS(a * shortVec, std::invalid_argument);
+    }
+}
+
+TEST_CASE("ipps lazy expressions, complex", "[expr]")
+{
+    const size_t length = 3000;
+    ipps::vector<Ipp64fc> a(length), b(length);
+    for (size_t i = 0; i < length; i++)
+    {
+        a[i] = {(Ipp64f)i, 1.0};
+        b[i] = {0.5, (Ipp64f)(i % 3)};
+    }
+
+    ipps::vector<Ipp64fc> z = a * b + a;
+    for (size_t i = 0; i < length; i++)
+    {
+        REQUIRE(z[i].re == a[i].re * b[i].re - a[i].im * b[i].im + a[i].re);
+        REQUIRE(z[i].im == a[i].re * b[i].im + a[i].im * b[i].re + a[i].im);
+    }
+}
+
+TEST_CASE("ipps lazy expressions on matrices", "[expr],[matrix]")
+{
+    ipps::matrix<Ipp32f> m1(30, 40), m2(30, 40), m3(30, 40);
+    for (size_t i = 0; i < m1.size(); i++)
+    {
+        m1[i] = (Ipp32f)i;
+        m2[i] = 0.5f;
+    }
+
+    // Elementwise, unlike m1 * m2 which is a matrix product
+    m3 = ipps::lazy(m1) * ipps::lazy(m2) + ipps::lazy(m1);
+    REQUIRE(m3.rows() == 30);
+    REQUIRE(m3.columns() == 40);
+    for (size_t i = 0; i < m3.size(); i++)
+        REQUIRE(m3[i] == m1[i] * 1.5f);
+
+    ipps::matrix<Ipp32f> wrongShape(2, 2);
+    REQUIRE_THROWS_AS(wrongShape = ipps::lazy(m1) * 2.0f, std::out_of_range);
+}
@@ -531,3 +531,752 @@ TEST_CASE("ipps filter FIRMR lowpass", "[filter],[firmr],[lowpass]")
         test_FIRMR_lowpass_cplx<Ipp64fc, Ipp64fc>();
     }
 }
+
+template <typename T>
+void test_overlap_save(size_t numTaps, size_t fftLength, double tolerance)
+{
+    ipps::vector<T> taps(numTaps);
+    for (size_t i = 0; i < numTaps; i++)
+    {
+        taps[i].re = (decltype(taps[i].re))(std::cos(0.1 * i) / numTaps);
+        taps[i].im = (decltype(taps[i].im))(std::sin(0.3 * i) / numTaps);
+    }
+
+    ipps::filter::OverlapSave<T> filter(taps, fftLength);
+    REQUIRE(filter.getFFTLength() >= numTaps);
+    REQUIRE(filter.getDelayVector().size() == numTaps - 1);
+
+    // Process in chunks of varying length, shorter and longer than a block
+    const size_t total = 3 * filter.getFFTLength() + 17;
+    ipps::vector<T> data(total);
+    for (size_t i = 0; i < total; i++)
+    {
+        data[i].re = (decltype(data[i].re))((i * 7 % 11) - 5.0);
+        data[i].im = (decltype(data[i].im))((i * 3 % 5) - 2.0);
+    }
+    ipps::vector<T> result(total);
+    const size_t chunks[] = {1, 5, filter.getBlockLength() + 3, 64, 2 * filter.getFFTLength()};
+    size_t offset = 0;
+    for (size_t c = 0; offset < total; c++)
+    {
+        size_t len = std::min(chunks[c % 5], total - offset);
+        filter.filter(data.data() + offset, result.data() + offset, len);
+        offset += len;
+    }
+
+    for (size_t i = 0; i < total; i++)
+    {
+        double re = 0, im = 0;
+        for (size_t k = 0; k < numTaps && k <= i; k++)
+        {
+            re += (double)taps[k].re * data[i - k].re - (double)taps[k].im * data[i - k].im;
+            im += (double)taps[k].re * data[i - k].im + (double)taps[k].im * data[i - k].re;
+        }
+        REQUIRE(std::abs(result[i].re - re) < tolerance);
+        REQUIRE(std::abs(result[i].im - im) < tolerance);
+    }
+
+    // The delay holds the last inputs, as with FIRSR
+    for (size_t i = 0; i < numTaps - 1; i++)
+    {
+        REQUIRE(filter.getDelayVector()[i].re == data[total - numTaps + 1 + i].re);
+        REQUIRE(filter.getDelayVector()[i].im == data[total - numTaps + 1 + i].im);
+    }
+}
+
+TEST_CASE("ipps filter OverlapSave", "[filter],[overlapsave]")
+{
+    SECTION("Ipp32fc, automatic FFT length"){
+        test_overlap_save<Ipp32fc>(100, 0, 1e-3);
+    }
+    SECTION("Ipp64fc, automatic FFT length"){
+        test_overlap_save<Ipp64fc>(100, 0, 1e-9);
+    }
+    SECTION("Ipp32fc, small non power of 2 FFT length"){
+        test_overlap_save<Ipp32fc>(33, 40, 1e-3);
+    }
+    SECTION("Ipp64fc, single tap"){
+        test_overlap_save<Ipp64fc>(1, 0, 1e-9);
+    }
+    SECTION("in-place matches FIRSR"){
+        ipps::vector<Ipp32fc> taps = ipps::filter::generateLowpassTaps<Ipp32fc>(0.1, 64, ippWinHamming, ippTrue);
+        ipps::filter::FIRSR<Ipp32fc, Ipp32fc> direct(taps);
+        ipps::filter::OverlapSave<Ipp32fc> fast(taps);
+
+        ipps::vector<Ipp32fc> data(1000), expected(1000);
+        for (size_t i = 0; i < data.size(); i++)
+        {
+            data[i].re = (Ipp32f)(i % 13);
+            data[i].im = -(Ipp32f)(i % 7);
+        }
+        direct.filter(data.data(), expected.data(), (int)data.size());
+        fast.filter(data.data(), data.data(), data.size());
+        for (size_t i = 0; i < data.size(); i++)
+        {
+            REQUIRE(std::abs(data[i].re - expected[i].re) < 1e-3);
+            REQUIRE(std::abs(data[i].im - expected[i].im) < 1e-3);
+        }
+    }
+    SECTION("invalid arguments"){
+        ipps::vector<Ipp32fc> taps(64);
+        REQUIRE_THROWS_AS(ipps::filter::OverlapSave<Ipp32fc>(taps, 32), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::filter::OverlapSave<Ipp32fc>(ipps::vector<Ipp32fc>()), std::invalid_argument);
+    }
+    SECTION("automatic FFT length"){
+        size_t n = ipps::filter::OverlapSave<Ipp32fc>::chooseFFTLength(4096);
+        REQUIRE(n >= 2 * 4096);
+        REQUIRE((n & (n - 1)) == 0);
+
+        // Longer than the usual search range
+        size_t longTaps = ((size_t)1 << 24) + 1;
+        n = ipps::filter::OverlapSave<Ipp32fc>::chooseFFTLength(longTaps);
+        REQUIRE(n >= longTaps);
+        REQUIRE((n & (n - 1)) == 0);
+    }
+}
+
+template <typename T>
+static void naive_convolve(const ipps::vector<T>& taps, const ipps::vector<T>& in, ipps::vector<T>& out)
+{
+    for (size_t i = 0; i < in.size(); i++)
+    {
+        double re = 0, im = 0;
+        for (size_t k = 0; k < taps.size() && k <= i; k++)
+        {
+            re += (double)taps[k].re * in[i-k].re - (double)taps[k].im * in[i-k].im;
+            im += (double)taps[k].re * in[i-k].im + (double)taps[k].im * in[i-k].re;
+        }
+        out[i].re = re;
+        out[i].im = im;
+    }
+}
+
+template <typename T>
+static void test_partitioned(size_t numTaps, size_t blockLength, double tol)
+{
+    ipps::vector<T> taps(numTaps);
+    for (size_t i = 0; i < numTaps; i++)
+    {
+        taps[i].re = std::cos(0.37 * i) / (1.0 + 0.01 * i);
+        taps[i].im = std::sin(0.11 * i) / (1.0 + 0.01 * i);
+    }
+    ipps::vector<T> data(5 * numTaps + 37), expected(data.size()), result(data.size());
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i].re = std::sin(0.05 * i);
+        data[i].im = (double)(i % 5) - 2.0;
+    }
+    naive_convolve(taps, data, expected);
+
+    ipps::filter::PartitionedConvolution<T> filter(taps, blockLength);
+    REQUIRE(filter.getBlockLength() == blockLength);
+    REQUIRE(filter.getNumPartitions() == (numTaps + blockLength - 1) / blockLength);
+
+    // Irregular chunks, straddling block boundaries
+    const size_t chunks[] = {1, blockLength, 3, 2 * blockLength + 1, 17};
+    size_t offset = 0, c = 0;
+    while (offset < data.size())
+    {
+        size_t count = std::min(chunks[c++ % 5], data.size() - offset);
+        filter.filter(data.data() + offset, result.data() + offset, count);
+        offset += count;
+    }
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        REQUIRE(std::abs(result[i].re - expected[i].re) < tol);
+        REQUIRE(std::abs(result[i].im - expected[i].im) < tol);
+    }
+}
+
+TEST_CASE("ipps filter PartitionedConvolution", "[filter],[partitioned]")
+{
+    SECTION("Ipp32fc, many partitions"){
+        test_partitioned<Ipp32fc>(300, 16, 1e-2);
+    }
+    SECTION("Ipp64fc, many partitions"){
+        test_partitioned<Ipp64fc>(300, 16, 1e-9);
+    }
+    SECTION("Ipp64fc, single partition"){
+        test_partitioned<Ipp64fc>(10, 32, 1e-9);
+    }
+    SECTION("Ipp64fc, non power of 2 block"){
+        test_partitioned<Ipp64fc>(100, 12, 1e-9);
+    }
+    SECTION("channels sharing one response"){
+        ipps::vector<Ipp64fc> taps(50);
+        for (size_t i = 0; i < taps.size(); i++)
+        {
+            taps[i].re = 1.0 / (1.0 + i);
+            taps[i].im = 0.5 - 0.01 * i;
+        }
+        auto response = std::make_shared<const ipps::filter::PartitionedResponse<Ipp64fc>>(taps, 8);
+        ipps::filter::PartitionedConvolution<Ipp64fc> a(response), b(response);
+        REQUIRE(a.getResponse() == b.getResponse());
+
+        ipps::vector<Ipp64fc> x(200), y(200), expectedX(200), expectedY(200), outX(200), outY(200);
+        for (size_t i = 0; i < x.size(); i++)
+        {
+            x[i].re = (double)(i % 9); x[i].im = 0;
+            y[i].re = 0; y[i].im = -(double)(i % 4);
+        }
+        naive_convolve(taps, x, expectedX);
+        naive_convolve(taps, y, expectedY);
+
+        // Interleave the channels to check they keep separate state
+        for (size_t i = 0; i < x.size(); i += 20)
+        {
+            a.filter(x.data() + i, outX.data() + i, 20);
+            b.filter(y.data() + i, outY.data() + i, 20);
+        }
+        for (size_t i = 0; i < x.size(); i++)
+        {
+            REQUIRE(std::abs(outX[i].re - expectedX[i].re) < 1e-9);
+            REQUIRE(std::abs(outX[i].im - expectedX[i].im) < 1e-9);
+            REQUIRE(std::abs(outY[i].re - expectedY[i].re) < 1e-9);
+            REQUIRE(std::abs(outY[i].im - expectedY[i].im) < 1e-9);
+        }
+
+        // Resetting gives the same output again
+        a.reset();
+        a.filter(x.data(), outY.data(), x.size());
+        for (size_t i = 0; i < x.size(); i++)
+            REQUIRE(std::abs(outY[i].re - expectedX[i].re) < 1e-9);
+    }
+    SECTION("invalid arguments"){
+        ipps::vector<Ipp32fc> taps(64);
+        REQUIRE_THROWS_AS(ipps::filter::PartitionedConvolution<Ipp32fc>(taps, 0), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::filter::PartitionedConvolution<Ipp32fc>(ipps::vector<Ipp32fc>(), 16), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::filter::PartitionedConvolution<Ipp32fc>(
+            std::shared_ptr<const ipps::filter::PartitionedResponse<Ipp32fc>>()), std::invalid_argument);
+
+        ipps::filter::PartitionedConvolution<Ipp32fc> empty;
+        Ipp32fc sample{};
+        REQUIRE_THROWS_AS(empty.filter(&sample, &sample, 1), std::runtime_error);
+    }
+}
+
+// y_m[n] = sum_l h[l] x[nD - l] exp(-2 pi i m (nD - l) / M), straight from the definition
+template <typename T>
+static void naive_channelize(const ipps::vector<T>& taps, const ipps::vector<T>& x, size_t M, size_t D,
+                             size_t m, size_t n, double& re, double& im)
+{
+    re = 0;
+    im = 0;
+    long long k = (long long)(n * D);
+    for (size_t l = 0; l < taps.size(); l++)
+    {
+        long long i = k - (long long)l;
+        if (i < 0)
+            break;
+        double phase = -2 * IPP_PI * (double)m * (double)i / (double)M;
+        double c = std::cos(phase), s = std::sin(phase);
+        double xr = x[i].re * c - x[i].im * s, xi = x[i].re * s + x[i].im * c;
+        re += taps[l].re * xr - taps[l].im * xi;
+        im += taps[l].re * xi + taps[l].im * xr;
+    }
+}
+
+template <typename T>
+void test_channelizer(size_t M, size_t tapsPerChannel, ipps::filter::ChannelizerMode mode, double tol)
+{
+    typedef decltype(T().re) R;
+    const size_t length = 40 * M + 3;
+    ipps::vector<T> x(length);
+    for (size_t i = 0; i < length; i++)
+    {
+        x[i].re = (R)(std::cos(0.37 * i) + 0.2 * std::sin(2.1 * i));
+        x[i].im = (R)std::sin(0.0051 * i * i);
+    }
+
+    ipps::filter::PolyphaseChannelizer<T> channelizer(M, tapsPerChannel, mode);
+    const size_t D = channelizer.getDecimation();
+    REQUIRE(D == (mode == ipps::filter::ChannelizerMode::Critical ? M : M / 2));
+    REQUIRE(channelizer.getTaps().size() == M * tapsPerChannel);
+
+    // Pushed in uneven chunks, each into its own matrix
+    const size_t total = channelizer.outputsFor(length);
+    REQUIRE(total == (length - 1) / D + 1);
+    ipps::matrix<T> all(M, total);
+    const size_t chunks[] = {1, M - 1, 3 * M + 5, 7, length};
+    size_t pushed = 0, n0 = 0;
+    for (size_t chunk : chunks)
+    {
+        chunk = std::min(chunk, length - pushed);
+        size_t expected = channelizer.outputsFor(chunk);
+        ipps::matrix<T> out(M, std::max(expected, (size_t)1));
+        size_t written = channelizer.process(x.data() + pushed, chunk, out);
+        REQUIRE(written == expected);
+        for (size_t m = 0; m < M; m++)
+            for (size_t j = 0; j < written; j++)
+                all.row(m)[n0 + j] = out.row(m)[j];
+        pushed += chunk;
+        n0 += written;
+    }
+    REQUIRE(pushed == length);
+    REQUIRE(n0 == total);
+
+    for (size_t m = 0; m < M; m++)
+    {
+        for (size_t n = 0; n < total; n++)
+        {
+            double re, im;
+            naive_channelize(channelizer.getTaps(), x, M, D, m, n, re, im);
+            REQUIRE(std::abs(all.row(m)[n].re - re) < tol);
+            REQUIRE(std::abs(all.row(m)[n].im - im) < tol);
+        }
+    }
+}
+
+TEST_CASE("ipps filter PolyphaseChannelizer", "[filter],[channelizer]")
+{
+    SECTION("Ipp32fc, critically sampled"){
+        test_channelizer<Ipp32fc>(8, 4, ipps::filter::ChannelizerMode::Critical, 1e-4);
+    }
+    SECTION("Ipp64fc, critically sampled"){
+        test_channelizer<Ipp64fc>(8, 4, ipps::filter::ChannelizerMode::Critical, 1e-10);
+    }
+    SECTION("Ipp64fc, oversampled"){
+        test_channelizer<Ipp64fc>(8, 4, ipps::filter::ChannelizerMode::Oversampled, 1e-10);
+    }
+    SECTION("Ipp64fc, oversampled, non power of 2"){
+        test_channelizer<Ipp64fc>(6, 5, ipps::filter::ChannelizerMode::Oversampled, 1e-10);
+    }
+    SECTION("tone lands in its channel"){
+        const size_t M = 16;
+        ipps::filter::PolyphaseChannelizer<Ipp64fc> channelizer(M, 8, ipps::filter::ChannelizerMode::Oversampled);
+        ipps::vector<Ipp64fc> x(64 * M);
+        for (size_t i = 0; i < x.size(); i++)
+        {
+            x[i].re = std::cos(2 * IPP_PI * 5.0 * i / M);
+            x[i].im = std::sin(2 * IPP_PI * 5.0 * i / M);
+        }
+        ipps::matrix<Ipp64fc> out(M, channelizer.outputsFor(x.size()));
+        size_t written = channelizer.process(x.data(), x.size(), out);
+
+        // Past the filter's start-up, channel 5 holds the tone at unit gain and the others are far below
+        for (size_t m = 0; m < M; m++)
+        {
+            const Ipp64fc& y = out.row(m)[written - 1];
+            double magnitude = std::sqrt(y.re * y.re + y.im * y.im);
+            if (m == 5)
+                REQUIRE(std::abs(magnitude - 1.0) < 1e-2);
+            else
+                REQUIRE(magnitude < 1e-2);
+        }
+    }
+    SECTION("invalid arguments"){
+        ipps::vector<Ipp32fc> taps(32);
+        REQUIRE_THROWS_AS(ipps::filter::PolyphaseChannelizer<Ipp32fc>(taps, 1), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::filter::PolyphaseChannelizer<Ipp32fc>(ipps::vector<Ipp32fc>(), 4), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::filter::PolyphaseChannelizer<Ipp32fc>(taps, 5, ipps::filter::ChannelizerMode::Oversampled),
+                          std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::filter::PolyphaseChannelizer<Ipp32fc>(4, 0), std::invalid_argument);
+
+        ipps::filter::PolyphaseChannelizer<Ipp32fc> channelizer(taps, 4);
+        ipps::vector<Ipp32fc> x(16);
+        ipps::matrix<Ipp32fc> wrongRows(3, 4), tooShort(4, 3);
+        REQUIRE_THROWS_AS(channelizer.process(x.data(), x.size(), wrongRows), std::invalid_argument);
+        REQUIRE_THROWS_AS(channelizer.process(x.data(), x.size(), tooShort), std::invalid_argument);
+
+        ipps::filter::PolyphaseChannelizer<Ipp32fc> empty;
+        Ipp32fc sample{};
+        REQUIRE_THROWS_AS(empty.process(&sample, 1, &sample, 1), std::runtime_error);
+    }
+}
+
+// x[k] = sum_m exp(2 pi i m k / M) sum_n y_m[n] g[k - nD], straight from the definition
+template <typename T>
+static void naive_synthesize(const ipps::vector<T>& taps, ipps::matrix<T>& y, size_t D,
+                             size_t k, double& re, double& im)
+{
+    const size_t M = y.rows();
+    re = 0;
+    im = 0;
+    for (size_t n = 0; n < y.columns() && n * D <= k; n++)
+    {
+        size_t l = k - n * D;
+        if (l >= taps.size())
+            continue;
+        for (size_t m = 0; m < M; m++)
+        {
+            double phase = 2 * IPP_PI * (double)m * (double)k / (double)M;
+            double c = std::cos(phase), s = std::sin(phase);
+            const T& v = y.row(m)[n];
+            double gr = taps[l].re * v.re - taps[l].im * v.im, gi = taps[l].re * v.im + taps[l].im * v.re;
+            re += gr * c - gi * s;
+            im += gr * s + gi * c;
+        }
+    }
+}
+
+template <typename T>
+void test_synthesizer(size_t M, size_t tapsPerChannel, ipps::filter::ChannelizerMode mode, double tol)
+{
+    typedef decltype(T().re) R;
+    ipps::filter::PolyphaseSynthesizer<T> synthesizer(M, tapsPerChannel, mode);
+    const size_t D = synthesizer.getInterpolation();
+    REQUIRE(D == (mode == ipps::filter::ChannelizerMode::Critical ? M : M / 2));
+    REQUIRE(synthesizer.getTaps().size() == M * tapsPerChannel + 1);
+
+    const size_t instants = 3 * tapsPerChannel + 5;
+    ipps::matrix<T> y(M, instants);
+    for (size_t m = 0; m < M; m++)
+    {
+        for (size_t n = 0; n < instants; n++)
+        {
+            y.row(m)[n].re = (R)std::cos(0.3 * n + 1.7 * m);
+            y.row(m)[n].im = (R)std::sin(0.11 * n * m + 0.2);
+        }
+    }
+
+    // Instants pushed a few at a time, continuing from the overlap
+    ipps::vector<T> out(instants * D);
+    size_t done = 0;
+    const size_t chunks[] = {1, 4, 2, instants};
+    for (size_t chunk : chunks)
+    {
+        chunk = std::min(chunk, instants - done);
+        REQUIRE(synthesizer.process(y.data() + done, y.columns(), chunk, out.data() + done * D) == chunk * D);
+        done += chunk;
+    }
+    REQUIRE(synthesizer.getInstantCount() == instants);
+
+    for (size_t k = 0; k < out.size(); k++)
+    {
+        double re, im;
+        naive_synthesize(synthesizer.getTaps(), y, D, k, re, im);
+        REQUIRE(std::abs(out[k].re - re) < tol);
+        REQUIRE(std::abs(out[k].im - im) < tol);
+    }
+}
+
+template <typename T>
+void test_reconstruction(size_t M, size_t tapsPerChannel, double maxError)
+{
+    typedef decltype(T().re) R;
+    // A Nyquist(M) analysis prototype: an odd-length windowed sinc with its centre on a multiple of M
+    ipps::vector<T> analysisTaps = ipps::filter::generateLowpassTaps<T>(
+        0.5 / M, (int)(M * tapsPerChannel + 1), ippWinHamming, ippTrue);
+    ipps::filter::PolyphaseChannelizer<T> channelizer(analysisTaps, M, ipps::filter::ChannelizerMode::Oversampled);
+    ipps::filter::PolyphaseSynthesizer<T> synthesizer(M, tapsPerChannel, ipps::filter::ChannelizerMode::Oversampled);
+
+    // Broadband input, channelized and resynthesized in separate chunks
+    const size_t length = 200 * M;
+    ipps::vector<T> x(length), out(length);
+    for (size_t i = 0; i < length; i++)
+    {
+        x[i].re = (R)(std::cos(0.9 * i) + 0.5 * std::cos(0.0123 * i * i));
+        x[i].im = (R)(std::sin(2.3 * i) - 0.4 * std::sin(0.007 * i * i));
+    }
+    const size_t chunk = 25 * M;
+    size_t produced = 0;
+    for (size_t i = 0; i < length; i += chunk)
+    {
+        ipps::matrix<T> channels(M, channelizer.outputsFor(chunk));
+        size_t instants = channelizer.process(x.data() + i, chunk, channels);
+        REQUIRE(synthesizer.process(channels, out.data() + produced) == instants * M / 2);
+        produced += instants * M / 2;
+    }
+    REQUIRE(produced == length);
+
+    // The output is the input, delayed by both filters' group delays
+    const size_t delay = (analysisTaps.size() - 1) / 2 + (synthesizer.getTaps().size() - 1) / 2;
+    double error = 0, power = 0;
+    for (size_t k = 2 * delay; k < length; k++)
+    {
+        const T& a = out[k];
+        const T& b = x[k - delay];
+        error += (a.re - b.re) * (a.re - b.re) + (a.im - b.im) * (a.im - b.im);
+        power += b.re * b.re + b.im * b.im;
+    }
+    REQUIRE(std::sqrt(error / power) < maxError);
+}
+
+TEST_CASE("ipps filter PolyphaseSynthesizer", "[filter],[synthesizer]")
+{
+    SECTION("Ipp32fc, critically sampled"){
+        test_synthesizer<Ipp32fc>(8, 4, ipps::filter::ChannelizerMode::Critical, 1e-4);
+    }
+    SECTION("Ipp64fc, critically sampled"){
+        test_synthesizer<Ipp64fc>(8, 4, ipps::filter::ChannelizerMode::Critical, 1e-10);
+    }
+    SECTION("Ipp64fc, oversampled"){
+        test_synthesizer<Ipp64fc>(8, 4, ipps::filter::ChannelizerMode::Oversampled, 1e-10);
+    }
+    SECTION("Ipp64fc, oversampled, non power of 2"){
+        test_synthesizer<Ipp64fc>(6, 3, ipps::filter::ChannelizerMode::Oversampled, 1e-10);
+    }
+    SECTION("Ipp32fc, reconstruction through an oversampled channelizer"){
+        test_reconstruction<Ipp32fc>(16, 16, 1e-2);
+    }
+    SECTION("Ipp64fc, reconstruction through an oversampled channelizer"){
+        test_reconstruction<Ipp64fc>(8, 24, 1e-2);
+    }
+    SECTION("invalid arguments"){
+        ipps::vector<Ipp32fc> taps(32);
+        REQUIRE_THROWS_AS(ipps::filter::PolyphaseSynthesizer<Ipp32fc>(taps, 1), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::filter::PolyphaseSynthesizer<Ipp32fc>(ipps::vector<Ipp32fc>(), 4), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::filter::PolyphaseSynthesizer<Ipp32fc>(taps, 5, ipps::filter::ChannelizerMode::Oversampled),
+                          std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::filter::PolyphaseSynthesizer<Ipp32fc>(4, 0), std::invalid_argument);
+
+        ipps::filter::PolyphaseSynthesizer<Ipp32fc> synthesizer(taps, 4);
+        ipps::matrix<Ipp32fc> wrongRows(3, 4);
+        ipps::vector<Ipp32fc> out(16);
+        REQUIRE_THROWS_AS(synthesizer.process(wrongRows, out.data()), std::invalid_argument);
+        REQUIRE_THROWS_AS(synthesizer.process(wrongRows.data(), 2, 4, out.data()), std::invalid_argument);
+
+        ipps::filter::PolyphaseSynthesizer<Ipp32fc> empty;
+        Ipp32fc sample{};
+        REQUIRE_THROWS_AS(empty.process(&sample, 1, 1, &sample), std::runtime_error);
+    }
+}
+
+inline void set_sample(Ipp32f& x, double re, double) { x = (Ipp32f)re; }
+inline void set_sample(Ipp64f& x, double re, double) { x = re; }
+inline void set_sample(Ipp64fc& x, double re, double im) { x.re = re; x.im = im; }
+inline double sample_error(Ipp32f a, Ipp32f b) { return std::abs(a - b); }
+inline double sample_error(Ipp64f a, Ipp64f b) { return std::abs(a - b); }
+inline double sample_error(const Ipp64fc& a, const Ipp64fc& b) { return std::abs(a.re - b.re) + std::abs(a.im - b.im); }
+
+template <typename T>
+void test_resampler_streaming(int up, int down, double tol)
+{
+    ipps::filter::Resampler<T> resampler(up, down);
+    REQUIRE(resampler.getUpFactor() == up);
+    REQUIRE(resampler.getDownFactor() == down);
+
+    const size_t length = 60 * (size_t)down + 1;
+    ipps::vector<T> x(length);
+    for (size_t i = 0; i < length; i++)
+        set_sample(x[i], std::cos(0.05 * i) + 0.3 * std::sin(0.71 * i), std::sin(0.13 * i));
+
+    // The reference sees the whole stream in one FIRMR call
+    ipps::vector<T> taps = resampler.getTaps();
+    ipps::filter::FIRMR<T, T> reference(taps, up, 0, down, 0);
+    const size_t expected = length / (size_t)down * (size_t)up;
+    ipps::vector<T> ref(expected);
+    reference.filter(x.data(), ref.data(), (int)length, (int)ref.size());
+
+    // Chunks of awkward sizes, including empty ones and ones shorter than the down factor
+    ipps::vector<T> out(expected);
+    const size_t chunks[] = {1, 0, 2, 7, 1, 13, 3, 31, 5, 64};
+    size_t done = 0, produced = 0;
+    for (size_t c = 0; done < length; c++)
+    {
+        size_t chunk = std::min(chunks[c % 10], length - done);
+        size_t predicted = resampler.outputsFor(chunk);
+        size_t n = resampler.process(x.data() + done, chunk, out.data() + produced);
+        REQUIRE(n == predicted);
+        done += chunk;
+        produced += n;
+        REQUIRE(resampler.getBufferedCount() < (size_t)down);
+    }
+    REQUIRE(produced == expected);
+    REQUIRE(resampler.getBufferedCount() == length % (size_t)down);
+
+    for (size_t i = 0; i < expected; i++)
+        REQUIRE(sample_error(out[i], ref[i]) < tol);
+
+    // After a reset it starts over, matching the start of the reference
+    resampler.reset();
+    REQUIRE(resampler.getBufferedCount() == 0);
+    size_t n = resampler.process(x.data(), 4 * (size_t)down, out.data());
+    REQUIRE(n == 4 * (size_t)up);
+    for (size_t i = 0; i < n; i++)
+        REQUIRE(sample_error(out[i], ref[i]) < tol);
+}
+
+TEST_CASE("ipps filter Resampler", "[filter],[resampler]")
+{
+    SECTION("Ipp32f, 3/2, random chunks match one FIRMR call"){
+        test_resampler_streaming<Ipp32f>(3, 2, 1e-5);
+    }
+    SECTION("Ipp64f, 2/7, random chunks match one FIRMR call"){
+        test_resampler_streaming<Ipp64f>(2, 7, 1e-12);
+    }
+    SECTION("Ipp64fc, 160/147, random chunks match one FIRMR call"){
+        test_resampler_streaming<Ipp64fc>(160, 147, 1e-12);
+    }
+    SECTION("factors are reduced"){
+        ipps::filter::Resampler<Ipp64f> resampler(6, 4);
+        REQUIRE(resampler.getUpFactor() == 3);
+        REQUIRE(resampler.getDownFactor() == 2);
+        REQUIRE(resampler.getTaps().size() == 2 * 10 * 3 + 1);
+    }
+    SECTION("unit gain at DC"){
+        const int up = 3, down = 2;
+        ipps::filter::Resampler<Ipp64f> resampler(up, down);
+        ipps::vector<Ipp64f> ones(400), out(600);
+        ones.set(1.0);
+        REQUIRE(resampler.process(ones.data(), ones.size(), out.data()) == 600);
+        // Settled once the taps are full of input
+        size_t settled = resampler.getTaps().size() / down + 1;
+        for (size_t i = settled; i < out.size(); i++)
+            REQUIRE(std::abs(out[i] - 1.0) < 1e-2);
+    }
+    SECTION("invalid arguments"){
+        REQUIRE_THROWS_AS(ipps::filter::Resampler<Ipp32f>(0, 2), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::filter::Resampler<Ipp32f>(3, -1), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::filter::Resampler<Ipp32f>(3, 2, 0), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::filter::Resampler<Ipp32f>(ipps::vector<Ipp32f>(), 3, 2), std::invalid_argument);
+
+        ipps::filter::Resampler<Ipp32f> empty;
+        Ipp32f sample = 0;
+        REQUIRE_THROWS_AS(empty.process(&sample, 1, &sample), std::runtime_error);
+    }
+}
+
+template <typename T>
+void test_farrow_streaming(double ratio, int order, double tol)
+{
+    ipps::filter::FarrowResampler<T> oneShot(ratio, order), streamed(ratio, order);
+
+    const size_t length = 9000; // more than two internal blocks
+    ipps::vector<T> x(length);
+    for (size_t i = 0; i < length; i++)
+        set_sample(x[i], std::cos(0.05 * i) + 0.3 * std::sin(0.71 * i), std::sin(0.13 * i));
+
+    const size_t expected = oneShot.outputsFor(length);
+    ipps::vector<T> ref(expected);
+    REQUIRE(oneShot.process(x.data(), length, ref.data()) == expected);
+
+    ipps::vector<T> out(expected);
+    const size_t chunks[] = {1, 0, 2, 7, 1, 13, 3, 31, 5, 4500};
+    size_t done = 0, produced = 0;
+    for (size_t c = 0; done < length; c++)
+    {
+        size_t chunk = std::min(chunks[c % 10], length - done);
+        size_t predicted = streamed.outputsFor(chunk);
+        size_t n = streamed.process(x.data() + done, chunk, out.data() + produced);
+        REQUIRE(n == predicted);
+        done += chunk;
+        produced += n;
+    }
+    REQUIRE(produced == expected);
+    for (size_t i = 0; i < expected; i++)
+        REQUIRE(sample_error(out[i], ref[i]) < tol);
+}
+
+// Lagrange interpolation of order P reproduces polynomials of degree up to P
+template <typename T>
+void test_farrow_polynomial(double ratio, int order)
+{
+    ipps::filter::FarrowResampler<T> resampler(ratio, order);
+    auto poly = [](double t){ return 1.0 + 0.01 * t - 2e-4 * t * t + 1e-6 * t * t * t; };
+
+    const size_t length = 300;
+    ipps::vector<T> x(length);
+    for (size_t i = 0; i < length; i++)
+        set_sample(x[i], poly((double)i), -poly((double)i));
+    ipps::vector<T> out(resampler.outputsFor(length));
+    REQUIRE(resampler.process(x.data(), length, out.data()) == out.size());
+
+    for (size_t k = 0; k < out.size(); k++)
+    {
+        double t = (double)k / ratio - (double)resampler.getDelay();
+        // Skip the outputs whose stencils reach into the zeros before the input
+        if (t < (double)order)
+            continue;
+        T expected;
+        set_sample(expected, poly(t), -poly(t));
+        REQUIRE(sample_error(out[k], expected) < 1e-6);
+    }
+}
+
+// RMS error against an exact complex tone at the output rate
+template <typename T>
+double farrow_tone_error(double ratio, int order, double frequency)
+{
+    ipps::filter::FarrowResampler<T> resampler(ratio, order);
+    const size_t length = 4000;
+    ipps::vector<T> x(length);
+    for (size_t i = 0; i < length; i++)
+        set_sample(x[i], std::cos(2 * IPP_PI * frequency * i), std::sin(2 * IPP_PI * frequency * i));
+    ipps::vector<T> out(resampler.outputsFor(length));
+    resampler.process(x.data(), length, out.data());
+
+    double error = 0;
+    size_t count = 0;
+    for (size_t k = 0; k < out.size(); k++)
+    {
+        double t = (double)k / ratio - (double)resampler.getDelay();
+        if (t < (double)order)
+            continue;
+        T expected;
+        set_sample(expected, std::cos(2 * IPP_PI * frequency * t), std::sin(2 * IPP_PI * frequency * t));
+        error += sample_error(out[k], expected) * sample_error(out[k], expected);
+        count++;
+    }
+    return std::sqrt(error / (double)count);
+}
+
+TEST_CASE("ipps filter FarrowResampler", "[filter],[farrow]")
+{
+    SECTION("coefficients interpolate the stencil"){
+        for (int order = 1; order <= 9; order += 2)
+        {
+            auto coefs = ipps::filter::FarrowResampler<Ipp64f>::coefficients(order);
+            const int h = (order - 1) / 2;
+            // At mu = 0 only the stencil's sample at 0 contributes, and the weights sum to 1 for any mu
+            for (int j = 0; j <= order; j++)
+                REQUIRE(std::abs(coefs[0][(size_t)j] - (j == h ? 1.0 : 0.0)) < 1e-12);
+            double mu = 0.37;
+            double sum = 0;
+            for (int j = 0; j <= order; j++)
+                for (int k = order; k >= 0; k--)
+                    sum += coefs[(size_t)k][(size_t)j] * std::pow(mu, k);
+            REQUIRE(std::abs(sum - 1.0) < 1e-12);
+        }
+    }
+    SECTION("ratio 1 is a pure delay"){
+        ipps::filter::FarrowResampler<Ipp64f> resampler(1.0, 5);
+        ipps::vector<Ipp64f> x(100), out(100);
+        for (size_t i = 0; i < x.size(); i++)
+            x[i] = std::sin(0.3 * i) + 0.01 * i;
+        REQUIRE(resampler.process(x.data(), x.size(), out.data()) == x.size());
+        for (size_t i = resampler.getDelay(); i < out.size(); i++)
+            REQUIRE(std::abs(out[i] - x[i - resampler.getDelay()]) < 1e-12);
+    }
+    SECTION("Ipp32f, random chunks match one call"){
+        test_farrow_streaming<Ipp32f>(1.0 / 1.37, 3, 1e-6);
+    }
+    SECTION("Ipp64f, random chunks match one call"){
+        test_farrow_streaming<Ipp64f>(std::sqrt(2.0), 5, 1e-12);
+    }
+    SECTION("Ipp64fc, random chunks match one call"){
+        test_farrow_streaming<Ipp64fc>(0.913, 7, 1e-12);
+    }
+    SECTION("cubic and quintic reproduce polynomials"){
+        test_farrow_polynomial<Ipp64f>(1.0 / IPP_PI, 3);
+        test_farrow_polynomial<Ipp64fc>(std::sqrt(3.0), 5);
+    }
+    SECTION("higher orders are more accurate"){
+        double cubic = farrow_tone_error<Ipp64fc>(1.2345, 3, 0.05);
+        double seventh = farrow_tone_error<Ipp64fc>(1.2345, 7, 0.05);
+        REQUIRE(cubic < 1e-2);
+        REQUIRE(seventh < cubic / 10);
+    }
+    SECTION("ratio changes take effect mid-stream"){
+        ipps::filter::FarrowResampler<Ipp32f> resampler(1.5);
+        ipps::vector<Ipp32f> x(1000), out(4000);
+        x.zero();
+        size_t n = resampler.process(x.data(), 100, out.data());
+        REQUIRE(n == 150);
+        resampler.setRatio(0.5 * (1 + 1e-5));
+        REQUIRE(resampler.getRatio() == 0.5 * (1 + 1e-5));
+        size_t predicted = resampler.outputsFor(900);
+        REQUIRE(resampler.process(x.data() + 100, 900, out.data() + n) == predicted);
+        REQUIRE(std::abs((double)predicted - 450.0) <= 1.0);
+    }
+    SECTION("invalid arguments"){
+        REQUIRE_THROWS_AS(ipps::filter::FarrowResampler<Ipp32f>(1.0, 2), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::filter::FarrowResampler<Ipp32f>(1.0, 11), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::filter::FarrowResampler<Ipp32f>(0.0), std::invalid_argument);
+        REQUIRE_THROWS_AS(ipps::filter::FarrowResampler<Ipp32f>(-2.0), std::invalid_argument);
+
+        ipps::filter::FarrowResampler<Ipp32f> empty;
+        Ipp32f sample = 0;
+        REQUIRE_THROWS_AS(empty.process(&sample, 1, &sample), std::runtime_error);
+    }
+}
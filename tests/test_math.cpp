@@ -2225,3 +2225,57 @@ TEST_CASE("ipps math AddProductC", "[math], [AddProductC]")
         test_AddProductC<Ipp64f>();
     }
 }
+
+// ===========================
+TEST_CASE("ipps ScopedChunkLength", "[math], [chunked]")
+{
+    const size_t before = ipps::detail::chunkLength();
+    try
+    {
+        ipps::detail::ScopedChunkLength smallChunks(64);
+        REQUIRE(ipps::detail::chunkLength() == 64);
+        throw std::runtime_error("leaving the scope early");
+    }
+    catch (const std::runtime_error&)
+    {
+    }
+    REQUIRE(ipps::detail::chunkLength() == before);
+}
+
+TEST_CASE("ipps math size_t lengths", "[math], [chunked]")
+{
+    // Force small chunks so that a few hundred elements span several IPP calls
+    ipps::detail::ScopedChunkLength smallChunks(64);
+
+    const size_t len = 1000;
+    ipps::vector<Ipp32f> x(len), y(len), result(len);
+    for (size_t i = 0; i < len; i++)
+    {
+        x[i] = (Ipp32f)i;
+        y[i] = (Ipp32f)(2 * i + 1);
+    }
+
+    SECTION("Add"){
+        ipps::math::Add(x.data(), y.data(), result.data(), x.size());
+        for (size_t i = 0; i < len; i++)
+            REQUIRE(result[i] == x[i] + y[i]);
+    }
+    SECTION("Sub"){
+        ipps::math::Sub(x.data(), y.data(), result.data(), x.size());
+        for (size_t i = 0; i < len; i++)
+            REQUIRE(result[i] == y[i] - x[i]);
+    }
+    SECTION("Mul"){
+        ipps::math::Mul(x.data(), y.data(), result.data(), x.size());
+        for (size_t i = 0; i < len; i++)
+            REQUIRE(result[i] == x[i] * y[i]);
+    }
+    SECTION("MulC"){
+        ipps::math::MulC(x.data(), 3.0f, result.data(), x.size());
+        for (size_t i = 0; i < len; i++)
+            REQUIRE(result[i] == x[i] * 3.0f);
+    }
+    SECTION("Negative lengths throw"){
+        REQUIRE_THROWS_AS(ipps::math::Add(x.data(), y.data(), result.data(), (long long)-1), std::invalid_argument);
+    }
+}
@@ -0,0 +1,136 @@
+#include <iostream>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <stdexcept>
+#include "ipp_ext.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("ipps parallel thread pool", "[parallel]")
+{
+    ipps::parallel::ThreadPool pool(4);
+    REQUIRE(pool.size() == 4);
+
+    SECTION("every task runs exactly once")
+    {
+        std::vector<std::atomic<int>> counts(1000);
+        for (auto& c : counts)
+            c = 0;
+
+        for (int rep = 0; rep < 20; rep++)
+            pool.run(counts.size(), [&](size_t i){ counts[i]++; });
+
+        for (auto& c : counts)
+            REQUIRE(c == 20);
+    }
+
+    SECTION("exceptions are rethrown on the caller")
+    {
+        REQUIRE_THROWS_AS(pool.run(100, [](size_t i){
+            if (i == 37)
+                throw std::runtime_error("task failed");
+        }), std::runtime_error);
+
+        // and the pool is still usable afterwards
+        std::atomic<int> total{0};
+        pool.run(10, [&](size_t){ total++; });
+        REQUIRE(total == 10);
+    }
+
+    SECTION("nested runs execute serially")
+    {
+        std::atomic<int> total{0};
+        pool.run(8, [&](size_t){
+            pool.run(8, [&](size_t){ total++; });
+        });
+        REQUIRE(total == 64);
+    }
+}
+
+TEST_CASE("ipps parallel partitioning", "[parallel]")
+{
+    ipps::parallel::ThreadPool pool(3);
+    const size_t oldMinChunk = ipps::parallel::minChunk();
+    ipps::parallel::setMinChunk(100);
+
+    SECTION("ranges cover the input and start on cache lines")
+    {
+        const size_t length = 10007;
+        std::vector<int> hits(length, 0);
+        std::mutex m;
+        std::vector<size_t> offsets;
+        ipps::parallel::forEachRange<Ipp32f>(length, [&](size_t offset, size_t count){
+            // Catch assertions aren't thread-safe, so just record what happened here
+            std::lock_guard<std::mutex> lock(m);
+            for (size_t i = offset; i < offset + count; i++)
+                hits[i]++;
+            offsets.push_back(offset);
+        }, pool);
+
+        REQUIRE(offsets.size() == 3);
+        for (size_t offset : offsets)
+            REQUIRE((offset * sizeof(Ipp32f)) % ipps::parallel::CACHE_LINE_BYTES == 0);
+        for (size_t i = 0; i < length; i++)
+            REQUIRE(hits[i] == 1);
+    }
+
+    SECTION("short inputs stay on the caller")
+    {
+        size_t numRanges = 0, lastCount = 0;
+        ipps::parallel::forEachRange<Ipp32f>(150, [&](size_t, size_t count){
+            lastCount = count;
+            numRanges++;
+        }, pool);
+        REQUIRE(numRanges == 1);
+        REQUIRE(lastCount == 150);
+    }
+
+    ipps::parallel::setMinChunk(oldMinChunk);
+}
+
+TEST_CASE("ipps parallel math", "[parallel],[math]")
+{
+    ipps::parallel::ThreadPool pool(4);
+    const size_t oldMinChunk = ipps::parallel::minChunk();
+    ipps::parallel::setMinChunk(256);
+
+    const size_t length = 100000;
+    ipps::vector<Ipp32f> x(length), y(length), out(length);
+    for (size_t i = 0; i < length; i++)
+    {
+        x[i] = (Ipp32f)(i % 1000);
+        y[i] = 2.0f;
+    }
+
+    SECTION("Add")
+    {
+        ipps::parallel::Add(x.data(), y.data(), out.data(), length, pool);
+        for (size_t i = 0; i < length; i++)
+            REQUIRE(out[i] == x[i] + 2.0f);
+    }
+
+    SECTION("Mul")
+    {
+        ipps::parallel::Mul(x.data(), y.data(), out.data(), length, pool);
+        for (size_t i = 0; i < length; i++)
+            REQUIRE(out[i] == x[i] * 2.0f);
+    }
+
+    SECTION("AddProductC")
+    {
+        out.zero();
+        ipps::parallel::AddProductC(x.data(), 3.0f, out.data(), length, pool);
+        for (size_t i = 0; i < length; i++)
+            REQUIRE(out[i] == x[i] * 3.0f);
+    }
+
+    SECTION("default pool")
+    {
+        ipps::parallel::MulC(x.data(), 0.5f, out.data(), length);
+        for (size_t i = 0; i < length; i++)
+            REQUIRE(out[i] == x[i] * 0.5f);
+    }
+
+    ipps::parallel::setMinChunk(oldMinChunk);
+}
@@ -0,0 +1,140 @@
+#include "ipp_ext.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <thread>
+#include <vector>
+
+TEST_CASE("ippe plancache dft plans", "[plancache],[dft]")
+{
+    // Start from an empty cache for each section
+    ippe::plancache::clear();
+    ippe::plancache::resetStats();
+    ippe::plancache::setCapacity((size_t)256 * 1024 * 1024);
+
+    SECTION("hit returns the same plan"){
+        auto a = ipps::DFTCToCPlan<Ipp32fc>::cached(1000);
+        auto b = ipps::DFTCToCPlan<Ipp32fc>::cached(1000);
+        REQUIRE(a == b);
+
+        ippe::plancache::Stats s = ippe::plancache::getStats();
+        REQUIRE(s.misses == 1);
+        REQUIRE(s.hits == 1);
+        REQUIRE(s.entries == 1);
+        REQUIRE(s.bytesHeld == a->getMemoryBytes());
+
+        // Executors built from it share the spec
+        ipps::DFTCToC<Ipp32fc> dft0(a), dft1(b);
+        REQUIRE(dft0.getDFTSpec().data() == dft1.getDFTSpec().data());
+    }
+
+    SECTION("type, length and flag are all part of the key"){
+        auto a = ipps::DFTCToCPlan<Ipp32fc>::cached(1000);
+        auto b = ipps::DFTCToCPlan<Ipp64fc>::cached(1000);
+        auto c = ipps::DFTCToCPlan<Ipp32fc>::cached(1001);
+        auto d = ipps::DFTCToCPlan<Ipp32fc>::cached(1000, IPP_FFT_NODIV_BY_ANY);
+        REQUIRE(a.get() != (const void*)b.get());
+        REQUIRE(a != c);
+        REQUIRE(a != d);
+        REQUIRE(d->getFlag() == IPP_FFT_NODIV_BY_ANY);
+
+        ippe::plancache::Stats s = ippe::plancache::getStats();
+        REQUIRE(s.misses == 4);
+        REQUIRE(s.hits == 0);
+        REQUIRE(s.entries == 4);
+    }
+
+    SECTION("least recently used is evicted at capacity"){
+        // Same length with different flags, so that every plan is the same size
+        auto a = ipps::DFTCToCPlan<Ipp32fc>::cached(100, IPP_FFT_DIV_INV_BY_N);
+        size_t bytes = a->getMemoryBytes();
+        ipps::DFTCToCPlan<Ipp32fc>::cached(100, IPP_FFT_NODIV_BY_ANY);
+        ippe::plancache::setCapacity(2 * bytes);
+
+        ipps::DFTCToCPlan<Ipp32fc>::cached(100, IPP_FFT_DIV_INV_BY_N); // now the most recent
+        ipps::DFTCToCPlan<Ipp32fc>::cached(100, IPP_FFT_DIV_FWD_BY_N); // evicts NODIV_BY_ANY
+
+        ippe::plancache::Stats s = ippe::plancache::getStats();
+        REQUIRE(s.evictions == 1);
+        REQUIRE(s.entries == 2);
+        REQUIRE(s.bytesHeld <= ippe::plancache::capacity());
+
+        ippe::plancache::resetStats();
+        auto again = ipps::DFTCToCPlan<Ipp32fc>::cached(100, IPP_FFT_DIV_INV_BY_N);
+        REQUIRE(again == a);
+        REQUIRE(ippe::plancache::getStats().hits == 1);
+        ipps::DFTCToCPlan<Ipp32fc>::cached(100, IPP_FFT_NODIV_BY_ANY);
+        REQUIRE(ippe::plancache::getStats().misses == 1);
+
+        // Evicted plans are still usable by their owners
+        REQUIRE(a->getMemoryBytes() == bytes);
+    }
+
+    SECTION("plans larger than the capacity are not cached"){
+        ippe::plancache::setCapacity(1);
+        auto a = ipps::DFTCToCPlan<Ipp32fc>::cached(1000);
+        REQUIRE(a != nullptr);
+        REQUIRE(ippe::plancache::getStats().entries == 0);
+    }
+
+    SECTION("invalid lengths throw and are not cached"){
+        REQUIRE_THROWS_AS(ipps::DFTCToCPlan<Ipp32fc>::cached(0), std::invalid_argument);
+        REQUIRE(ippe::plancache::getStats().entries == 0);
+    }
+
+    SECTION("concurrent lookups"){
+        const int numThreads = 4;
+        std::vector<std::shared_ptr<const ipps::DFTCToCPlan<Ipp32fc>>> plans(numThreads);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; t++)
+        {
+            threads.emplace_back([&plans, t](){
+                for (int rep = 0; rep < 100; rep++)
+                    plans[t] = ipps::DFTCToCPlan<Ipp32fc>::cached(512);
+            });
+        }
+        for (std::thread& th : threads)
+            th.join();
+
+        for (int t = 1; t < numThreads; t++)
+            REQUIRE(plans[t] == plans[0]);
+        ippe::plancache::Stats s = ippe::plancache::getStats();
+        REQUIRE(s.hits + s.misses == (uint64_t)numThreads * 100);
+        REQUIRE(s.entries == 1);
+    }
+
+    ippe::plancache::clear();
+}
+
+TEST_CASE("ippe plancache image dft plans", "[plancache],[image],[dft]")
+{
+    ippe::plancache::clear();
+    ippe::plancache::resetStats();
+    ippe::plancache::setCapacity((size_t)256 * 1024 * 1024);
+
+    SECTION("keyed on IppiSize"){
+        auto a = ippi::DFT_RToPackPlan<Ipp32f>::cached({64, 32});
+        auto b = ippi::DFT_RToPackPlan<Ipp32f>::cached({64, 32});
+        auto c = ippi::DFT_RToPackPlan<Ipp32f>::cached({32, 64});
+        REQUIRE(a == b);
+        REQUIRE(a != c);
+        REQUIRE(c->roiSize().width == 32);
+        REQUIRE(c->roiSize().height == 64);
+
+        ippe::plancache::Stats s = ippe::plancache::getStats();
+        REQUIRE(s.hits == 1);
+        REQUIRE(s.misses == 2);
+
+        ippi::DFT_RToPack<Ipp32f> dft(a);
+        REQUIRE(dft.plan() == a);
+        REQUIRE(dft.fwdOutputSize().width == 64);
+        REQUIRE(dft.fwdOutputSize().height == 32);
+    }
+
+    SECTION("invalid sizes throw"){
+        REQUIRE_THROWS_AS(ippi::DFT_RToPackPlan<Ipp32f>::cached({0, 32}), std::invalid_argument);
+        REQUIRE(ippe::plancache::getStats().entries == 0);
+    }
+
+    ippe::plancache::clear();
+}
@@ -0,0 +1,135 @@
+#include "ipp_ext.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <thread>
+#include <cstdint>
+
+TEST_CASE("ippe pool vectors", "[pool],[vector]")
+{
+    // Start from a clean slate for this thread
+    ippe::pool::trim();
+    ippe::pool::resetStats();
+
+    SECTION("disabled by default"){
+        REQUIRE(ippe::pool::enabled() == false);
+        ipps::vector<Ipp32f> v(100);
+        REQUIRE(v.isPooled() == false);
+    }
+
+    SECTION("per instance, reuse within a size class"){
+        {
+            ipps::vector<Ipp32fc> v;
+            v.setPooled(true);
+            v.resize(4096); // 32768 bytes
+            REQUIRE(v.isPooled());
+            REQUIRE(reinterpret_cast<uintptr_t>(v.data()) % 64 == 0);
+        }
+        ippe::pool::Stats s = ippe::pool::getStats();
+        REQUIRE(s.misses == 1);
+        REQUIRE(s.hits == 0);
+        REQUIRE(s.bytesHeld == 32768);
+
+        {
+            ipps::vector<Ipp32fc> v;
+            v.setPooled(true);
+            v.resize(4000); // same size class
+        }
+        s = ippe::pool::getStats();
+        REQUIRE(s.misses == 1);
+        REQUIRE(s.hits == 1);
+        REQUIRE(s.bytesHeld == 32768);
+
+        ippe::pool::trim();
+        REQUIRE(ippe::pool::getStats().bytesHeld == 0);
+    }
+
+    SECTION("global switch, copies and moves"){
+        ippe::pool::setEnabled(true);
+        ipps::vector<Ipp64f> a(1000, 1.0);
+        ipps::vector<Ipp64f> b(a); // copies inherit the pooling
+        ipps::vector<Ipp64f> c(std::move(a));
+        ippe::pool::setEnabled(false);
+
+        REQUIRE(b.isPooled());
+        REQUIRE(c.isPooled());
+        for (size_t i = 0; i < b.size(); i++)
+        {
+            REQUIRE(b[i] == 1.0);
+            REQUIRE(c[i] == 1.0);
+        }
+
+        // Moving a non-pooled vector over a pooled one must release the pooled block
+        c = ipps::vector<Ipp64f>(10, 2.0);
+        REQUIRE(c.isPooled() == false);
+        REQUIRE(ippe::pool::getStats().bytesHeld == 8192);
+    }
+
+    SECTION("switching an existing vector keeps its data"){
+        ipps::vector<Ipp16s> v(100, 7);
+        v.setPooled(true);
+        REQUIRE(v.size() == 100);
+        for (size_t i = 0; i < v.size(); i++)
+            REQUIRE(v[i] == 7);
+
+        v.setPooled(false);
+        for (size_t i = 0; i < v.size(); i++)
+            REQUIRE(v[i] == 7);
+    }
+
+    SECTION("thread cache limit"){
+        ippe::pool::setThreadCacheLimit(1024);
+        {
+            ipps::vector<Ipp8u> v;
+            v.setPooled(true);
+            v.resize(4096);
+        }
+        REQUIRE(ippe::pool::getStats().bytesHeld == 0); // freed immediately
+        ippe::pool::setThreadCacheLimit((size_t)256 * 1024 * 1024);
+    }
+
+    SECTION("per-thread free lists"){
+        std::thread t([](){
+            ipps::vector<Ipp32f> v;
+            v.setPooled(true);
+            v.resize(256);
+        });
+        t.join();
+        // Thread exit frees its free lists
+        ippe::pool::Stats s = ippe::pool::getStats();
+        REQUIRE(s.misses == 1);
+        REQUIRE(s.bytesHeld == 0);
+    }
+
+    ippe::pool::trim();
+}
+
+TEST_CASE("ippe pool images", "[pool],[image]")
+{
+    ippe::pool::trim();
+    ippe::pool::resetStats();
+
+    ippi::image<Ipp32f, ippi::channels::C3> img;
+    img.setPooled(true);
+    img.reserve(10, 4);
+    REQUIRE(img.isPooled());
+    REQUIRE(img.stepBytes() % 64 == 0);
+    REQUIRE(img.stepBytes() >= (IppSizeL)(10 * 3 * sizeof(Ipp32f)));
+    REQUIRE(reinterpret_cast<uintptr_t>(img[1]) % 64 == 0);
+
+    for (size_t i = 0; i < img.height(); i++)
+        for (size_t j = 0; j < img.width(); j++)
+            img.at(i, j) = (Ipp32f)(i * img.width() + j);
+
+    ippi::image<Ipp32f, ippi::channels::C3> copied(img);
+    REQUIRE(copied.isPooled());
+    for (size_t i = 0; i < img.height(); i++)
+        for (size_t j = 0; j < img.width(); j++)
+            REQUIRE(copied.at(i, j) == img.at(i, j));
+
+    // Resizing returns the old block to the pool
+    img.reserve(10, 8);
+    REQUIRE(ippe::pool::getStats().bytesHeld > 0);
+
+    ippe::pool::trim();
+}
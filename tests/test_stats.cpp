@@ -453,3 +453,52 @@ TEST_CASE("ipps stats DotProd_Sfs", "[stats], [DotProd_Sfs]")
         test_DotProdSfs<Ipp16s, Ipp32s, Ipp32s>();
     }
 }
+
+TEST_CASE("ipps stats size_t lengths", "[stats], [chunked]")
+{
+    // Force small chunks so that the combining of partial results is exercised
+    ipps::detail::ScopedChunkLength smallChunks(64);
+
+    const size_t len = 1000;
+    ipps::vector<Ipp64f> x(len);
+    for (size_t i = 0; i < len; i++)
+        x[i] = (Ipp64f)(i % 37) - 10.0;
+    x[500] = 100.0; // max, in the middle of a chunk
+    x[700] = 100.0; // later duplicate must not win
+    x[64] = -50.0; // min, at the start of a chunk
+
+    SECTION("Sum")
+    {
+        Ipp64f sum, check = 0;
+        ipps::stats::Sum(x.data(), x.size(), &sum);
+        for (size_t i = 0; i < len; i++)
+            check += x[i];
+        REQUIRE(std::abs(sum - check) < 1e-9);
+    }
+
+    SECTION("Max/Min and indices")
+    {
+        Ipp64f mx, mn;
+        size_t idx;
+        ipps::stats::Max(x.data(), x.size(), &mx);
+        REQUIRE(mx == 100.0);
+        ipps::stats::Min(x.data(), x.size(), &mn);
+        REQUIRE(mn == -50.0);
+        ipps::stats::MaxIndx(x.data(), x.size(), &mx, &idx);
+        REQUIRE(idx == 500);
+        ipps::stats::MinIndx(x.data(), x.size(), &mn, &idx);
+        REQUIRE(idx == 64);
+        REQUIRE_THROWS_AS(ipps::stats::Max(x.data(), (size_t)0, &mx), std::invalid_argument);
+    }
+
+    SECTION("DotProd and Norm_L2")
+    {
+        Ipp64f dot, norm, check = 0;
+        ipps::stats::DotProd(x.data(), x.data(), x.size(), &dot);
+        ipps::stats::Norm_L2(x.data(), x.size(), &norm);
+        for (size_t i = 0; i < len; i++)
+            check += x[i] * x[i];
+        REQUIRE(std::abs(dot - check) < 1e-6);
+        REQUIRE(std::abs(norm - std::sqrt(check)) < 1e-9);
+    }
+}
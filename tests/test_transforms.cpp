@@ -79,3 +79,51 @@ TEST_CASE("ipps transform Goertz", "[transform], [Goertz]")
 }
 
 // Developer note: not testing the Sfs functions. Not sure how to test them.
+
+template <typename T>
+void test_Win_I(IppWinType winType, double (*expected)(size_t, size_t))
+{
+    const size_t len = 17;
+    ipps::vector<T> x(len);
+    for (size_t i = 0; i < len; i++)
+        x[i] = (T)2;
+
+    ipps::transform::Win_I(winType, x.data(), (int)len);
+    for (size_t i = 0; i < len; i++)
+        REQUIRE(std::abs(x[i] - 2.0 * expected(i, len)) < 1e-5);
+}
+
+static double hann(size_t i, size_t n){ return 0.5 - 0.5 * std::cos(IPP_2PI * i / (n - 1)); }
+static double hamming(size_t i, size_t n){ return 0.54 - 0.46 * std::cos(IPP_2PI * i / (n - 1)); }
+static double bartlett(size_t i, size_t n){ return 1.0 - std::abs(2.0 * i / (n - 1) - 1.0); }
+static double rect(size_t, size_t){ return 1.0; }
+
+TEST_CASE("ipps transform Win_I", "[transform], [Win_I]")
+{
+    SECTION("Ipp32f Hann"){
+        test_Win_I<Ipp32f>(ippWinHann, hann);
+    }
+    SECTION("Ipp64f Hamming"){
+        test_Win_I<Ipp64f>(ippWinHamming, hamming);
+    }
+    SECTION("Ipp64f Bartlett"){
+        test_Win_I<Ipp64f>(ippWinBartlett, bartlett);
+    }
+    SECTION("Ipp32f Rect"){
+        test_Win_I<Ipp32f>(ippWinRect, rect);
+    }
+    SECTION("Ipp64fc Hann scales both parts"){
+        ipps::vector<Ipp64fc> x(9);
+        for (size_t i = 0; i < x.size(); i++)
+        {
+            x[i].re = 1.0;
+            x[i].im = -3.0;
+        }
+        ipps::transform::Win_I(ippWinHann, x.data(), (int)x.size());
+        for (size_t i = 0; i < x.size(); i++)
+        {
+            REQUIRE(std::abs(x[i].re - hann(i, x.size())) < 1e-9);
+            REQUIRE(std::abs(x[i].im + 3.0 * hann(i, x.size())) < 1e-9);
+        }
+    }
+}
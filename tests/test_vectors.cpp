@@ -423,6 +423,23 @@ TEST_CASE("ipps vector capacity and resizes", "[vector],[resize]"){
         REQUIRE((data.at(0).re == a.re && data.at(0).im == a.im));
         REQUIRE((data.at(1).re == b.re && data.at(1).im == b.im));
     }
+
+    SECTION("growth keeps existing elements"){
+        ipps::vector<Ipp16u> v16u;
+        for (int i = 0; i < 100; i++)
+            v16u.push_back((Ipp16u)i); // 16u has no ippsCopy of its own
+        REQUIRE(v16u.size() == 100);
+        for (int i = 0; i < 100; i++)
+            REQUIRE(v16u.at(i) == (Ipp16u)i);
+
+        ipps::vector<Ipp32fc> v32fc(10, {1.0f, 2.0f});
+        v32fc.resize(5); // only 5 valid elements now, capacity stays at 10
+        v32fc.reserve(1000);
+        REQUIRE(v32fc.size() == 5);
+        REQUIRE(v32fc.capacity() == 1000);
+        for (size_t i = 0; i < v32fc.size(); i++)
+            REQUIRE((v32fc.at(i).re == 1.0f && v32fc.at(i).im == 2.0f));
+    }
 }
 
 TEST_CASE("ipps vector writes", "[vector],[write]"){
@@ -0,0 +1,204 @@
+#include <iostream>
+#include <cmath>
+#include "ipp_ext.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("ipps vector_view construction", "[view]")
+{
+    ipps::vector<Ipp32f> v(100);
+    for (int i = 0; i < 100; i++)
+        v[i] = (Ipp32f)i;
+
+    SECTION("whole vector")
+    {
+        ipps::vector_view<Ipp32f> view(v);
+        REQUIRE(view.size() == 100);
+        REQUIRE(view.data() == v.data());
+        REQUIRE(view.contiguous());
+    }
+
+    SECTION("sub-range and stride")
+    {
+        ipps::vector_view<Ipp32f> view(v, 10, 20);
+        REQUIRE(view[0] == 10);
+        REQUIRE(view[19] == 29);
+
+        ipps::vector_view<Ipp32f> evens = view.strided(2);
+        REQUIRE(evens.size() == 10);
+        REQUIRE(!evens.contiguous());
+        REQUIRE(evens[1] == 12);
+        REQUIRE(evens.subview(2, 3)[0] == 14);
+
+        // writes go through to the vector
+        evens[0] = -1;
+        REQUIRE(v[10] == -1);
+    }
+
+    SECTION("out of range")
+    {
+        REQUIRE_THROWS_AS(ipps::vector_view<Ipp32f>(v, 90, 20), std::out_of_range);
+        ipps::vector_view<Ipp32f> view(v);
+        REQUIRE_THROWS_AS(view.at(100), std::out_of_range);
+        REQUIRE_THROWS_AS(view.subview(50, 51), std::out_of_range);
+    }
+}
+
+TEST_CASE("ipps math on views", "[view],[math]")
+{
+    // Longer than a tile, so that the strided paths loop
+    const size_t len = 1000;
+    ipps::vector<Ipp32f> x(len * 2), y(len), out(len * 3, 0.0f);
+    for (size_t i = 0; i < len * 2; i++)
+        x[i] = (Ipp32f)i;
+    for (size_t i = 0; i < len; i++)
+        y[i] = 1.0f;
+
+    ipps::vector_view<const Ipp32f> xs = ipps::vector_view<const Ipp32f>(x).strided(2);
+    ipps::vector_view<Ipp32f> outs = ipps::vector_view<Ipp32f>(out).strided(3);
+
+    SECTION("Add strided")
+    {
+        ipps::math::Add(xs, ipps::vector_view<const Ipp32f>(y), outs);
+        for (size_t i = 0; i < len; i++)
+        {
+            REQUIRE(out[i * 3] == x[i * 2] + 1.0f);
+            REQUIRE(out[i * 3 + 1] == 0.0f); // untouched
+        }
+    }
+
+    SECTION("AddProduct accumulates into strided output")
+    {
+        outs = ipps::vector_view<Ipp32f>(out).strided(3);
+        ipps::math::AddC(ipps::vector_view<const Ipp32f>(y), 2.0f, outs);
+        ipps::math::AddProduct(xs, ipps::vector_view<const Ipp32f>(y), outs);
+        for (size_t i = 0; i < len; i++)
+            REQUIRE(out[i * 3] == x[i * 2] + 3.0f);
+    }
+
+    SECTION("Contiguous matches pointer call")
+    {
+        ipps::vector<Ipp32f> ref(len);
+        ipps::math::Add(x.data(), y.data(), ref.data(), (int)len);
+        ipps::vector_view<Ipp32f> o(out, 0, len);
+        ipps::math::Add(ipps::vector_view<const Ipp32f>(x, 0, len), ipps::vector_view<const Ipp32f>(y), o);
+        for (size_t i = 0; i < len; i++)
+            REQUIRE(out[i] == ref[i]);
+    }
+
+    SECTION("Size mismatch throws")
+    {
+        REQUIRE_THROWS_AS(ipps::math::Add(ipps::vector_view<const Ipp32f>(x), ipps::vector_view<const Ipp32f>(y), outs),
+            std::invalid_argument);
+    }
+}
+
+TEST_CASE("ipps stats on views", "[view],[stats]")
+{
+    const size_t len = 1001;
+    ipps::vector<Ipp64f> x(len * 2);
+    for (size_t i = 0; i < len * 2; i++)
+        x[i] = (i % 2 == 0) ? (Ipp64f)(i / 2) : -1000.0;
+    // peak in the 3rd tile of the odd-free view, plus a later equal value that must lose
+    x[700 * 2] = 5000.0;
+    x[900 * 2] = 5000.0;
+
+    ipps::vector_view<const Ipp64f> evens = ipps::vector_view<const Ipp64f>(x).strided(2);
+    REQUIRE(evens.size() == len);
+
+    Ipp64f sum;
+    ipps::stats::Sum(evens, &sum);
+    Ipp64f expected = 0;
+    for (size_t i = 0; i < len; i++)
+        expected += evens[i];
+    REQUIRE(std::abs(sum - expected) < 1e-9);
+
+    Ipp64f mx, mn;
+    size_t idx;
+    ipps::stats::MaxIndx(evens, &mx, &idx);
+    REQUIRE(mx == 5000.0);
+    REQUIRE(idx == 700);
+    ipps::stats::Min(evens, &mn);
+    REQUIRE(mn == 0.0);
+
+    Ipp64f norm;
+    ipps::stats::Norm_L2(evens, &norm);
+    Ipp64f sumsq = 0;
+    for (size_t i = 0; i < len; i++)
+        sumsq += evens[i] * evens[i];
+    REQUIRE(std::abs(norm - std::sqrt(sumsq)) < 1e-6);
+
+    Ipp64f dot;
+    ipps::stats::DotProd(evens, evens, &dot);
+    REQUIRE(std::abs(dot - sumsq) < 1e-3);
+}
+
+TEST_CASE("ipps dft on views", "[view],[dft]")
+{
+    const size_t len = 300;
+    ipps::matrix<Ipp32fc> m(len, 3);
+    for (size_t i = 0; i < len; i++)
+    {
+        for (size_t j = 0; j < 3; j++)
+        {
+            m.index(i, j).re = (Ipp32f)std::cos(0.1 * i + j);
+            m.index(i, j).im = (Ipp32f)std::sin(0.05 * i * j);
+        }
+    }
+
+    ipps::DFTCToC<Ipp32fc> dft(len);
+
+    // Transform column 1 in place of column 2, straight from the matrix
+    ipps::vector_view<Ipp32fc> col1 = m.columnView(1);
+    ipps::vector_view<Ipp32fc> col2 = m.columnView(2);
+    REQUIRE(col1.size() == len);
+    REQUIRE(col1.stride() == 3);
+
+    // Reference, through a contiguous copy
+    ipps::vector<Ipp32fc> in(len), ref(len);
+    for (size_t i = 0; i < len; i++)
+        in[i] = col1[i];
+    dft.fwd(in.data(), ref.data());
+
+    dft.fwd(col1, col2);
+    for (size_t i = 0; i < len; i++)
+    {
+        REQUIRE(m.index(i, 2).re == ref[i].re);
+        REQUIRE(m.index(i, 2).im == ref[i].im);
+    }
+
+    // Wrong length
+    REQUIRE_THROWS_AS(dft.fwd(col1.subview(0, 10), col2.subview(0, 10)), std::invalid_argument);
+
+    SECTION("Split complex")
+    {
+        ipps::DFTCToC<Ipp32f> sdft(len);
+        ipps::vector<Ipp32f> re(len * 2), im(len * 2), ore(len), oim(len);
+        for (size_t i = 0; i < len; i++)
+        {
+            re[i * 2] = in[i].re;
+            im[i * 2] = in[i].im;
+        }
+        sdft.fwd(ipps::vector_view<const Ipp32f>(re).strided(2), ipps::vector_view<const Ipp32f>(im).strided(2),
+                 ipps::vector_view<Ipp32f>(ore), ipps::vector_view<Ipp32f>(oim));
+        for (size_t i = 0; i < len; i++)
+        {
+            REQUIRE(std::abs(ore[i] - ref[i].re) < 1e-3);
+            REQUIRE(std::abs(oim[i] - ref[i].im) < 1e-3);
+        }
+    }
+}
+
+TEST_CASE("ippi image row views", "[view],[image]")
+{
+    IppiSize size = {5, 4};
+    ippi::image<Ipp32f, ippi::channels::C3> img(size);
+    ipps::vector_view<Ipp32f> r = img.rowView(2);
+    REQUIRE(r.size() == 15);
+    REQUIRE(r.data() == img[2]);
+    REQUIRE_THROWS_AS(img.rowView(4), std::out_of_range);
+
+    ipps::vector<Ipp32f> ones(15, 1.0f);
+    ipps::math::MulC(ipps::vector_view<const Ipp32f>(ones), 3.0f, r);
+    REQUIRE(img.at(2, 4) == 3.0f);
+}